@@ -0,0 +1,433 @@
+//--------------------------------------------------------------------------------------
+// File: AnimationBenchmark.cpp
+//
+// アニメーションの更新時間を計測するベンチマーク（D3D を使わない）
+//
+// models : 同梱のモデル（Human, Anim, Mixamo_Test）を 1, 100, 10000 体、1 から N スレッドで更新し、
+//          サンプリング、補間、ローカル行列、ワールド行列、スキン行列の段階毎の時間を計測します
+//          single はクリップの単一再生、blend はクロスフェードと１フレームおきの姿勢の補間です
+// keys   : キー数を増やしたクリップを生成し、1フレームあたりのサンプリング時間が
+//          キー数に依存しない（前回のキー位置から探す）ことを二分探索と比べて確認します
+// 結果を JSON で出力します（段階毎の値は AnimationProfile::FormatJson の形式）
+//
+// 使い方: AnimationBenchmark [--suite models|keys|all] [--instances N]... [--max-threads N]
+//                            [--frames N] [--keys N]... [--out file] [file.imdl]...
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "pch.h"
+#include "AnimationSystem.h"
+#include "ImdlLoader.h"
+#include "SkinningMath.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using namespace DirectX;
+using namespace Imase;
+
+namespace
+{
+    // 1フレームの時間
+    constexpr float FrameTime = 1.0f / 60.0f;
+}
+
+// -------------------------------------------------------------------------------------- //
+// 同梱のモデル
+// -------------------------------------------------------------------------------------- //
+
+namespace
+{
+    // 計測の条件
+    struct ModelRun
+    {
+        std::string label;
+        const ModelAnimationData* model = nullptr;
+        const std::vector<SkinInfo>* skins = nullptr;
+        bool blend = false;
+        uint32_t instances = 1;
+        uint32_t threads = 1;
+        uint32_t frames = 1;
+    };
+
+    // スキン行列を作成する関数（SkinPalette::Update と同じ計算、定数バッファは作らない）
+    void BuildSkinPalette(const std::vector<SkinInfo>& skins, std::span<const XMFLOAT4X4> worldMatrices, XMFLOAT4* palette)
+    {
+        constexpr SkinFormat Format = SkinFormat::Matrix3x4;
+        constexpr size_t Stride = GetSkinVectorCount(Format);
+
+        for (const SkinInfo& info : skins)
+        {
+            for (size_t i = 0; i < info.jointIndices.size(); i++)
+            {
+                uint32_t jointNodeIndex = info.jointIndices[i];
+                if (jointNodeIndex >= worldMatrices.size()) continue;
+
+                XMMATRIX jointWorld = XMLoadFloat4x4(&worldMatrices[jointNodeIndex]);
+                XMMATRIX ibm = XMLoadFloat4x4(&info.inverseBindMatrices[i]);
+                PackSkinMatrix(Format, ibm * jointWorld, palette);
+                palette += Stride;
+            }
+        }
+    }
+
+    // 指定した条件で更新を計測して JSON を作成する関数
+    std::string MeasureModel(const ModelRun& run)
+    {
+        // 1スレッドはワーカー無し（全て呼び出し元で実行する）
+        JobSystem jobSystem(run.threads - 1);
+
+        AnimationProfile profile;
+        AnimationSystem system(&jobSystem);
+        system.SetProfile(&profile);
+
+        // blend は姿勢を１フレームおきに更新して間を補間する
+        if (run.blend)
+        {
+            system.SetLodLevels({ { 0.0f, 2, UINT32_MAX } });
+        }
+
+        uint32_t clipCount = static_cast<uint32_t>(run.model->GetAnimationCount());
+        for (uint32_t i = 0; i < run.instances; i++)
+        {
+            uint32_t id = system.CreateAnimator(*run.model);
+            Animator& animator = system.GetAnimator(id);
+            animator.Play(static_cast<int>(i % clipCount));
+
+            // 全員が同じ時間にならないように再生位置をずらす
+            animator.UpdatePose((i % 97) * 0.013f);
+
+            // クロスフェードは計測中に終わらない長さにする
+            if (run.blend)
+            {
+                animator.CrossFade(static_cast<int>((i + 1) % clipCount), 1.0e6f);
+            }
+        }
+
+        // スキン行列（インスタンス毎に連続して並べる）
+        size_t paletteStride = 0;
+        for (const SkinInfo& info : *run.skins)
+        {
+            paletteStride += info.jointIndices.size() * GetSkinVectorCount(SkinFormat::Matrix3x4);
+        }
+        std::vector<XMFLOAT4> palettes(paletteStride * run.instances);
+        size_t jointCount = paletteStride / GetSkinVectorCount(SkinFormat::Matrix3x4);
+
+        auto update = [&]()
+            {
+                system.Update(FrameTime);
+
+                jobSystem.ParallelFor(run.instances, AnimationSystem::BatchSize, [&](uint32_t begin, uint32_t end)
+                    {
+                        AnimationProfile::ScopedTimer timer(&profile, AnimationProfile::Stage::SkinPalette, jointCount * (end - begin));
+                        for (uint32_t i = begin; i < end; i++)
+                        {
+                            BuildSkinPalette(*run.skins, system.GetWorldMatrices(i), palettes.data() + paletteStride * i);
+                        }
+                    });
+            };
+
+        // 最初の確保とキャッシュへの読み込みを計測に含めない
+        for (uint32_t i = 0; i < 2; i++)
+        {
+            update();
+        }
+        profile.Reset();
+
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < run.frames; i++)
+        {
+            update();
+        }
+        double elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+        // 全ての段階を合わせたボーンあたりの時間と、実時間あたりのボーン数
+        uint64_t bones = static_cast<uint64_t>(run.model->GetNodes().size()) * run.instances * run.frames;
+        uint64_t stageNanoseconds = 0;
+        for (uint32_t i = 0; i < static_cast<uint32_t>(AnimationProfile::Stage::Count); i++)
+        {
+            stageNanoseconds += profile.GetStageStats(static_cast<AnimationProfile::Stage>(i)).nanoseconds;
+        }
+        AnimationProfile::StageStats sample = profile.GetStageStats(AnimationProfile::Stage::Sample);
+        uint64_t channelSamples = profile.GetChannelSampleCount();
+
+        std::ostringstream json;
+        json << "{\"model\":\"" << run.label << "\""
+            << ",\"scenario\":\"" << (run.blend ? "blend" : "single") << "\""
+            << ",\"instances\":" << run.instances
+            << ",\"threads\":" << run.threads
+            << ",\"frames\":" << run.frames
+            << ",\"bones\":" << run.model->GetNodes().size()
+            << ",\"joints\":" << jointCount
+            << ",\"ms_per_frame\":" << elapsed / 1.0e6 / run.frames
+            << ",\"ns_per_bone\":" << (bones ? static_cast<double>(stageNanoseconds) / bones : 0.0)
+            << ",\"bones_per_s\":" << (elapsed > 0.0 ? bones * 1.0e9 / elapsed : 0.0)
+            << ",\"sample_ns_per_channel\":" << (channelSamples ? static_cast<double>(sample.nanoseconds) / channelSamples : 0.0)
+            << ",\"world_matrix_bytes_per_frame\":" << system.GetAllWorldMatrices().size() * sizeof(XMFLOAT4X4)
+            << ",\"profile\":" << profile.FormatJson(run.label) << "}";
+        return json.str();
+    }
+}
+
+// -------------------------------------------------------------------------------------- //
+// キー数のスケーリング
+// -------------------------------------------------------------------------------------- //
+
+namespace
+{
+    // 生成するクリップのボーン数とキーの間隔
+    constexpr uint32_t SyntheticBoneCount = 64;
+    constexpr float SyntheticKeyRate = 30.0f;
+
+    // 計測前に更新するフレーム数
+    constexpr uint32_t WarmupFrames = 60;
+
+    // 親子につながったボーンと、全ボーンの移動と回転に keyCount 個のキーを持つクリップを生成する関数
+    // キーの間隔は一定なので、キー数を増やすとクリップが長くなる（1フレームで進むキーの数は変わらない）
+    std::unique_ptr<ModelAnimationData> CreateSyntheticModel(uint32_t keyCount)
+    {
+        ImdlMappedData data;
+
+        data.nodes.resize(SyntheticBoneCount);
+        for (uint32_t i = 0; i < SyntheticBoneCount; i++)
+        {
+            NodeInfo& node = data.nodes[i];
+            node.meshGroupIndex = -1;
+            node.parentIndex = static_cast<int32_t>(i) - 1;
+            node.skinIndex = -1;
+            node.defaultTranslation = XMFLOAT3(0.0f, 0.1f, 0.0f);
+            node.defaultRotation = XMFLOAT4(0.0f, 0.0f, 0.0f, 1.0f);
+            node.defaultScale = XMFLOAT3(1.0f, 1.0f, 1.0f);
+        }
+
+        AnimationClip clip;
+        clip.name = "keys" + std::to_string(keyCount);
+        clip.duration = (keyCount - 1) / SyntheticKeyRate;
+
+        std::vector<float> times(keyCount);
+        for (uint32_t k = 0; k < keyCount; k++)
+        {
+            times[k] = k / SyntheticKeyRate;
+        }
+
+        for (uint32_t i = 0; i < SyntheticBoneCount; i++)
+        {
+            AnimationChannelVec3 translation{ i, times, {} };
+            AnimationChannelQuat rotation{ i, times, {} };
+            translation.values.resize(keyCount);
+            rotation.values.resize(keyCount);
+
+            for (uint32_t k = 0; k < keyCount; k++)
+            {
+                float angle = 0.5f * std::sin(0.37f * k + 0.11f * i);
+                translation.values[k] = XMFLOAT3(0.0f, 0.1f, 0.01f * angle);
+                XMStoreFloat4(&rotation.values[k], XMQuaternionRotationRollPitchYaw(angle, 0.5f * angle, 0.0f));
+            }
+
+            clip.translations.push_back(std::move(translation));
+            clip.rotations.push_back(std::move(rotation));
+        }
+
+        data.animationClips.push_back(std::move(clip));
+
+        return ModelAnimationData::CreateFromImdlData(data);
+    }
+
+    // キー数 keyCount のクリップを frames フレーム再生して JSON を作成する関数
+    std::string MeasureKeyScaling(uint32_t keyCount, uint32_t frames)
+    {
+        auto model = CreateSyntheticModel(keyCount);
+
+        AnimationProfile profile;
+        Animator animator(*model);
+        animator.SetProfile(&profile);
+        animator.Play(0);
+
+        // 最初の確保とキャッシュへの読み込みを計測に含めない
+        for (uint32_t i = 0; i < WarmupFrames; i++)
+        {
+            animator.Update(FrameTime);
+        }
+        profile.Reset();
+
+        auto start = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < frames; i++)
+        {
+            animator.Update(FrameTime);
+        }
+        auto elapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+
+        AnimationProfile::StageStats sample = profile.GetStageStats(AnimationProfile::Stage::Sample);
+        uint64_t channelSamples = profile.GetChannelSampleCount();
+
+        // 比較用：毎回キーを二分探索した場合（同じ時間、同じチャンネル数）
+        std::vector<float> keyTimes(keyCount);
+        for (uint32_t k = 0; k < keyCount; k++)
+        {
+            keyTimes[k] = k / SyntheticKeyRate;
+        }
+
+        size_t checksum = 0;
+        float duration = (keyCount - 1) / SyntheticKeyRate;
+        auto searchStart = std::chrono::steady_clock::now();
+        for (uint32_t i = 0; i < frames; i++)
+        {
+            float time = std::fmod((WarmupFrames + i + 1) * FrameTime, duration);
+            for (uint32_t c = 0; c < SyntheticBoneCount * 2; c++)
+            {
+                checksum += std::upper_bound(keyTimes.begin(), keyTimes.end(), time + c * 1.0e-7f) - keyTimes.begin();
+            }
+        }
+        auto searchElapsed = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - searchStart).count();
+        uint64_t searches = static_cast<uint64_t>(frames) * SyntheticBoneCount * 2;
+
+        std::ostringstream json;
+        json << "{\"keys\":" << keyCount
+            << ",\"bones\":" << SyntheticBoneCount
+            << ",\"frames\":" << frames
+            << ",\"us_per_frame\":" << elapsed / 1.0e3 / frames
+            << ",\"sample_us_per_frame\":" << sample.nanoseconds / 1.0e3 / frames
+            << ",\"sample_ns_per_channel\":" << (channelSamples ? static_cast<double>(sample.nanoseconds) / channelSamples : 0.0)
+            << ",\"binary_search_ns_per_channel\":" << searchElapsed / searches
+            << ",\"checksum\":" << checksum
+            << ",\"profile\":" << profile.FormatJson("keys" + std::to_string(keyCount)) << "}";
+        return json.str();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::string suite = "all";
+    std::vector<uint32_t> instanceCounts;
+    std::vector<uint32_t> keyCounts;
+    std::vector<std::filesystem::path> files;
+    uint32_t maxThreads = std::max(1u, std::thread::hardware_concurrency());
+    uint32_t frames = 0;
+    std::string outPath;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--suite" && i + 1 < argc) suite = argv[++i];
+        else if (arg == "--instances" && i + 1 < argc) instanceCounts.push_back(std::max(1u, static_cast<uint32_t>(std::stoul(argv[++i]))));
+        else if (arg == "--max-threads" && i + 1 < argc) maxThreads = std::max(1u, static_cast<uint32_t>(std::stoul(argv[++i])));
+        else if (arg == "--frames" && i + 1 < argc) frames = static_cast<uint32_t>(std::stoul(argv[++i]));
+        else if (arg == "--keys" && i + 1 < argc) keyCounts.push_back(static_cast<uint32_t>(std::stoul(argv[++i])));
+        else if (arg == "--out" && i + 1 < argc) outPath = argv[++i];
+        else if (!arg.empty() && arg[0] == '-')
+        {
+            std::cerr << "unknown option: " << arg << "\n";
+            return 1;
+        }
+        else files.emplace_back(arg);
+    }
+
+    bool runModels = (suite == "all" || suite == "models");
+    bool runKeys = (suite == "all" || suite == "keys");
+    if (!runModels && !runKeys)
+    {
+        std::cerr << "unknown suite: " << suite << "\n";
+        return 1;
+    }
+
+    // 指定が無い場合は同梱のモデルを 1, 100, 10000 体
+    if (files.empty())
+    {
+        for (const char* name : { "Human.imdl", "Anim.imdl", "Mixamo_Test.imdl" })
+        {
+            files.push_back(std::filesystem::path(IMASE_MODEL_DIR) / name);
+        }
+    }
+    if (instanceCounts.empty())
+    {
+        instanceCounts = { 1, 100, 10000 };
+    }
+
+    // キー数の指定が無い場合は 16 から 65536 まで
+    if (keyCounts.empty())
+    {
+        keyCounts = { 16, 256, 4096, 65536 };
+    }
+
+    std::ostringstream json;
+    json << "{\"benchmark\":\"animation\""
+        << ",\"hardware_threads\":" << std::thread::hardware_concurrency();
+
+    if (runModels)
+    {
+        json << ",\"models\":[";
+        bool first = true;
+        for (const auto& path : files)
+        {
+            ImdlMappedData data;
+            if (FAILED(ImdlLoader::LoadImdlMapped(path.wstring(), data, {})))
+            {
+                std::cerr << "failed to load: " << path.string() << "\n";
+                return 1;
+            }
+
+            // スキン情報は ModelAnimationData に移らないので先に取っておく
+            std::vector<SkinInfo> skins = std::move(data.skins);
+            auto model = ModelAnimationData::CreateFromImdlData(data);
+            if (model->GetAnimationCount() == 0)
+            {
+                std::cerr << "no animation: " << path.string() << "\n";
+                continue;
+            }
+
+            for (bool blend : { false, true })
+            {
+                for (uint32_t instances : instanceCounts)
+                {
+                    for (uint32_t threads = 1; threads <= maxThreads; threads++)
+                    {
+                        ModelRun run;
+                        run.label = path.stem().string();
+                        run.model = model.get();
+                        run.skins = &skins;
+                        run.blend = blend;
+                        run.instances = instances;
+                        run.threads = threads;
+
+                        // 指定が無い場合は 1 体あたりの更新回数が揃うようにフレーム数を決める
+                        run.frames = frames ? frames : std::clamp(200000u / instances, 10u, 600u);
+
+                        json << (first ? "" : ",") << "\n" << MeasureModel(run);
+                        first = false;
+                    }
+                }
+            }
+        }
+        json << "\n]";
+    }
+
+    if (runKeys)
+    {
+        json << ",\"key_scaling\":[";
+        bool first = true;
+        for (uint32_t keyCount : keyCounts)
+        {
+            if (keyCount < 2) continue;
+            json << (first ? "" : ",") << "\n" << MeasureKeyScaling(keyCount, frames ? frames : 2000);
+            first = false;
+        }
+        json << "\n]";
+    }
+
+    json << "}\n";
+
+    if (outPath.empty())
+    {
+        std::cout << json.str();
+    }
+    else
+    {
+        std::ofstream(outPath) << json.str();
+    }
+
+    return 0;
+}
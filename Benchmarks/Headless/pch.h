@@ -0,0 +1,55 @@
+//--------------------------------------------------------------------------------------
+// File: pch.h
+//
+// ベンチマーク用のプリコンパイル済みヘッダ（D3D を使わないビルド）
+//
+// ImaseLib のうちグラフィックスに依存しないソース（ローダー、ジョブシステム、
+// アニメーション）を Windows 以外でもビルドできるように、使用している
+// Win32 の型とマクロだけを定義します
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#ifdef _WIN32
+
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+
+#else
+
+#include <cstdint>
+#include <cstdio>
+
+using HRESULT = int32_t;
+
+#define S_OK            ((HRESULT)0L)
+#define E_FAIL          ((HRESULT)0x80004005L)
+#define E_ABORT         ((HRESULT)0x80004004L)
+#define E_OUTOFMEMORY   ((HRESULT)0x8007000EL)
+#define FAILED(hr)      (((HRESULT)(hr)) < 0)
+#define SUCCEEDED(hr)   (((HRESULT)(hr)) >= 0)
+
+// デバッグ出力は標準エラーへ出す
+inline void OutputDebugStringA(const char* text) { std::fputs(text, stderr); }
+inline void OutputDebugStringW(const wchar_t* text) { std::fprintf(stderr, "%ls", text); }
+#define OutputDebugString OutputDebugStringW
+
+#define sprintf_s(buffer, ...) std::snprintf(buffer, sizeof(buffer), __VA_ARGS__)
+
+#endif
+
+#include <DirectXMath.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <vector>
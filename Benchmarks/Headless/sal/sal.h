@@ -0,0 +1,148 @@
+//--------------------------------------------------------------------------------------
+// File: sal.h
+//
+// Windows 以外で DirectXMath をビルドするための SAL アノテーションの定義
+//
+// SAL はコード解析用の注釈なので、全て空のマクロとして定義します
+// （既に定義されているものはそのまま使います）
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#ifndef _In_
+#define _In_
+#endif
+#ifndef _In_opt_
+#define _In_opt_
+#endif
+#ifndef _In_z_
+#define _In_z_
+#endif
+#ifndef _In_reads_
+#define _In_reads_(n)
+#endif
+#ifndef _In_reads_opt_
+#define _In_reads_opt_(n)
+#endif
+#ifndef _In_reads_bytes_
+#define _In_reads_bytes_(n)
+#endif
+#ifndef _In_reads_bytes_opt_
+#define _In_reads_bytes_opt_(n)
+#endif
+#ifndef _Out_
+#define _Out_
+#endif
+#ifndef _Out_opt_
+#define _Out_opt_
+#endif
+#ifndef _Out_writes_
+#define _Out_writes_(n)
+#endif
+#ifndef _Out_writes_opt_
+#define _Out_writes_opt_(n)
+#endif
+#ifndef _Out_writes_bytes_
+#define _Out_writes_bytes_(n)
+#endif
+#ifndef _Out_writes_all_
+#define _Out_writes_all_(n)
+#endif
+#ifndef _Out_writes_to_
+#define _Out_writes_to_(n,m)
+#endif
+#ifndef _Inout_
+#define _Inout_
+#endif
+#ifndef _Inout_opt_
+#define _Inout_opt_
+#endif
+#ifndef _Inout_updates_
+#define _Inout_updates_(n)
+#endif
+#ifndef _Inout_updates_bytes_
+#define _Inout_updates_bytes_(n)
+#endif
+#ifndef _Outptr_
+#define _Outptr_
+#endif
+#ifndef _Outptr_opt_
+#define _Outptr_opt_
+#endif
+#ifndef _Outptr_result_maybenull_
+#define _Outptr_result_maybenull_
+#endif
+#ifndef _COM_Outptr_
+#define _COM_Outptr_
+#endif
+#ifndef _Ret_maybenull_
+#define _Ret_maybenull_
+#endif
+#ifndef _Ret_notnull_
+#define _Ret_notnull_
+#endif
+#ifndef _Check_return_
+#define _Check_return_
+#endif
+#ifndef _Must_inspect_result_
+#define _Must_inspect_result_
+#endif
+#ifndef _Success_
+#define _Success_(x)
+#endif
+#ifndef _Use_decl_annotations_
+#define _Use_decl_annotations_
+#endif
+#ifndef _Analysis_assume_
+#define _Analysis_assume_(x)
+#endif
+#ifndef _Pre_
+#define _Pre_
+#endif
+#ifndef _Post_
+#define _Post_
+#endif
+#ifndef _Deref_out_
+#define _Deref_out_
+#endif
+#ifndef _Null_terminated_
+#define _Null_terminated_
+#endif
+#ifndef _Field_size_
+#define _Field_size_(n)
+#endif
+#ifndef _Field_size_opt_
+#define _Field_size_opt_(n)
+#endif
+#ifndef _Field_size_bytes_
+#define _Field_size_bytes_(n)
+#endif
+#ifndef _Printf_format_string_
+#define _Printf_format_string_
+#endif
+#ifndef _In_range_
+#define _In_range_(a,b)
+#endif
+#ifndef _Out_range_
+#define _Out_range_(a,b)
+#endif
+#ifndef _Notnull_
+#define _Notnull_
+#endif
+#ifndef _Maybenull_
+#define _Maybenull_
+#endif
+#ifndef _Reserved_
+#define _Reserved_
+#endif
+#ifndef _Frees_ptr_opt_
+#define _Frees_ptr_opt_
+#endif
+#ifndef _When_
+#define _When_(a,b)
+#endif
+#ifndef _Always_
+#define _Always_(x)
+#endif
@@ -0,0 +1,514 @@
+//--------------------------------------------------------------------------------------
+// File: ImdlLoadBenchmark.cpp
+//
+// IMDL ファイルのロード時間、ヒープの確保回数と最大使用量を計測するベンチマーク
+//
+// 同梱のモデルと、指定したサイズで生成した大きなファイルを読み込みます
+// ページキャッシュから追い出した状態（cold）と載っている状態（warm）をそれぞれ計測し、
+// 結果を JSON で出力します（ロード部分は ImdlLoader::FormatStatsJson の形式）
+//
+// 使い方: ImdlLoadBenchmark [--runs N] [--synthetic-mb MB]... [--compressed-indices]
+//                           [--parallel] [--no-cold] [--out file] [file.imdl]...
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "pch.h"
+#include "ImdlLoader.h"
+#include "ChunkIO.h"
+#include "IndexCompression.h"
+#include "JobSystem.h"
+
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <new>
+#include <sstream>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace Imase;
+
+// -------------------------------------------------------------------------------------- //
+// ヒープの確保の計測（全体の operator new / delete を置き換える）
+// -------------------------------------------------------------------------------------- //
+
+namespace
+{
+    std::atomic<uint64_t> s_allocationCount{ 0 };   // 確保回数
+    std::atomic<uint64_t> s_allocatedBytes{ 0 };    // 確保したバイト数の合計
+    std::atomic<int64_t> s_liveBytes{ 0 };          // 確保中のバイト数
+    std::atomic<int64_t> s_peakBytes{ 0 };          // 確保中のバイト数の最大値
+
+    // 解放時にサイズが分かるように、確保したブロックの先頭にサイズを置く
+    constexpr size_t AllocationHeaderSize = alignof(std::max_align_t);
+
+    void* Allocate(size_t size, size_t alignment)
+    {
+        size_t header = std::max(AllocationHeaderSize, alignment);
+
+        void* block = nullptr;
+#ifdef _WIN32
+        block = _aligned_malloc(size + header, header);
+#else
+        if (posix_memalign(&block, header, size + header) != 0) block = nullptr;
+#endif
+        if (!block)
+        {
+            throw std::bad_alloc();
+        }
+
+        uint8_t* p = static_cast<uint8_t*>(block) + header;
+        reinterpret_cast<size_t*>(p)[-1] = size;
+        reinterpret_cast<size_t*>(p)[-2] = header;
+
+        s_allocationCount.fetch_add(1, std::memory_order_relaxed);
+        s_allocatedBytes.fetch_add(size, std::memory_order_relaxed);
+        int64_t live = s_liveBytes.fetch_add(static_cast<int64_t>(size), std::memory_order_relaxed) + static_cast<int64_t>(size);
+        int64_t peak = s_peakBytes.load(std::memory_order_relaxed);
+        while (live > peak && !s_peakBytes.compare_exchange_weak(peak, live, std::memory_order_relaxed))
+        {
+        }
+        return p;
+    }
+
+    void Free(void* p) noexcept
+    {
+        if (!p) return;
+
+        size_t size = static_cast<size_t*>(p)[-1];
+        size_t header = static_cast<size_t*>(p)[-2];
+        s_liveBytes.fetch_sub(static_cast<int64_t>(size), std::memory_order_relaxed);
+
+        void* block = static_cast<uint8_t*>(p) - header;
+#ifdef _WIN32
+        _aligned_free(block);
+#else
+        std::free(block);
+#endif
+    }
+
+    // 計測区間の確保の統計
+    struct AllocationStats
+    {
+        uint64_t count = 0;
+        uint64_t bytes = 0;
+        int64_t peakBytes = 0;  // 計測開始時点からの増加分の最大値
+    };
+
+    // 計測を開始する関数（開始時点の値を返す）
+    AllocationStats BeginAllocationScope()
+    {
+        int64_t live = s_liveBytes.load();
+        s_peakBytes.store(live);
+        return { s_allocationCount.load(), s_allocatedBytes.load(), live };
+    }
+
+    // 計測を終了する関数
+    AllocationStats EndAllocationScope(const AllocationStats& start)
+    {
+        return { s_allocationCount.load() - start.count, s_allocatedBytes.load() - start.bytes, s_peakBytes.load() - start.peakBytes };
+    }
+}
+
+void* operator new(size_t size) { return Allocate(size, 0); }
+void* operator new[](size_t size) { return Allocate(size, 0); }
+void* operator new(size_t size, std::align_val_t alignment) { return Allocate(size, static_cast<size_t>(alignment)); }
+void* operator new[](size_t size, std::align_val_t alignment) { return Allocate(size, static_cast<size_t>(alignment)); }
+void operator delete(void* p) noexcept { Free(p); }
+void operator delete[](void* p) noexcept { Free(p); }
+void operator delete(void* p, size_t) noexcept { Free(p); }
+void operator delete[](void* p, size_t) noexcept { Free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { Free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { Free(p); }
+void operator delete(void* p, size_t, std::align_val_t) noexcept { Free(p); }
+void operator delete[](void* p, size_t, std::align_val_t) noexcept { Free(p); }
+
+// -------------------------------------------------------------------------------------- //
+// ページキャッシュ
+// -------------------------------------------------------------------------------------- //
+
+namespace
+{
+    // ファイルをページキャッシュから追い出す関数（対応していない環境では false を返す）
+    bool EvictFromPageCache(const std::filesystem::path& path)
+    {
+#if defined(POSIX_FADV_DONTNEED)
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        fdatasync(fd);
+        bool result = posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED) == 0;
+        close(fd);
+        return result;
+#else
+        (void)path;
+        return false;
+#endif
+    }
+
+    // ファイル全体を読んでページキャッシュに載せる関数
+    void WarmPageCache(const std::filesystem::path& path)
+    {
+        std::ifstream ifs(path, std::ios::binary);
+        std::vector<char> buffer(1 << 20);
+        while (ifs.read(buffer.data(), buffer.size()) || ifs.gcount() > 0)
+        {
+        }
+    }
+
+    // ファイルのうちページキャッシュに載っている割合を取得する関数（調べられない場合は -1）
+    double GetResidentFraction(const std::filesystem::path& path)
+    {
+#ifndef _WIN32
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) return -1.0;
+
+        struct stat st = {};
+        double result = -1.0;
+        if (fstat(fd, &st) == 0 && st.st_size > 0)
+        {
+            size_t size = static_cast<size_t>(st.st_size);
+            void* p = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+            if (p != MAP_FAILED)
+            {
+                size_t pageSize = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+                std::vector<unsigned char> pages((size + pageSize - 1) / pageSize);
+                if (mincore(p, size, pages.data()) == 0)
+                {
+                    size_t resident = std::count_if(pages.begin(), pages.end(), [](unsigned char v) { return (v & 1) != 0; });
+                    result = static_cast<double>(resident) / pages.size();
+                }
+                munmap(p, size);
+            }
+        }
+        close(fd);
+        return result;
+#else
+        (void)path;
+        return -1.0;
+#endif
+    }
+}
+
+// -------------------------------------------------------------------------------------- //
+// 大きなファイルの生成
+// -------------------------------------------------------------------------------------- //
+
+namespace
+{
+    // チャンクのデータを作成するクラス
+    class ChunkWriter
+    {
+        std::vector<uint8_t> m_data;
+
+    public:
+
+        template<typename T>
+        void Write(const T& value)
+        {
+            const uint8_t* p = reinterpret_cast<const uint8_t*>(&value);
+            m_data.insert(m_data.end(), p, p + sizeof(T));
+        }
+
+        template<typename T>
+        void WriteArray(const std::vector<T>& values)
+        {
+            const uint8_t* p = reinterpret_cast<const uint8_t*>(values.data());
+            m_data.insert(m_data.end(), p, p + sizeof(T) * values.size());
+        }
+
+        // v2 のレコード配列（個数 + ストライド + 構造体の配列）
+        template<typename T>
+        void WriteRecords(const std::vector<T>& values)
+        {
+            Write(static_cast<uint32_t>(values.size()));
+            Write(static_cast<uint32_t>(sizeof(T)));
+            WriteArray(values);
+        }
+
+        // 個数 + 配列
+        template<typename T>
+        void WriteVector(const std::vector<T>& values)
+        {
+            Write(static_cast<uint32_t>(values.size()));
+            WriteArray(values);
+        }
+
+        void Align(size_t alignment)
+        {
+            m_data.resize((m_data.size() + alignment - 1) / alignment * alignment);
+        }
+
+        std::vector<uint8_t>& Data() { return m_data; }
+    };
+
+    // グリッド状のメッシュとボーンの回転アニメーションを持つ IMDL v3 ファイルを生成する関数
+    // 頂点とインデックスで megabytes MB 程度になる
+    void WriteSyntheticImdl(const std::filesystem::path& path, size_t megabytes, bool compressIndices)
+    {
+        using namespace DirectX;
+
+        // 1頂点あたり頂点 80 バイト + インデックス約 24 バイト
+        uint32_t side = static_cast<uint32_t>(std::sqrt(megabytes * 1024.0 * 1024.0 / 104.0));
+        side = std::max(side, 2u);
+
+        constexpr uint32_t BoneCount = 64;
+        constexpr uint32_t KeyCount = 1024;
+
+        std::vector<std::pair<uint32_t, ChunkWriter>> chunks;
+
+        // ノード（ルートの下にボーンを一列に繋げる）
+        {
+            std::vector<NodeInfo> nodes(BoneCount + 1);
+            for (uint32_t i = 0; i < nodes.size(); i++)
+            {
+                nodes[i].meshGroupIndex = i == 0 ? 0 : -1;
+                nodes[i].parentIndex = static_cast<int32_t>(i) - 1;
+                nodes[i].skinIndex = -1;
+                nodes[i].defaultTranslation = XMFLOAT3(0.0f, i == 0 ? 0.0f : 1.0f, 0.0f);
+                nodes[i].defaultRotation = XMFLOAT4(0.0f, 0.0f, 0.0f, 1.0f);
+                nodes[i].defaultScale = XMFLOAT3(1.0f, 1.0f, 1.0f);
+            }
+            chunks.emplace_back(CHUNK_NODE, ChunkWriter{}).second.WriteRecords(nodes);
+        }
+
+        // 頂点
+        std::vector<VertexPositionNormalTextureTangent> vertices(static_cast<size_t>(side) * side);
+        for (uint32_t y = 0; y < side; y++)
+        {
+            for (uint32_t x = 0; x < side; x++)
+            {
+                auto& v = vertices[static_cast<size_t>(y) * side + x];
+                v = {};
+                v.position = XMFLOAT3(static_cast<float>(x), 0.0f, static_cast<float>(y));
+                v.normal = XMFLOAT3(0.0f, 1.0f, 0.0f);
+                v.texcoord = XMFLOAT2(static_cast<float>(x) / side, static_cast<float>(y) / side);
+                v.tangent = XMFLOAT4(1.0f, 0.0f, 0.0f, 1.0f);
+                v.weight = XMFLOAT4(1.0f, 0.0f, 0.0f, 0.0f);
+            }
+        }
+        chunks.emplace_back(CHUNK_VERTEX, ChunkWriter{}).second.WriteRecords(vertices);
+
+        // インデックス
+        std::vector<uint32_t> indices;
+        indices.reserve(static_cast<size_t>(side - 1) * (side - 1) * 6);
+        for (uint32_t y = 0; y + 1 < side; y++)
+        {
+            for (uint32_t x = 0; x + 1 < side; x++)
+            {
+                uint32_t i = y * side + x;
+                indices.insert(indices.end(), { i, i + side, i + 1, i + 1, i + side, i + side + 1 });
+            }
+        }
+        if (compressIndices)
+        {
+            ChunkWriter& w = chunks.emplace_back(CHUNK_INDEX_COMPRESSED, ChunkWriter{}).second;
+            std::vector<uint8_t> stream = EncodeIndexStream(indices);
+            w.Write(static_cast<uint32_t>(indices.size()));
+            w.Write(static_cast<uint32_t>(stream.size()));
+            w.WriteArray(stream);
+        }
+        else
+        {
+            chunks.emplace_back(CHUNK_INDEX, ChunkWriter{}).second.WriteRecords(indices);
+        }
+
+        // サブメッシュとメッシュグループ
+        chunks.emplace_back(CHUNK_SUBMESH, ChunkWriter{}).second.WriteRecords(std::vector<SubMeshInfo>{ { 0, static_cast<uint32_t>(indices.size()), 0 } });
+        chunks.emplace_back(CHUNK_MESHGROUP, ChunkWriter{}).second.WriteRecords(std::vector<MeshGroupInfo>{ { 0, 1 } });
+
+        // アニメーション（全てのボーンの回転）
+        {
+            ChunkWriter& w = chunks.emplace_back(CHUNK_ANIMATION, ChunkWriter{}).second;
+            std::string name = "synthetic";
+            w.Write(1u);
+            w.Write(static_cast<uint32_t>(name.size()));
+            w.WriteArray(std::vector<char>(name.begin(), name.end()));
+            w.Align(4);
+            w.Write(static_cast<float>(KeyCount - 1) / 30.0f);
+            w.Write(0u);
+            w.Write(BoneCount);
+            for (uint32_t bone = 1; bone <= BoneCount; bone++)
+            {
+                std::vector<float> times(KeyCount);
+                std::vector<XMFLOAT4> values(KeyCount);
+                for (uint32_t k = 0; k < KeyCount; k++)
+                {
+                    times[k] = k / 30.0f;
+                    XMStoreFloat4(&values[k], XMQuaternionRotationRollPitchYaw(0.01f * k, 0.02f * bone, 0.0f));
+                }
+                w.Write(bone);
+                w.WriteVector(times);
+                w.WriteVector(values);
+            }
+            w.Write(0u);
+        }
+
+        // ヘッダ + チャンクディレクトリ + （チャンクヘッダ + データ） * チャンク数
+        FileHeader header{ IMDL_MAGIC, IMDL_VERSION_3, static_cast<uint32_t>(chunks.size()) };
+        std::vector<ChunkDirectoryEntry> directory;
+        uint64_t offset = sizeof(header) + sizeof(ChunkDirectoryEntry) * chunks.size();
+        for (auto& [type, w] : chunks)
+        {
+            w.Align(4);
+            offset += sizeof(ChunkHeader);
+            directory.push_back({ type, static_cast<uint32_t>(w.Data().size()), offset });
+            offset += w.Data().size();
+        }
+
+        std::ofstream ofs(path, std::ios::binary);
+        ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        ofs.write(reinterpret_cast<const char*>(directory.data()), sizeof(ChunkDirectoryEntry) * directory.size());
+        for (auto& [type, w] : chunks)
+        {
+            ChunkHeader ch{ type, static_cast<uint32_t>(w.Data().size()) };
+            ofs.write(reinterpret_cast<const char*>(&ch), sizeof(ch));
+            ofs.write(reinterpret_cast<const char*>(w.Data().data()), w.Data().size());
+        }
+        if (!ofs)
+        {
+            throw std::runtime_error("failed to write " + path.string());
+        }
+    }
+}
+
+// -------------------------------------------------------------------------------------- //
+
+namespace
+{
+    // 1回のロードを計測して JSON を作成する関数
+    std::string MeasureLoad(const std::filesystem::path& path, bool cold, uint32_t run, const ImdlLoadOptions& options)
+    {
+        bool evicted = cold && EvictFromPageCache(path);
+        double resident = GetResidentFraction(path);
+
+        AllocationStats start = BeginAllocationScope();
+        HRESULT hr = E_FAIL;
+        std::string load;
+        {
+            ImdlMappedData data;
+            hr = ImdlLoader::LoadImdlMapped(path.wstring(), data, options);
+            AllocationStats allocation = EndAllocationScope(start);
+
+            if (SUCCEEDED(hr))
+            {
+                load = ImdlLoader::FormatStatsJson(path.wstring(), data.stats);
+            }
+
+            std::ostringstream json;
+            json << "{\"cache\":\"" << (cold ? "cold" : "warm") << "\""
+                << ",\"evicted\":" << (evicted ? "true" : "false")
+                << ",\"resident_before\":" << resident
+                << ",\"run\":" << run
+                << ",\"parallel\":" << (options.parallelDecode ? "true" : "false")
+                << ",\"ok\":" << (SUCCEEDED(hr) ? "true" : "false")
+                << ",\"allocations\":" << allocation.count
+                << ",\"allocated_bytes\":" << allocation.bytes
+                << ",\"peak_bytes\":" << allocation.peakBytes
+                << ",\"load\":" << (load.empty() ? "null" : load) << "}";
+            return json.str();
+        }
+    }
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t runs = 5;
+    bool cold = true;
+    bool compressIndices = false;
+    std::vector<size_t> syntheticSizes;
+    std::vector<std::filesystem::path> files;
+    std::string outPath;
+
+    ImdlLoadOptions options;
+    options.collectStats = true;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--runs" && i + 1 < argc) runs = static_cast<uint32_t>(std::stoul(argv[++i]));
+        else if (arg == "--synthetic-mb" && i + 1 < argc) syntheticSizes.push_back(std::stoul(argv[++i]));
+        else if (arg == "--compressed-indices") compressIndices = true;
+        else if (arg == "--parallel") options.parallelDecode = true;
+        else if (arg == "--no-cold") cold = false;
+        else if (arg == "--out" && i + 1 < argc) outPath = argv[++i];
+        else if (!arg.empty() && arg[0] == '-')
+        {
+            std::cerr << "unknown option: " << arg << "\n";
+            return 1;
+        }
+        else files.emplace_back(arg);
+    }
+
+    // ファイルの指定が無い場合は同梱のモデル
+    if (files.empty())
+    {
+        for (const char* name : { "Human.imdl", "Anim.imdl", "Mixamo_Test.imdl" })
+        {
+            files.push_back(std::filesystem::path(IMASE_MODEL_DIR) / name);
+        }
+    }
+
+    // 大きなファイルを生成
+    std::vector<std::filesystem::path> generated;
+    for (size_t megabytes : syntheticSizes)
+    {
+        auto path = std::filesystem::temp_directory_path() / ("imdl_benchmark_" + std::to_string(megabytes) + "mb.imdl");
+        WriteSyntheticImdl(path, megabytes, compressIndices);
+        files.push_back(path);
+        generated.push_back(path);
+    }
+
+    // ワーカースレッドの起動をロードの計測に含めない
+    if (options.parallelDecode)
+    {
+        JobSystem::GetInstance();
+    }
+
+    std::ostringstream json;
+    json << "{\"benchmark\":\"imdl_load\",\"runs\":[";
+    bool first = true;
+    for (const auto& path : files)
+    {
+        for (bool coldRun : { true, false })
+        {
+            if (coldRun && !cold) continue;
+
+            // warm はファイル全体を読んでから計測する（ゼロコピーのロードは参照しないページを読まないため）
+            if (!coldRun)
+            {
+                WarmPageCache(path);
+            }
+
+            for (uint32_t run = 0; run < runs; run++)
+            {
+                json << (first ? "" : ",") << "\n" << MeasureLoad(path, coldRun, run, options);
+                first = false;
+            }
+        }
+    }
+    json << "\n]}\n";
+
+    for (const auto& path : generated)
+    {
+        std::error_code ec;
+        std::filesystem::remove(path, ec);
+    }
+
+    if (outPath.empty())
+    {
+        std::cout << json.str();
+    }
+    else
+    {
+        std::ofstream(outPath) << json.str();
+    }
+
+    return 0;
+}
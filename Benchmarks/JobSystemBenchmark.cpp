@@ -0,0 +1,241 @@
+//--------------------------------------------------------------------------------------
+// File: JobSystemBenchmark.cpp
+//
+// ジョブシステムのスレッド数に対するスケーリングを計測するベンチマーク
+//
+// スレッド数（呼び出し元 + ワーカー）を 1 から増やしながら、次の３つを計測します
+//   parallel_for : 計算の重い配列の処理を並列 for で分割した場合の時間
+//   empty_jobs   : 何もしないジョブを大量に登録して待つ場合の時間（登録と実行のコスト）
+//   fork_join    : ジョブの中からジョブを登録する２分木（ワーカーのキューと盗みを使う）
+// 1スレッドはジョブシステムを使わずに同じ処理を逐次実行した時間で、速度の倍率の基準になります
+// 結果を JSON で出力します
+//
+// 使い方: JobSystemBenchmark [--max-threads N] [--runs N] [--scale N] [--out file]
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "pch.h"
+#include "JobSystem.h"
+
+#include <chrono>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using namespace Imase;
+
+namespace
+{
+    using Clock = std::chrono::steady_clock;
+
+    // 経過時間（ミリ秒）
+    double GetMilliseconds(Clock::time_point start)
+    {
+        return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    }
+
+    // ----- 計測する処理（jobSystem が nullptr なら逐次実行） ----- //
+
+    // 計算の重い配列の処理（要素毎に数回の平方根）
+    double MeasureParallelFor(JobSystem* jobSystem, std::vector<float>& values, uint32_t grainSize)
+    {
+        auto function = [&values](uint32_t begin, uint32_t end)
+            {
+                for (uint32_t i = begin; i < end; i++)
+                {
+                    float v = values[i];
+                    for (int k = 0; k < 16; k++) v = std::sqrt(v + 1.0f);
+                    values[i] = v;
+                }
+            };
+
+        auto start = Clock::now();
+        if (jobSystem)
+        {
+            jobSystem->ParallelFor(static_cast<uint32_t>(values.size()), grainSize, function);
+        }
+        else
+        {
+            function(0, static_cast<uint32_t>(values.size()));
+        }
+        return GetMilliseconds(start);
+    }
+
+    // 何もしないジョブを count 個登録して待つ
+    double MeasureEmptyJobs(JobSystem* jobSystem, uint32_t count)
+    {
+        std::atomic<uint32_t> executed{ 0 };
+        auto function = [&executed](uint32_t, uint32_t) { executed.fetch_add(1, std::memory_order_relaxed); };
+        Job job = JobSystem::MakeJob(function);
+
+        auto start = Clock::now();
+        if (jobSystem)
+        {
+            JobCounter counter;
+            for (uint32_t i = 0; i < count; i++)
+            {
+                jobSystem->Schedule(job, &counter);
+            }
+            jobSystem->Wait(counter);
+        }
+        else
+        {
+            for (uint32_t i = 0; i < count; i++)
+            {
+                job.function(job.data, job.begin, job.end);
+            }
+        }
+        return GetMilliseconds(start);
+    }
+
+    // depth 段の２分木（葉で少し計算する）
+    struct ForkContext
+    {
+        JobSystem* jobSystem;
+        std::atomic<uint64_t> sum{ 0 };
+    };
+
+    void Fork(ForkContext& context, uint32_t depth)
+    {
+        if (depth == 0)
+        {
+            uint64_t v = 0;
+            for (uint32_t i = 0; i < 256; i++) v += i * (i ^ depth);
+            context.sum.fetch_add(v, std::memory_order_relaxed);
+            return;
+        }
+
+        if (!context.jobSystem)
+        {
+            Fork(context, depth - 1);
+            Fork(context, depth - 1);
+            return;
+        }
+
+        JobCounter counter;
+        auto child = [&context](uint32_t begin, uint32_t) { Fork(context, begin); };
+        context.jobSystem->Schedule(JobSystem::MakeJob(child, depth - 1), &counter);
+        Fork(context, depth - 1);
+        context.jobSystem->Wait(counter);
+    }
+
+    double MeasureForkJoin(JobSystem* jobSystem, uint32_t depth)
+    {
+        ForkContext context{ jobSystem };
+
+        auto start = Clock::now();
+        if (jobSystem)
+        {
+            // ワーカーの中から始めて、子のジョブがワーカーのキューに積まれるようにする
+            JobCounter counter;
+            auto root = [&context](uint32_t begin, uint32_t) { Fork(context, begin); };
+            jobSystem->Schedule(JobSystem::MakeJob(root, depth), &counter);
+            jobSystem->Wait(counter);
+        }
+        else
+        {
+            Fork(context, depth);
+        }
+        return GetMilliseconds(start);
+    }
+
+    // runs 回計測して最小値を返す
+    template <class Function>
+    double MinimumOf(uint32_t runs, Function&& function)
+    {
+        double best = 0.0;
+        for (uint32_t run = 0; run < runs; run++)
+        {
+            double ms = function();
+            best = (run == 0) ? ms : std::min(best, ms);
+        }
+        return best;
+    }
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t maxThreads = std::max(2u, std::thread::hardware_concurrency());
+    uint32_t runs = 5;
+    uint32_t scale = 1;
+    std::string outPath;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--max-threads" && i + 1 < argc) maxThreads = std::max(1u, static_cast<uint32_t>(std::stoul(argv[++i])));
+        else if (arg == "--runs" && i + 1 < argc) runs = std::max(1u, static_cast<uint32_t>(std::stoul(argv[++i])));
+        else if (arg == "--scale" && i + 1 < argc) scale = std::max(1u, static_cast<uint32_t>(std::stoul(argv[++i])));
+        else if (arg == "--out" && i + 1 < argc) outPath = argv[++i];
+        else
+        {
+            std::cerr << "unknown option: " << arg << "\n";
+            return 1;
+        }
+    }
+
+    // 問題の大きさ（--scale で小さくする）
+    const uint32_t elementCount = std::max(1u, (1u << 22) / scale);
+    const uint32_t emptyJobCount = std::max(1u, 100000 / scale);
+    const uint32_t forkDepth = (scale > 1) ? 10 : 16;
+    constexpr uint32_t GrainSize = 1024;
+
+    std::vector<float> values(elementCount, 1.0f);
+
+    std::ostringstream json;
+    json << "{\"benchmark\":\"job_system\""
+        << ",\"hardware_threads\":" << std::thread::hardware_concurrency()
+        << ",\"elements\":" << elementCount
+        << ",\"grain_size\":" << GrainSize
+        << ",\"empty_jobs\":" << emptyJobCount
+        << ",\"fork_depth\":" << forkDepth
+        << ",\"runs\":[";
+
+    double baseParallelFor = 0.0;
+    double baseForkJoin = 0.0;
+
+    for (uint32_t threads = 1; threads <= maxThreads; threads++)
+    {
+        // 呼び出し元のスレッドも待っている間にジョブを実行するので、ワーカーは１つ少なくする
+        std::unique_ptr<JobSystem> jobSystem;
+        if (threads > 1)
+        {
+            jobSystem = std::make_unique<JobSystem>(threads - 1);
+        }
+
+        double parallelForMs = MinimumOf(runs, [&]() { return MeasureParallelFor(jobSystem.get(), values, GrainSize); });
+        double emptyJobsMs = MinimumOf(runs, [&]() { return MeasureEmptyJobs(jobSystem.get(), emptyJobCount); });
+        double forkJoinMs = MinimumOf(runs, [&]() { return MeasureForkJoin(jobSystem.get(), forkDepth); });
+
+        if (threads == 1)
+        {
+            baseParallelFor = parallelForMs;
+            baseForkJoin = forkJoinMs;
+        }
+
+        JobSystem::Stats stats = jobSystem ? jobSystem->GetStats() : JobSystem::Stats{};
+
+        json << (threads > 1 ? "," : "") << "\n{\"threads\":" << threads
+            << ",\"parallel_for_ms\":" << parallelForMs
+            << ",\"parallel_for_speedup\":" << (parallelForMs > 0.0 ? baseParallelFor / parallelForMs : 0.0)
+            << ",\"empty_job_ns\":" << emptyJobsMs * 1.0e6 / emptyJobCount
+            << ",\"fork_join_ms\":" << forkJoinMs
+            << ",\"fork_join_speedup\":" << (forkJoinMs > 0.0 ? baseForkJoin / forkJoinMs : 0.0)
+            << ",\"executed_jobs\":" << stats.executedJobs
+            << ",\"stolen_jobs\":" << stats.stolenJobs
+            << ",\"deferred_jobs\":" << stats.deferredJobs << "}";
+    }
+    json << "\n]}\n";
+
+    if (outPath.empty())
+    {
+        std::cout << json.str();
+    }
+    else
+    {
+        std::ofstream(outPath) << json.str();
+    }
+
+    return 0;
+}
@@ -0,0 +1,324 @@
+//--------------------------------------------------------------------------------------
+// File: JobSystemTest.cpp
+//
+// ジョブシステムのストレステスト
+//
+// ワーカーのキュー（Chase-Lev 方式）に積む、取り出す、盗むを複数のスレッドから同時に行い、
+// 全てのジョブがちょうど１回ずつ取り出されることを確認します
+// また、並列 for、入れ子のジョブ、依存関係、例外の再送出、ワーカー以外のスレッドの待機を確認します
+//
+// 使い方: JobSystemTest [--rounds N]
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "pch.h"
+#include "JobSystem.h"
+
+#include <iostream>
+
+using namespace Imase;
+
+namespace
+{
+    // 失敗した確認の数
+    uint32_t s_failures = 0;
+
+    // 条件を確認する関数（失敗したら内容を出力する）
+    void Check(bool condition, const std::string& message)
+    {
+        if (!condition)
+        {
+            std::cerr << "FAILED: " << message << "\n";
+            s_failures++;
+        }
+    }
+
+    // ----- キューの積む、取り出す、盗む ----- //
+
+    // 持ち主が積みながら時々取り出し、thieves 個のスレッドが同時に盗む
+    void TestQueue(uint32_t jobCount, uint32_t thieves)
+    {
+        auto queue = std::make_unique<JobSystem::WorkStealingQueue>();
+        std::vector<std::atomic<uint32_t>> taken(jobCount);
+        std::atomic<uint32_t> takenCount{ 0 };
+        std::atomic<uint64_t> stolen{ 0 };
+        std::atomic<bool> ownerDone{ false };
+
+        auto record = [&](const Job& job)
+            {
+                taken[job.begin].fetch_add(1, std::memory_order_relaxed);
+                takenCount.fetch_add(1, std::memory_order_relaxed);
+            };
+
+        std::vector<std::thread> threads;
+        for (uint32_t t = 0; t < thieves; t++)
+        {
+            threads.emplace_back([&]()
+                {
+                    Job job;
+                    while (!ownerDone.load() || takenCount.load() < jobCount)
+                    {
+                        if (queue->Steal(job))
+                        {
+                            record(job);
+                            stolen.fetch_add(1, std::memory_order_relaxed);
+                        }
+                    }
+                });
+        }
+
+        // 持ち主（3つ積む毎に１つ取り出す、満杯なら取り出して空ける）
+        Job job;
+        for (uint32_t i = 0; i < jobCount; i++)
+        {
+            Job push;
+            push.begin = i;
+            while (!queue->Push(push))
+            {
+                if (queue->Pop(job)) record(job);
+            }
+            if (i % 3 == 2 && queue->Pop(job)) record(job);
+
+            // コア数が少ない環境でも盗む側が動けるようにする
+            if (i % 64 == 63) std::this_thread::yield();
+        }
+        while (queue->Pop(job)) record(job);
+        ownerDone = true;
+
+        for (auto& thread : threads) thread.join();
+
+        uint32_t wrong = 0;
+        for (uint32_t i = 0; i < jobCount; i++)
+        {
+            if (taken[i].load() != 1) wrong++;
+        }
+        Check(wrong == 0, "queue: " + std::to_string(wrong) + " jobs were not taken exactly once (thieves " + std::to_string(thieves) + ")");
+        Check(thieves == 0 || stolen.load() > 0, "queue: nothing was stolen");
+    }
+
+    // ----- 並列 for ----- //
+
+    void TestParallelFor(JobSystem& jobSystem, uint32_t count, uint32_t grainSize)
+    {
+        std::vector<std::atomic<uint32_t>> visits(count);
+        jobSystem.ParallelFor(count, grainSize, [&](uint32_t begin, uint32_t end)
+            {
+                for (uint32_t i = begin; i < end; i++) visits[i].fetch_add(1, std::memory_order_relaxed);
+            });
+
+        uint32_t wrong = 0;
+        for (auto& v : visits)
+        {
+            if (v.load() != 1) wrong++;
+        }
+        Check(wrong == 0, "parallel for: " + std::to_string(wrong) + " items were not visited exactly once");
+    }
+
+    // ----- 入れ子のジョブ（ワーカーのキューへ積んで盗ませる） ----- //
+
+    struct ForkContext
+    {
+        JobSystem* jobSystem;
+        std::atomic<uint32_t> leaves{ 0 };
+    };
+
+    // depth 段の２分木になるようにジョブを登録する
+    void Fork(ForkContext& context, uint32_t depth)
+    {
+        if (depth == 0)
+        {
+            context.leaves.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+
+        JobCounter counter;
+        auto child = [&context](uint32_t begin, uint32_t) { Fork(context, begin); };
+        context.jobSystem->Schedule(JobSystem::MakeJob(child, depth - 1), &counter);
+        Fork(context, depth - 1);
+        context.jobSystem->Wait(counter);
+    }
+
+    void TestNested(JobSystem& jobSystem, uint32_t depth)
+    {
+        ForkContext context{ &jobSystem };
+        JobCounter counter;
+        auto root = [&context](uint32_t begin, uint32_t) { Fork(context, begin); };
+        jobSystem.Schedule(JobSystem::MakeJob(root, depth), &counter);
+        jobSystem.Wait(counter);
+
+        Check(context.leaves.load() == (1u << depth), "nested: " + std::to_string(context.leaves.load()) + " leaves, expected " + std::to_string(1u << depth));
+    }
+
+    // ----- 依存関係 ----- //
+
+    void TestDependency(JobSystem& jobSystem, uint32_t count)
+    {
+        std::vector<uint32_t> values(count, 0);
+        std::atomic<uint32_t> mismatches{ 0 };
+
+        auto first = [&](uint32_t begin, uint32_t end)
+            {
+                for (uint32_t i = begin; i < end; i++) values[i] = i + 1;
+            };
+        auto second = [&](uint32_t begin, uint32_t end)
+            {
+                for (uint32_t i = begin; i < end; i++)
+                {
+                    if (values[i] != i + 1) mismatches.fetch_add(1);
+                }
+            };
+
+        // 後のジョブを先に登録しても、前のジョブが全て終わるまで実行されない
+        JobCounter firstCounter;
+        JobCounter secondCounter;
+        constexpr uint32_t Grain = 64;
+        for (uint32_t begin = 0; begin < count; begin += Grain)
+        {
+            jobSystem.Schedule(JobSystem::MakeJob(second, begin, std::min(begin + Grain, count)), &secondCounter, &firstCounter);
+        }
+        for (uint32_t begin = 0; begin < count; begin += Grain)
+        {
+            jobSystem.Schedule(JobSystem::MakeJob(first, begin, std::min(begin + Grain, count)), &firstCounter);
+        }
+        jobSystem.Wait(secondCounter);
+
+        Check(firstCounter.IsDone(), "dependency: first jobs are not done");
+        Check(mismatches.load() == 0, "dependency: " + std::to_string(mismatches.load()) + " items ran before their dependency");
+    }
+
+    // ----- 例外 ----- //
+
+    // ジョブの例外は全てのジョブが完了した後に待っている側で再送出される
+    void TestException(JobSystem& jobSystem, uint32_t count, uint32_t grainSize, uint32_t throwAt)
+    {
+        std::vector<std::atomic<uint32_t>> visits(count);
+        bool caught = false;
+        try
+        {
+            jobSystem.ParallelFor(count, grainSize, [&](uint32_t begin, uint32_t end)
+                {
+                    for (uint32_t i = begin; i < end; i++) visits[i].fetch_add(1, std::memory_order_relaxed);
+                    if (begin <= throwAt && throwAt < end) throw std::runtime_error("job");
+                });
+        }
+        catch (const std::runtime_error&)
+        {
+            caught = true;
+        }
+
+        // 例外が出ても他の範囲は全て実行されてから戻る
+        uint32_t wrong = 0;
+        for (auto& v : visits)
+        {
+            if (v.load() != 1) wrong++;
+        }
+        Check(caught, "exception: parallel for did not rethrow (throw at " + std::to_string(throwAt) + ")");
+        Check(wrong == 0, "exception: " + std::to_string(wrong) + " items were not visited exactly once");
+
+        // 登録したジョブの例外は Wait で再送出される
+        JobCounter counter;
+        auto thrower = [](uint32_t, uint32_t) { throw std::runtime_error("job"); };
+        jobSystem.Schedule(JobSystem::MakeJob(thrower), &counter);
+        caught = false;
+        try
+        {
+            jobSystem.Wait(counter);
+        }
+        catch (const std::runtime_error&)
+        {
+            caught = true;
+        }
+        Check(caught && counter.IsDone(), "exception: wait did not rethrow the job exception");
+    }
+
+    // ----- ワーカー以外のスレッドの待機 ----- //
+
+    // ワーカー以外のスレッドは、待っているカウンターのジョブだけを実行する
+    void TestExternalWait()
+    {
+        JobSystem jobSystem(1);
+
+        // ワーカーを止めておく
+        std::atomic<bool> started{ false };
+        std::atomic<bool> release{ false };
+        JobCounter blockCounter;
+        auto block = [&](uint32_t, uint32_t)
+            {
+                started = true;
+                while (!release.load()) std::this_thread::yield();
+            };
+        jobSystem.Schedule(JobSystem::MakeJob(block), &blockCounter);
+        while (!started.load()) std::this_thread::yield();
+
+        // 別のスレッドのジョブ（ロードなど）を共有のキューに入れる
+        JobCounter foreignCounter;
+        auto foreign = [](uint32_t, uint32_t) {};
+        std::thread other([&]() { jobSystem.Schedule(JobSystem::MakeJob(foreign), &foreignCounter); });
+        other.join();
+
+        // 自分のジョブを登録して待つ
+        std::thread::id ownThread;
+        JobCounter ownCounter;
+        auto own = [&](uint32_t, uint32_t) { ownThread = std::this_thread::get_id(); };
+        jobSystem.Schedule(JobSystem::MakeJob(own), &ownCounter);
+        jobSystem.Wait(ownCounter);
+
+        Check(ownThread == std::this_thread::get_id(), "external wait: own job was not run by the waiting thread");
+        Check(!foreignCounter.IsDone(), "external wait: ran a job of another counter");
+
+        release = true;
+        jobSystem.Wait(blockCounter);
+        jobSystem.Wait(foreignCounter);
+    }
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t rounds = 20;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--rounds" && i + 1 < argc) rounds = static_cast<uint32_t>(std::stoul(argv[++i]));
+        else
+        {
+            std::cerr << "unknown option: " << arg << "\n";
+            return 1;
+        }
+    }
+
+    uint32_t hardwareThreads = std::max(2u, std::thread::hardware_concurrency());
+
+    for (uint32_t round = 0; round < rounds && s_failures == 0; round++)
+    {
+        // キューの容量を超える数を流して、一周したスロットの再利用も確認する
+        for (uint32_t thieves : { 0u, 1u, 3u })
+        {
+            TestQueue(JobSystem::QueueCapacity * 4, thieves);
+        }
+
+        for (uint32_t workers : { 1u, 2u, hardwareThreads - 1 })
+        {
+            JobSystem jobSystem(workers);
+            TestParallelFor(jobSystem, 100000, 1 + round * 7);
+            TestNested(jobSystem, 10);
+            TestDependency(jobSystem, 4096);
+
+            // 呼び出し元で実行する先頭の範囲と、ジョブで実行する範囲の両方で例外を出す
+            TestException(jobSystem, 4096, 64, 0);
+            TestException(jobSystem, 4096, 64, 4095);
+        }
+    }
+
+    TestExternalWait();
+
+    if (s_failures)
+    {
+        std::cerr << s_failures << " checks failed\n";
+        return 1;
+    }
+
+    std::cout << "JobSystemTest: all checks passed (" << rounds << " rounds)\n";
+    return 0;
+}
@@ -0,0 +1,140 @@
+//--------------------------------------------------------------------------------------
+// File: RotationAccuracyTest.cpp
+//
+// 回転の補間方式の精度の確認
+//
+// 同梱のモデルのクリップを読み込み、正規化線形補間と補正付きの正規化線形補間の
+// 球面線形補間との誤差（MeasureRotationError）を出力して、許容値を超えていないことを確認します
+// また、アニメーターとアニメーションシステムの既定の補間方式が球面線形補間であることを確認します
+//
+// 使い方: RotationAccuracyTest [file.imdl]...
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "pch.h"
+#include "AnimationSystem.h"
+#include "ImdlLoader.h"
+
+#include <filesystem>
+#include <iostream>
+
+using namespace DirectX;
+using namespace Imase;
+
+namespace
+{
+    // 失敗した確認の数
+    uint32_t s_failures = 0;
+
+    // 条件を確認する関数（失敗したら内容を出力する）
+    void Check(bool condition, const std::string& message)
+    {
+        if (!condition)
+        {
+            std::cerr << "FAILED: " << message << "\n";
+            s_failures++;
+        }
+    }
+
+    // 補間方式と許容する最大の誤差（度）
+    struct Tolerance
+    {
+        RotationInterpolation mode;
+        const char* name;
+        float maxErrorDegrees;
+    };
+
+    // 同梱のクリップの実測値（正規化線形補間 0.02 度、補正付き 0.002 度）に余裕を持たせた値
+    constexpr Tolerance Tolerances[] =
+    {
+        { RotationInterpolation::Nlerp,     "nlerp",      0.1f  },
+        { RotationInterpolation::FastNlerp, "fast_nlerp", 0.01f },
+    };
+
+    // クリップの誤差を出力して確認する関数
+    void TestClips(const std::string& label, const std::vector<AnimationClip>& clips)
+    {
+        for (const AnimationClip& clip : clips)
+        {
+            for (const Tolerance& tolerance : Tolerances)
+            {
+                RotationErrorStats stats = MeasureRotationError(clip, tolerance.mode);
+                float maxDegrees = XMConvertToDegrees(stats.maxError);
+
+                std::cout << label << " " << clip.name << " " << tolerance.name
+                    << ": max " << maxDegrees << " deg, mean " << XMConvertToDegrees(stats.meanError)
+                    << " deg (" << stats.sampleCount << " samples)\n";
+
+                Check(maxDegrees <= tolerance.maxErrorDegrees,
+                    label + " " + clip.name + " " + tolerance.name + ": max error " + std::to_string(maxDegrees) + " deg");
+            }
+
+            // 球面線形補間同士は角度の計算の丸め誤差だけになる
+            RotationErrorStats slerp = MeasureRotationError(clip, RotationInterpolation::Slerp);
+            Check(XMConvertToDegrees(slerp.maxError) <= 1.0e-4f, label + " " + clip.name + ": slerp does not match itself");
+        }
+    }
+
+    // 既定の補間方式を確認する関数
+    void TestDefaults(const ModelAnimationData& model)
+    {
+        Animator animator(model);
+        Check(animator.GetRotationInterpolation() == RotationInterpolation::Slerp, "animator: default is not slerp");
+
+        AnimationSystem system;
+        uint32_t id = system.CreateAnimator(model);
+        Check(system.GetAnimator(id).GetRotationInterpolation() == RotationInterpolation::Slerp, "animation system: default is not slerp");
+    }
+}
+
+int main(int argc, char** argv)
+{
+    std::vector<std::filesystem::path> files;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (!arg.empty() && arg[0] == '-')
+        {
+            std::cerr << "unknown option: " << arg << "\n";
+            return 1;
+        }
+        files.emplace_back(arg);
+    }
+
+    // 指定が無い場合は同梱のアニメーション付きのモデル
+    if (files.empty())
+    {
+        for (const char* name : { "Human.imdl", "Anim.imdl", "Mixamo_Test.imdl" })
+        {
+            files.push_back(std::filesystem::path(IMASE_MODEL_DIR) / name);
+        }
+    }
+
+    for (const auto& path : files)
+    {
+        ImdlMappedData data;
+        if (FAILED(ImdlLoader::LoadImdlMapped(path.wstring(), data)))
+        {
+            std::cerr << "failed to load: " << path.string() << "\n";
+            return 1;
+        }
+        Check(!data.animationClips.empty(), path.stem().string() + ": no animation");
+
+        TestClips(path.stem().string(), data.animationClips);
+
+        // クリップはモデルへ移動するので誤差を調べた後に作成する
+        auto model = ModelAnimationData::CreateFromImdlData(data);
+        TestDefaults(*model);
+    }
+
+    if (s_failures)
+    {
+        std::cerr << s_failures << " checks failed\n";
+        return 1;
+    }
+
+    std::cout << "RotationAccuracyTest: all checks passed\n";
+    return 0;
+}
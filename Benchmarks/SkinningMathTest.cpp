@@ -0,0 +1,182 @@
+//--------------------------------------------------------------------------------------
+// File: SkinningMathTest.cpp
+//
+// スキン行列の形式の確認
+//
+// ランダムなスキン行列を PackSkinMatrix で各形式へ変換し、SkinPosition の結果を
+// XMVector3Transform で変換した位置の重み付きの和（リファレンス）と比べます
+//   Matrix4x4, Matrix3x4 : 回転と平行移動のみの行列と、スケールとせん断を含むアフィン行列
+//   DualQuaternion       : 回転と平行移動のみの行列（スケールは扱えない）
+//                          複数のボーンの補間は線形の合成とは異なるので、１ボーンか同じ行列のボーンのみ
+//
+// 使い方: SkinningMathTest [--cases N]
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "pch.h"
+#include "SkinningMath.h"
+
+#include <iostream>
+#include <random>
+
+using namespace DirectX;
+using namespace Imase;
+
+namespace
+{
+    // 失敗した確認の数
+    uint32_t s_failures = 0;
+
+    // 条件を確認する関数（失敗したら内容を出力する）
+    void Check(bool condition, const std::string& message)
+    {
+        if (!condition)
+        {
+            std::cerr << "FAILED: " << message << "\n";
+            s_failures++;
+        }
+    }
+
+    // パレットのボーン数
+    constexpr uint32_t JointCount = 8;
+
+    // 許容する誤差（位置の大きさに対する割合）
+    constexpr float Tolerance = 1.0e-4f;
+
+    std::mt19937 s_random(12345);
+
+    float Random(float minValue, float maxValue)
+    {
+        return std::uniform_real_distribution<float>(minValue, maxValue)(s_random);
+    }
+
+    // 回転と平行移動のみの行列
+    XMMATRIX RandomRigidMatrix()
+    {
+        XMVECTOR rotation = XMQuaternionRotationRollPitchYaw(Random(-XM_PI, XM_PI), Random(-XM_PI, XM_PI), Random(-XM_PI, XM_PI));
+        XMVECTOR translation = XMVectorSet(Random(-10.0f, 10.0f), Random(-10.0f, 10.0f), Random(-10.0f, 10.0f), 0.0f);
+        return XMMatrixMultiply(XMMatrixRotationQuaternion(rotation), XMMatrixTranslationFromVector(translation));
+    }
+
+    // スケールとせん断を含むアフィン行列
+    XMMATRIX RandomAffineMatrix()
+    {
+        XMFLOAT4X4 shear;
+        XMStoreFloat4x4(&shear, XMMatrixIdentity());
+        shear.m[1][0] = Random(-0.5f, 0.5f);
+        shear.m[2][0] = Random(-0.5f, 0.5f);
+        shear.m[2][1] = Random(-0.5f, 0.5f);
+
+        XMVECTOR scale = XMVectorSet(Random(0.2f, 3.0f), Random(0.2f, 3.0f), Random(0.2f, 3.0f), 0.0f);
+        return XMMatrixMultiply(
+            XMMatrixMultiply(XMMatrixScalingFromVector(scale), XMLoadFloat4x4(&shear)),
+            RandomRigidMatrix());
+    }
+
+    // 重み付きの XMVector3Transform の和
+    XMFLOAT3 ReferencePosition(const XMMATRIX* matrices, const XMFLOAT3& position, const uint32_t joints[4], const float weights[4])
+    {
+        XMVECTOR p = XMLoadFloat3(&position);
+        XMVECTOR result = XMVectorZero();
+        for (int i = 0; i < 4; i++)
+        {
+            result = XMVectorAdd(result, XMVectorScale(XMVector3Transform(p, matrices[joints[i]]), weights[i]));
+        }
+
+        XMFLOAT3 out;
+        XMStoreFloat3(&out, result);
+        return out;
+    }
+
+    // 位置の差が許容範囲か調べる関数
+    bool IsNear(const XMFLOAT3& a, const XMFLOAT3& b)
+    {
+        float scale = std::max({ 1.0f, std::abs(b.x), std::abs(b.y), std::abs(b.z) });
+        float error = std::max({ std::abs(a.x - b.x), std::abs(a.y - b.y), std::abs(a.z - b.z) });
+        return error <= Tolerance * scale;
+    }
+
+    const char* GetFormatName(SkinFormat format)
+    {
+        switch (format)
+        {
+        case SkinFormat::Matrix3x4:      return "3x4";
+        case SkinFormat::DualQuaternion: return "dq";
+        default:                         return "4x4";
+        }
+    }
+
+    // 指定した形式で cases 回比べる関数
+    // sameJoint が true なら４つの影響を全て同じボーンにする（デュアルクォータニオン用）
+    void TestFormat(SkinFormat format, bool affine, bool sameJoint, uint32_t cases)
+    {
+        size_t stride = GetSkinVectorCount(format);
+        std::vector<XMFLOAT4> palette(JointCount * stride);
+        XMMATRIX matrices[JointCount];
+
+        uint32_t failed = 0;
+        for (uint32_t c = 0; c < cases; c++)
+        {
+            for (uint32_t j = 0; j < JointCount; j++)
+            {
+                matrices[j] = affine ? RandomAffineMatrix() : RandomRigidMatrix();
+                PackSkinMatrix(format, matrices[j], &palette[j * stride]);
+            }
+
+            uint32_t joints[4];
+            float weights[4];
+            float total = 0.0f;
+            uint32_t first = s_random() % JointCount;
+            for (int i = 0; i < 4; i++)
+            {
+                joints[i] = sameJoint ? first : s_random() % JointCount;
+                weights[i] = Random(0.0f, 1.0f);
+                total += weights[i];
+            }
+            for (float& w : weights) w /= total;
+
+            XMFLOAT3 position(Random(-2.0f, 2.0f), Random(-2.0f, 2.0f), Random(-2.0f, 2.0f));
+
+            XMFLOAT3 result = SkinPosition(format, palette.data(), position, joints, weights);
+            XMFLOAT3 reference = ReferencePosition(matrices, position, joints, weights);
+
+            if (!IsNear(result, reference)) failed++;
+        }
+
+        std::string name = std::string(GetFormatName(format)) + (affine ? " affine" : " rigid") + (sameJoint ? " single joint" : " blended");
+        Check(failed == 0, name + ": " + std::to_string(failed) + " of " + std::to_string(cases) + " positions differ from XMVector3Transform");
+    }
+}
+
+int main(int argc, char** argv)
+{
+    uint32_t cases = 1000;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+        if (arg == "--cases" && i + 1 < argc) cases = static_cast<uint32_t>(std::stoul(argv[++i]));
+        else
+        {
+            std::cerr << "unknown option: " << arg << "\n";
+            return 1;
+        }
+    }
+
+    for (SkinFormat format : { SkinFormat::Matrix4x4, SkinFormat::Matrix3x4 })
+    {
+        TestFormat(format, false, false, cases);
+        TestFormat(format, true, false, cases);
+    }
+    TestFormat(SkinFormat::DualQuaternion, false, true, cases);
+
+    if (s_failures)
+    {
+        std::cerr << s_failures << " checks failed\n";
+        return 1;
+    }
+
+    std::cout << "SkinningMathTest: all checks passed (" << cases << " cases per format)\n";
+    return 0;
+}
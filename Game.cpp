@@ -12,6 +12,12 @@ using namespace DirectX;
 
 using Microsoft::WRL::ComPtr;
 
+namespace
+{
+    // 初期化に伴うメモリ確保が落ち着くまでのフレーム数
+    constexpr uint64_t SteadyStateFrameCount = 60;
+}
+
 Game::Game() noexcept(false)
 {
     m_deviceResources = std::make_unique<DX::DeviceResources>();
@@ -39,10 +45,10 @@ void Game::Initialize(HWND window, int width, int height)
     m_timer.SetTargetElapsedSeconds(1.0 / 60);
     */
 
-    // fobOJ̍쐬
+    // デバッグカメラの作成
     m_debugCamera = std::make_unique<Imase::DebugCamera>(width, height);
 
-    // Cg̏̕
+    // ライトの方向の初期化
     m_lightDirection = SimpleMath::Vector3(0.0f, -1.0f, 0.0f);
     m_lightDirection.Normalize();
 
@@ -56,6 +62,12 @@ void Game::Initialize(HWND window, int width, int height)
 // Executes the basic game loop.
 void Game::Tick()
 {
+    // 前のフレームの一時メモリを解放
+    Imase::FrameArena::GetInstance().Reset();
+
+    // 最初の数フレーム以降はメインスレッドのヒープの確保が無いことを確認する（デバッグビルドのみ）
+    Imase::HeapAllocationCheck heapCheck(m_timer.GetFrameCount() >= SteadyStateFrameCount);
+
     m_timer.Tick([&]()
     {
         Update(m_timer);
@@ -72,7 +84,7 @@ void Game::Update(DX::StepTimer const& timer)
     // TODO: Add your game logic here.
     elapsedTime;
 
-    // fobOJ̍XV
+    // デバッグカメラの更新
     m_debugCamera->Update();
 
     auto key = Keyboard::Get().GetState();
@@ -88,8 +100,11 @@ void Game::Update(DX::StepTimer const& timer)
         m_animator->CrossFade(AnimationIndex::walk, 0.5f);
     }
 
-    // Aj[V̍XV
+    // アニメーションの更新
     m_animator->Update(elapsedTime);
+
+    // スキン行列の更新（描画毎ではなく更新毎に１回）
+    m_skinPalette->Update(m_animator->GetWorldMatrices());
 }
 #pragma endregion
 
@@ -110,17 +125,17 @@ void Game::Render()
 
     // TODO: Add your rendering code here.
 
-    // r[s擾
+    // ビュー行列を取得する
     SimpleMath::Matrix view = m_debugCamera->GetCameraMatrix();
 
-    // Obh̏̕`
+    // グリッドの床の描画
     m_gridFloor->Render(context, view, m_proj);
 
     // ------------------------------------------------------- //
-    // f` 
+    // モデル描画 
     // ------------------------------------------------------- //
 
-    // r[sƃvWFNVsݒ
+    // ビュー行列とプロジェクション行列を設定
     Imase::Effect* effect = m_model->GetEffect();
     effect->SetViewProjection(view, m_proj);
     effect->BeginFrame(context);
@@ -129,13 +144,18 @@ void Game::Render()
     //effect->SetLightEnabled(1, false);
     //effect->SetLightEnabled(2, false);
 
-    // f̕`
+    // 描画する全キャラクターのスキン行列をまとめて１回で転送
+    m_skinPaletteBuffer->Begin();
+    m_skinPalette->WriteTo(*m_skinPaletteBuffer);
+    m_skinPaletteBuffer->Upload(context);
+
+    // モデルの描画
     SimpleMath::Matrix world;
     //m_model->Draw(context, world);
     world = SimpleMath::Matrix::CreateTranslation(-2, 0, 2);
-    m_model->Draw(context, world, &m_animator->GetWorldMatrices());
+    m_model->Draw(context, world, m_animator->GetWorldMatrices(), m_skinPalette.get());
     world = SimpleMath::Matrix::CreateTranslation(2, 0, -2);
-    m_model->Draw(context, world, &m_animator->GetWorldMatrices());
+    m_model->Draw(context, world, m_animator->GetWorldMatrices(), m_skinPalette.get());
 
     world = SimpleMath::Matrix::CreateTranslation(2, 0, 2);
     m_dxtkModel->Draw(context, *m_states, world, view, m_proj);
@@ -241,27 +261,27 @@ void Game::CreateDeviceDependentResources()
 
     // TODO: Initialize device dependent objects here (independent of window size).
     
-    // RXe[g̍쐬
+    // コモンステートの作成
     m_states = std::make_unique<CommonStates>(device);
 
-    // Obh̏̍쐬
+    // グリッドの床の作成
     m_gridFloor = std::make_unique<Imase::GridFloor>(device, context, m_states.get());
 
     // -------------------------------------------------------------------------------------- //
 
-    // VF[_[̍쐬
+    // シェーダーの作成
     m_shader = std::make_unique<Imase::BasicShader>(device);
     m_Pshader = std::make_unique<Imase::PixelLightingShader>(device);
     m_Nshader = std::make_unique<Imase::NormalMapShader>(device);
 
-    // GtFNg̍쐬
+    // エフェクトの作成
     m_effect = std::make_unique<Imase::Effect>(device, m_Nshader.get());
 
     m_effect->LoadIrradianceTexture(device, L"Resources/Textures/Irradiance.dds");
     m_effect->LoadPrefilterTexture(device, L"Resources/Textures/prefilter.dds");
     m_effect->LoadBrdfTexture(device, L"Resources/Textures/brdf.dds");
 
-    // f̍쐬
+    // モデルの作成
     m_model = Imase::Model::CreateFromImdl(device, L"Resources/Models/Dice.imdl", m_effect.get());
 
     EffectFactory fx(device);
@@ -277,19 +297,23 @@ void Game::CreateDeviceDependentResources()
         }
     );
 
-    // Aj[^[̍쐬
+    // アニメーターの作成
     m_animator = std::make_unique<Imase::Animator>(*m_model.get());
 
+    // スキン行列の作成
+    m_skinPalette = std::make_unique<Imase::SkinPalette>(device, *m_model.get());
+    m_skinPaletteBuffer = std::make_unique<Imase::SkinPaletteBuffer>(device);
+
     m_sp = std::make_unique<SpriteBatch>(context);
 
     //CreateDDSTextureFromFile(device, L"Textures/horn-koppe_spring_4k.dds", nullptr, m_cubeMap.ReleaseAndGetAddressOf());
 
     //{
-    //    // Texture2D쐬
+    //    // Texture2D作成
     //    D3D11_TEXTURE2D_DESC desc = {};
     //    desc.Width = 512;
     //    desc.Height = 512;
-    //    desc.MipLevels = 1; // <- MipMap͂Ȃ
+    //    desc.MipLevels = 1; // <- MipMap生成はしない
     //    desc.ArraySize = 6;
     //    desc.Format = DXGI_FORMAT_R16G16B16A16_FLOAT;
 
@@ -308,7 +332,7 @@ void Game::CreateDeviceDependentResources()
     //        m_cubeTex.ReleaseAndGetAddressOf());
 
 
-    //    // RTV쐬
+    //    // RTV作成
     //    D3D11_RENDER_TARGET_VIEW_DESC rtvDesc = {};
     //    rtvDesc.Format = desc.Format;
     //    rtvDesc.ViewDimension = D3D11_RTV_DIMENSION_TEXTURE2DARRAY;
@@ -322,7 +346,7 @@ void Game::CreateDeviceDependentResources()
     //        &rtvDesc,
     //        m_cubeRTV.ReleaseAndGetAddressOf());
 
-    //    // SRV쐬
+    //    // SRV作成
     //    D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
 
     //    srvDesc.Format = desc.Format;
@@ -344,11 +368,11 @@ void Game::CreateWindowSizeDependentResources()
 {
     // TODO: Initialize windows-size dependent objects here.
     
-    // ʃTCY擾
+    // 画面サイズを取得する
     int w, h;
     GetDefaultSize(w, h);
 
-    // vWFNVs̍쐬
+    // プロジェクション行列の作成
     m_proj = SimpleMath::Matrix::CreatePerspectiveFieldOfView(
         XMConvertToRadians(45.0f),
         static_cast<float>(w) / static_cast<float>(h),
@@ -360,6 +384,9 @@ void Game::CreateWindowSizeDependentResources()
 void Game::OnDeviceLost()
 {
     // TODO: Add Direct3D resource cleanup here.
+
+    // 共有テクスチャを解放
+    Imase::TextureRegistry::GetInstance().Clear();
 }
 
 void Game::OnDeviceRestored()
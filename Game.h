@@ -15,6 +15,10 @@
 #include "ImaseLib/Shaders/NormalMapShader.h"
 #include "ImaseLib/Shaders/PixelLightingShader.h"
 #include "ImaseLib/Animator.h"
+#include "ImaseLib/SkinPalette.h"
+#include "ImaseLib/TextureRegistry.h"
+#include "ImaseLib/FrameArena.h"
+#include "ImaseLib/HeapAllocationCounter.h"
 
 #include "SpriteBatch.h"
 
@@ -73,36 +77,42 @@ private:
 
 private:
 
-    // RXe[g
+    // コモンステート
     std::unique_ptr<DirectX::CommonStates> m_states;
 
-    // vWFNVs
+    // プロジェクション行列
     DirectX::SimpleMath::Matrix m_proj;
 
-    // fobOJ
+    // デバッグカメラ
     std::unique_ptr<Imase::DebugCamera> m_debugCamera;
 
-    // Obh̏
+    // グリッドの床
     std::unique_ptr<Imase::GridFloor> m_gridFloor;
 
     // --------------------------------------------------------- //
 
-    // Cg̕
+    // ライトの方向
     DirectX::SimpleMath::Vector3 m_lightDirection;
 
-    // VF[_[
+    // シェーダー
     std::unique_ptr<Imase::BasicShader> m_shader;
     std::unique_ptr<Imase::PixelLightingShader> m_Pshader;
     std::unique_ptr<Imase::NormalMapShader> m_Nshader;
 
-    // GtFNg
+    // エフェクト
     std::unique_ptr<Imase::Effect> m_effect;
 
-    // f
+    // モデル
     std::unique_ptr<Imase::Model> m_model;
 
     std::unique_ptr<Imase::Animator> m_animator;
 
+    // スキン行列（２体で共有する）
+    std::unique_ptr<Imase::SkinPalette> m_skinPalette;
+
+    // 全キャラクターのスキン行列をまとめたバッファ
+    std::unique_ptr<Imase::SkinPaletteBuffer> m_skinPaletteBuffer;
+
     std::unique_ptr<DirectX::SpriteBatch> m_sp;
 
     Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> m_cubeMap;
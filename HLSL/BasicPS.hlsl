@@ -8,7 +8,7 @@ float4 main(VSOutput pin) : SV_Target
 {
     float4 color = pin.Diffuse;
 
-    // eNX`
+    // テクスチャあり
     if (Flags & 0x1)
     {
         color *= Texture.Sample(Sampler, pin.TexCoord);
@@ -0,0 +1,10 @@
+// 圧縮頂点形式（VSInputPacked）用の頂点シェーダー
+// 頂点を展開して BasicVS.hlsl の処理をそのまま使う
+#define main BasicVSMain
+#include "BasicVS.hlsl"
+#undef main
+
+VSOutput main(VSInputPacked packed)
+{
+    return BasicVSMain(DecodeVertex(packed));
+}
@@ -8,36 +8,33 @@ VSOutput main(VSInput vin)
 
     float4 pos = float4(vin.Position, 1.0);
 
-    // XLL
+    // スキン有り
     if (UseSkin)
     {
-        pos = mul(pos, SkinMatrices[vin.Joint.x]) * vin.Weight.x
-            + mul(pos, SkinMatrices[vin.Joint.y]) * vin.Weight.y
-            + mul(pos, SkinMatrices[vin.Joint.z]) * vin.Weight.z
-            + mul(pos, SkinMatrices[vin.Joint.w]) * vin.Weight.w;
+        pos = SkinPosition(pos, vin.Joint, vin.Weight);
     }
     
-    // Wϊ
+    // 座標変換
     float4 worldPos = mul(World, pos);
     float4 viewPos = mul(View, worldPos);
     vout.Position = mul(Projection, viewPos);
 
-    // Jւ̕xNg
+    // カメラへの方向ベクトル
     float3 eyeVector = normalize(EyePosition.xyz - worldPos.xyz);
 
-    // @xNg[hԂ
+    // 法線ベクトルをワールド空間へ
     float3 normal = normalize(mul((float3x3)WorldInverseTranspose, vin.Normal));
 
-    // CǧvZ
+    // ライトの計算
     ColorPair result = ComputeLights(eyeVector, normal);
 
-    // fBt[YF
+    // ディフューズ色
     vout.Diffuse = result.Diffuse;
     
-    // XyLF
+    // スペキュラ色
     vout.Specular = result.Specular;
     
-    // eNX`W
+    // テクスチャ座標
     vout.TexCoord = vin.TexCoord;
 
     return vout;
@@ -1,7 +1,7 @@
 #ifndef COMMON
 #define COMMON
 
-// 萔obt@Ft[łPXV
+// 定数バッファ：フレームで１回更新
 cbuffer PerFrameCB : register(b0)
 {
     float4x4 View;
@@ -16,17 +16,22 @@ cbuffer PerFrameCB : register(b0)
     float4 EyePosition;
 };
 
-// 萔obt@FIuWFNgXV
+// 定数バッファ：オブジェクト毎更新
 cbuffer PerObjectCB : register(b1)
 {
     float4x4 World;
     float4x4 WorldInverseTranspose;
 
     uint UseSkin;
-    float3 _paddding_O0;
+    uint SkinFormat;        // 0:4x4行列 1:3x4行列 2:デュアルクォータニオン
+    uint SkinBufferOffset;  // ストラクチャードバッファ内の先頭位置（float4 単位）
+    uint UseSkinBuffer;     // 1:ストラクチャードバッファ 0:定数バッファ からスキン行列を読む
+
+    float4 PositionScale;   // 量子化された位置の復元用（xyz）
+    float4 PositionOffset;
 };
 
-// 萔obt@F}eA
+// 定数バッファ：マテリアル
 cbuffer PerMaterialCB : register(b2)
 {
     float4 BaseColor;   // RGB + Alpha
@@ -39,21 +44,121 @@ cbuffer PerMaterialCB : register(b2)
     float2 _paddding_M0;
 };
 
-// 萔obt@FXLs
+// 定数バッファ：スキン行列（１ボーンあたり 4x4:4個 3x4:3個 デュアルクォータニオン:2個）
 cbuffer SkinCB : register(b3)
 {
-    float4x4 SkinMatrices[128];
+    float4 SkinPalette[128 * 4];
 };
 
-// _VF[_[̓͗p
+// スキン行列（複数キャラクター分をまとめたバッファ、ボーン数の上限なし）
+StructuredBuffer<float4> SkinPaletteBuffer : register(t0);
+
+// スキン行列の float4 を読み込む
+float4 LoadSkinVector(uint index)
+{
+    return UseSkinBuffer ? SkinPaletteBuffer[SkinBufferOffset + index] : SkinPalette[index];
+}
+
+// スキン行列の形式
+#define SKIN_FORMAT_MATRIX4X4       0
+#define SKIN_FORMAT_MATRIX3X4       1
+#define SKIN_FORMAT_DUALQUATERNION  2
+
+// 行列のスキニング（行列は列毎に stride 個の float4 で格納）
+float3 SkinPositionMatrix(float4 pos, uint4 joint, float4 weight, uint stride)
+{
+    float3 result = 0;
+
+    [unroll]
+    for (int i = 0; i < 4; i++)
+    {
+        uint base = joint[i] * stride;
+        result += float3(dot(pos, LoadSkinVector(base)), dot(pos, LoadSkinVector(base + 1)), dot(pos, LoadSkinVector(base + 2))) * weight[i];
+    }
+    return result;
+}
+
+// デュアルクォータニオンのスキニング
+float3 SkinPositionDualQuaternion(float3 pos, uint4 joint, float4 weight)
+{
+    float4 q0 = LoadSkinVector(joint.x * 2);
+    float4 r = 0;
+    float4 d = 0;
+
+    [unroll]
+    for (int i = 0; i < 4; i++)
+    {
+        float4 q = LoadSkinVector(joint[i] * 2);
+        float4 e = LoadSkinVector(joint[i] * 2 + 1);
+
+        // 最初のボーンと逆向きのものは符号を反転
+        float w = dot(q, q0) < 0.0f ? -weight[i] : weight[i];
+        r += q * w;
+        d += e * w;
+    }
+
+    float scale = 1.0f / max(length(r), 1e-6f);
+    r *= scale;
+    d *= scale;
+
+    float3 rotated = pos + 2.0f * cross(r.xyz, cross(r.xyz, pos) + r.w * pos);
+    float3 translation = 2.0f * (r.w * d.xyz - d.w * r.xyz + cross(r.xyz, d.xyz));
+    return rotated + translation;
+}
+
+// スキニング後の位置を計算（CPU側のリファレンスは SkinningMath.h）
+float4 SkinPosition(float4 pos, uint4 joint, float4 weight)
+{
+    if (SkinFormat == SKIN_FORMAT_DUALQUATERNION)
+    {
+        return float4(SkinPositionDualQuaternion(pos.xyz, joint, weight), 1.0f);
+    }
+    return float4(SkinPositionMatrix(pos, joint, weight, SkinFormat == SKIN_FORMAT_MATRIX3X4 ? 3 : 4), 1.0f);
+}
+
+// 頂点シェーダーの入力用
 struct VSInput
 {
-    float3 Position : POSITION;     // ʒu
-    float3 Normal   : NORMAL;       // @
-    float2 TexCoord : TEXCOORD;     // eNX`W
-    float4 Tangent  : TANGENT;      // ڐ
-    uint4 Joint     : BLENDINDICES; // WCgCfbNX
-    float4 Weight   : BLENDWEIGHT;  // EGCg
+    float3 Position : POSITION;     // 位置
+    float3 Normal   : NORMAL;       // 法線
+    float2 TexCoord : TEXCOORD;     // テクスチャ座標
+    float4 Tangent  : TANGENT;      // 接線
+    uint4 Joint     : BLENDINDICES; // ジョイントインデックス
+    float4 Weight   : BLENDWEIGHT;  // ウエイト
+};
+
+// 頂点シェーダーの入力用（圧縮形式）
+struct VSInputPacked
+{
+    float4 Position      : POSITION;     // 位置（量子化時は AABB 内の正規化位置）
+    float4 NormalTangent : NORMAL;       // 八面体エンコードした法線(xy)と接線(zw)
+    float2 TexCoord      : TEXCOORD;     // テクスチャ座標
+    uint4 Joint          : BLENDINDICES; // ジョイントインデックス
+    float4 Weight        : BLENDWEIGHT;  // xyz = ウエイト, w = 従接線の向き（0:-1, 1:+1）
 };
 
+// 八面体エンコードされたベクトルを復元
+float3 OctDecode(float2 e)
+{
+    float3 n = float3(e, 1.0f - abs(e.x) - abs(e.y));
+    float t = saturate(-n.z);
+    n.xy += (n.xy >= 0.0f) ? -t : t;
+    return normalize(n);
+}
+
+// 圧縮形式の頂点を展開
+VSInput DecodeVertex(VSInputPacked packed)
+{
+    VSInput vin;
+
+    vin.Position = packed.Position.xyz * PositionScale.xyz + PositionOffset.xyz;
+    vin.Normal = OctDecode(packed.NormalTangent.xy);
+    vin.TexCoord = packed.TexCoord;
+    vin.Tangent = float4(OctDecode(packed.NormalTangent.zw), packed.Weight.w > 0.5f ? 1.0f : -1.0f);
+    vin.Joint = packed.Joint;
+    vin.Weight = float4(packed.Weight.xyz, saturate(1.0f - packed.Weight.x - packed.Weight.y - packed.Weight.z));
+
+    return vin;
+}
+
 #endif  // COMMON
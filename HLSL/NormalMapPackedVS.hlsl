@@ -0,0 +1,10 @@
+// 圧縮頂点形式（VSInputPacked）用の頂点シェーダー
+// 頂点を展開して NormalMapVS.hlsl の処理をそのまま使う
+#define main NormalMapVSMain
+#include "NormalMapVS.hlsl"
+#undef main
+
+VSOutput main(VSInputPacked packed)
+{
+    return NormalMapVSMain(DecodeVertex(packed));
+}
@@ -1,13 +1,13 @@
 #ifndef PIXEL_LIGHTING
 #define PIXEL_LIGHTING
 
-// _VF[_[̏o͗p
+// 頂点シェーダーの出力用
 struct VSOutput
 {
-    float2 TexCoord     : TEXCOORD0;    // eNX`W
-    float3 WorldPos     : TEXCOORD1;    // [hԂ̈ʒu
-    float3 NormalWS     : TEXCOORD2;    // [hԂ̖@
-    float4 Position     : SV_POSITION;  // ʒu
+    float2 TexCoord     : TEXCOORD0;    // テクスチャ座標
+    float3 WorldPos     : TEXCOORD1;    // ワールド空間の位置
+    float3 NormalWS     : TEXCOORD2;    // ワールド空間の法線
+    float4 Position     : SV_POSITION;  // 位置
 };
 
 #endif // PIXEL_LIGHTING
@@ -7,18 +7,18 @@ SamplerState Sampler : register(s0);
 
 float4 main(VSOutput pin) : SV_Target
 {
-    // @
+    // 法線
     float3 N = normalize(pin.NormalWS);
     
-    // xNgi[hԁj
+    // 視線ベクトル（ワールド空間）
     float3 V = normalize(EyePosition.xyz - pin.WorldPos);
 
-    // CǧvZ
+    // ライトの計算
     ColorPair result = ComputeLights(V, N);
 
     float4 color = result.Diffuse;
 
-    // eNX`
+    // テクスチャあり
     if (Flags & 0x1)
     {
         color *= Texture.Sample(Sampler, pin.TexCoord);
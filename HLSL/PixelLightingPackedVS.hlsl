@@ -0,0 +1,10 @@
+// 圧縮頂点形式（VSInputPacked）用の頂点シェーダー
+// 頂点を展開して PixelLightingVS.hlsl の処理をそのまま使う
+#define main PixelLightingVSMain
+#include "PixelLightingVS.hlsl"
+#undef main
+
+VSOutput main(VSInputPacked packed)
+{
+    return PixelLightingVSMain(DecodeVertex(packed));
+}
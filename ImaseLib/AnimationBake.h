@@ -0,0 +1,274 @@
+//--------------------------------------------------------------------------------------
+// File: AnimationBake.h
+//
+// アニメーションクリップを一定間隔のフレームに焼き込む関数（変換コンバーターと読み込み側共通）
+//
+// 焼き込んだクリップはフレーム毎に全チャンネルの値が連続して並ぶので、
+// キーの検索をせずにフレーム番号の計算と隣接フレームの補間だけでサンプリングできます
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include "Imdl.h"
+#include "AnimationPose.h"
+
+namespace Imase
+{
+    // 焼き込んだアニメーションクリップ
+    struct BakedAnimationClip
+    {
+        float sampleRate = 0.0f;    // 1秒あたりのフレーム数
+        float duration = 0.0f;      // アニメーションの時間
+        uint32_t frameCount = 0;    // フレーム数（最後のフレームは duration の位置）
+
+        // チャンネル毎のノード番号
+        std::vector<uint32_t> translationNodes;
+        std::vector<uint32_t> rotationNodes;
+        std::vector<uint32_t> scaleNodes;
+
+        // フレーム毎の値（移動 xyz、回転 xyzw、スケール xyz の順にチャンネル数分並ぶ）
+        std::vector<float> frames;
+        uint32_t frameStride = 0;
+
+        bool IsValid() const { return frameCount >= 2; }
+    };
+
+    // 焼き込みの誤差（元のカーブとの差の最大値）
+    struct AnimationBakeReport
+    {
+        float maxTranslationError = 0.0f;   // 距離
+        float maxRotationError = 0.0f;      // 角度（ラジアン）
+        float maxScaleError = 0.0f;         // 各成分の差
+    };
+
+    namespace AnimationBakeDetail
+    {
+        // 指定時間を含むキーの区間を二分探索する関数
+        inline size_t FindInterval(const std::vector<float>& times, float time, float& t)
+        {
+            size_t i = std::upper_bound(times.begin(), times.end(), time) - times.begin();
+            i = std::clamp<size_t>(i, 1, times.size() - 1) - 1;
+
+            float span = times[i + 1] - times[i];
+            t = span > 0.0f ? std::clamp((time - times[i]) / span, 0.0f, 1.0f) : 0.0f;
+            return i;
+        }
+
+        // 元のチャンネルの値を取得する関数（線形補間）
+        inline DirectX::XMVECTOR Evaluate(const AnimationChannelVec3& ch, float time)
+        {
+            using namespace DirectX;
+
+            if (ch.times.size() < 2)
+            {
+                return ch.values.empty() ? XMVectorZero() : XMLoadFloat3(&ch.values.front());
+            }
+
+            float t;
+            size_t i = FindInterval(ch.times, time, t);
+            return XMVectorLerp(XMLoadFloat3(&ch.values[i]), XMLoadFloat3(&ch.values[i + 1]), t);
+        }
+
+        // 元のチャンネルの値を取得する関数（球面線形補間）
+        inline DirectX::XMVECTOR Evaluate(const AnimationChannelQuat& ch, float time)
+        {
+            using namespace DirectX;
+
+            if (ch.times.size() < 2)
+            {
+                return ch.values.empty() ? XMQuaternionIdentity() : XMLoadFloat4(&ch.values.front());
+            }
+
+            float t;
+            size_t i = FindInterval(ch.times, time, t);
+            return XMQuaternionSlerp(XMLoadFloat4(&ch.values[i]), XMLoadFloat4(&ch.values[i + 1]), t);
+        }
+    }
+
+    // 焼き込んだクリップの指定時間の各チャンネルの値を取得する関数
+    // visitor.Translation(node, XMFLOAT3)、Rotation(node, XMFLOAT4)、Scale(node, XMFLOAT3) がチャンネル毎に呼ばれる
+    template <class Visitor>
+    inline void VisitBakedClip(const BakedAnimationClip& clip, float time, Visitor&& visitor)
+    {
+        using namespace DirectX;
+
+        // フレーム番号と補間係数
+        float f = std::clamp(time * clip.sampleRate, 0.0f, static_cast<float>(clip.frameCount - 1));
+        uint32_t frame = std::min(static_cast<uint32_t>(f), clip.frameCount - 2);
+        float t = f - static_cast<float>(frame);
+
+        const float* p0 = clip.frames.data() + static_cast<size_t>(frame) * clip.frameStride;
+        const float* p1 = p0 + clip.frameStride;
+
+        // 移動
+        for (uint32_t node : clip.translationNodes)
+        {
+            visitor.Translation(node, XMFLOAT3(
+                p0[0] + (p1[0] - p0[0]) * t,
+                p0[1] + (p1[1] - p0[1]) * t,
+                p0[2] + (p1[2] - p0[2]) * t));
+            p0 += 3;
+            p1 += 3;
+        }
+
+        // 回転（隣接フレームは焼き込み時に同じ半球に揃えてあるので正規化線形補間で済む）
+        for (uint32_t node : clip.rotationNodes)
+        {
+            XMVECTOR r = XMVectorLerp(
+                XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(p0)),
+                XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(p1)), t);
+
+            XMFLOAT4 q;
+            XMStoreFloat4(&q, XMQuaternionNormalize(r));
+            visitor.Rotation(node, q);
+            p0 += 4;
+            p1 += 4;
+        }
+
+        // スケール
+        for (uint32_t node : clip.scaleNodes)
+        {
+            visitor.Scale(node, XMFLOAT3(
+                p0[0] + (p1[0] - p0[0]) * t,
+                p0[1] + (p1[1] - p0[1]) * t,
+                p0[2] + (p1[2] - p0[2]) * t));
+            p0 += 3;
+            p1 += 3;
+        }
+    }
+
+    // 焼き込んだクリップの指定時間の値をポーズに設定する関数
+    inline void SampleBakedClip(const BakedAnimationClip& clip, float time, AnimationPose& outPose)
+    {
+        struct Setter
+        {
+            AnimationPose& pose;
+            void Translation(uint32_t node, const DirectX::XMFLOAT3& v) { pose.SetTranslation(node, v); }
+            void Rotation(uint32_t node, const DirectX::XMFLOAT4& v) { pose.SetRotation(node, v); }
+            void Scale(uint32_t node, const DirectX::XMFLOAT3& v) { pose.SetScale(node, v); }
+        };
+
+        VisitBakedClip(clip, time, Setter{ outPose });
+    }
+
+    // アニメーションクリップを一定間隔のフレームに焼き込む関数
+    // report を指定するとフレーム間の時間でも元のカーブと比較して誤差を計算する
+    inline BakedAnimationClip BakeAnimationClip(
+        const AnimationClip& clip,
+        float sampleRate,
+        AnimationBakeReport* report = nullptr
+    )
+    {
+        using namespace DirectX;
+        using namespace AnimationBakeDetail;
+
+        BakedAnimationClip baked;
+        baked.sampleRate = sampleRate;
+        baked.duration = clip.duration;
+        baked.frameCount = std::max(2u, static_cast<uint32_t>(std::ceil(clip.duration * sampleRate)) + 1);
+
+        for (const auto& ch : clip.translations) baked.translationNodes.push_back(ch.nodeIndex);
+        for (const auto& ch : clip.rotations) baked.rotationNodes.push_back(ch.nodeIndex);
+        for (const auto& ch : clip.scales) baked.scaleNodes.push_back(ch.nodeIndex);
+
+        baked.frameStride = static_cast<uint32_t>(
+            clip.translations.size() * 3 + clip.rotations.size() * 4 + clip.scales.size() * 3);
+        baked.frames.resize(static_cast<size_t>(baked.frameStride) * baked.frameCount);
+
+        for (uint32_t frame = 0; frame < baked.frameCount; frame++)
+        {
+            float time = std::min(static_cast<float>(frame) / sampleRate, clip.duration);
+            float* p = baked.frames.data() + static_cast<size_t>(frame) * baked.frameStride;
+            const float* prev = (frame > 0) ? p - baked.frameStride : nullptr;
+
+            for (const auto& ch : clip.translations)
+            {
+                XMStoreFloat3(reinterpret_cast<XMFLOAT3*>(p), Evaluate(ch, time));
+                p += 3;
+                if (prev) prev += 3;
+            }
+
+            for (const auto& ch : clip.rotations)
+            {
+                XMVECTOR q = Evaluate(ch, time);
+
+                // 前のフレームと同じ半球に揃える
+                if (prev && XMVectorGetX(XMVector4Dot(q, XMLoadFloat4(reinterpret_cast<const XMFLOAT4*>(prev)))) < 0.0f)
+                {
+                    q = XMVectorNegate(q);
+                }
+
+                XMStoreFloat4(reinterpret_cast<XMFLOAT4*>(p), q);
+                p += 4;
+                if (prev) prev += 4;
+            }
+
+            for (const auto& ch : clip.scales)
+            {
+                XMStoreFloat3(reinterpret_cast<XMFLOAT3*>(p), Evaluate(ch, time));
+                p += 3;
+                if (prev) prev += 3;
+            }
+        }
+
+        if (!report)
+        {
+            return baked;
+        }
+
+        // フレームの間を細かくサンプリングして元のカーブと比較する
+        *report = {};
+
+        uint32_t maxNode = 0;
+        for (uint32_t node : baked.translationNodes) maxNode = std::max(maxNode, node);
+        for (uint32_t node : baked.rotationNodes) maxNode = std::max(maxNode, node);
+        for (uint32_t node : baked.scaleNodes) maxNode = std::max(maxNode, node);
+
+        AnimationPose pose;
+        pose.Resize(static_cast<size_t>(maxNode) + 1);
+
+        constexpr uint32_t SubSamples = 4;
+        uint32_t sampleCount = (baked.frameCount - 1) * SubSamples;
+
+        for (uint32_t s = 0; s <= sampleCount; s++)
+        {
+            float time = std::min(static_cast<float>(s) / (sampleRate * SubSamples), clip.duration);
+            SampleBakedClip(baked, time, pose);
+
+            for (const auto& ch : clip.translations)
+            {
+                XMFLOAT3 v = pose.GetTranslation(ch.nodeIndex);
+                float error = XMVectorGetX(XMVector3Length(XMVectorSubtract(XMLoadFloat3(&v), Evaluate(ch, time))));
+                report->maxTranslationError = std::max(report->maxTranslationError, error);
+            }
+
+            for (const auto& ch : clip.rotations)
+            {
+                XMFLOAT4 v = pose.GetRotation(ch.nodeIndex);
+                XMVECTOR a = XMLoadFloat4(&v);
+                XMVECTOR b = Evaluate(ch, time);
+                if (XMVectorGetX(XMVector4Dot(a, b)) < 0.0f)
+                {
+                    b = XMVectorNegate(b);
+                }
+
+                // 弦の長さから角度を求める（acos は小さな角度で精度が出ないため）
+                float chord = XMVectorGetX(XMVector4Length(XMVectorSubtract(a, b)));
+                float error = 4.0f * std::asin(std::min(chord * 0.5f, 1.0f));
+                report->maxRotationError = std::max(report->maxRotationError, error);
+            }
+
+            for (const auto& ch : clip.scales)
+            {
+                XMFLOAT3 v = pose.GetScale(ch.nodeIndex);
+                XMVECTOR d = XMVectorAbs(XMVectorSubtract(XMLoadFloat3(&v), Evaluate(ch, time)));
+                float error = std::max({ XMVectorGetX(d), XMVectorGetY(d), XMVectorGetZ(d) });
+                report->maxScaleError = std::max(report->maxScaleError, error);
+            }
+        }
+
+        return baked;
+    }
+}
@@ -0,0 +1,115 @@
+//--------------------------------------------------------------------------------------
+// File: AnimationBlendTree.cpp
+//
+// 複数のアニメーションクリップを重み付きで合成するブレンドツリー
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "pch.h"
+#include "AnimationBlendTree.h"
+
+// 指定したノードとその子孫を weight、それ以外を 0 にしたマスクを作成する関数
+Imase::BoneMask Imase::BoneMask::CreateSubtree(const std::vector<NodeInfo>& nodes, int rootNode, float weight)
+{
+    BoneMask mask;
+    mask.weights.assign(nodes.size(), 0.0f);
+
+    if (rootNode < 0 || rootNode >= static_cast<int>(nodes.size())) return mask;
+
+    // 親は子より前に並んでいるので１回の走査で子孫に伝わる
+    mask.weights[rootNode] = weight;
+    for (size_t i = rootNode + 1; i < nodes.size(); i++)
+    {
+        int parent = nodes[i].parentIndex;
+        if (parent >= rootNode && mask.weights[parent] != 0.0f)
+        {
+            mask.weights[i] = weight;
+        }
+    }
+    return mask;
+}
+
+// サンプルを追加する関数
+void Imase::BlendSpace::AddSample(int clipIndex, float x, float y)
+{
+    m_samples.push_back({ clipIndex, x, y });
+}
+
+// 各サンプルの重みを計算する関数
+void Imase::BlendSpace::ComputeWeights(float* outWeights) const
+{
+    size_t count = m_samples.size();
+    if (count == 0) return;
+
+    if (count == 1)
+    {
+        outWeights[0] = 1.0f;
+        return;
+    }
+
+    // 各サンプルから見て、他のどのサンプルよりも自分に近い度合いを重みにする
+    // （1次元では隣り合う２つのサンプルの線形補間と同じになる）
+    float total = 0.0f;
+    for (size_t i = 0; i < count; i++)
+    {
+        const Sample& si = m_samples[i];
+        float px = m_x - si.x;
+        float py = m_y - si.y;
+
+        float weight = 1.0f;
+        for (size_t j = 0; j < count && weight > 0.0f; j++)
+        {
+            if (i == j) continue;
+
+            const Sample& sj = m_samples[j];
+            float dx = sj.x - si.x;
+            float dy = sj.y - si.y;
+            float lengthSq = dx * dx + dy * dy;
+            if (lengthSq <= 0.0f) continue;
+
+            float h = 1.0f - (px * dx + py * dy) / lengthSq;
+            weight = std::min(weight, std::clamp(h, 0.0f, 1.0f));
+        }
+
+        outWeights[i] = weight;
+        total += weight;
+    }
+
+    // 合計を 1 にする（範囲外などで全て 0 になった場合は一番近いサンプル）
+    if (total > 0.0f)
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            outWeights[i] /= total;
+        }
+        return;
+    }
+
+    size_t nearest = 0;
+    float nearestDistance = std::numeric_limits<float>::max();
+    for (size_t i = 0; i < count; i++)
+    {
+        float dx = m_x - m_samples[i].x;
+        float dy = m_y - m_samples[i].y;
+        float distance = dx * dx + dy * dy;
+        if (distance < nearestDistance)
+        {
+            nearestDistance = distance;
+            nearest = i;
+        }
+        outWeights[i] = 0.0f;
+    }
+    outWeights[nearest] = 1.0f;
+}
+
+// レイヤーを追加する関数
+size_t Imase::BlendTree::AddLayer(BlendLayer::Mode mode, float weight, const BoneMask* mask)
+{
+    BlendLayer layer;
+    layer.mode = mode;
+    layer.weight = weight;
+    layer.mask = mask;
+    m_layers.push_back(std::move(layer));
+    return m_layers.size() - 1;
+}
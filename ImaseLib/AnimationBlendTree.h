@@ -0,0 +1,127 @@
+//--------------------------------------------------------------------------------------
+// File: AnimationBlendTree.h
+//
+// 複数のアニメーションクリップを重み付きで合成するブレンドツリー
+//
+// レイヤー毎にブレンドスペース（1次元、2次元のパラメーターでクリップの重みを決める）を持ち、
+// 上書きレイヤーは下のレイヤーに重ね、加算レイヤーは初期ポーズからの差分を加えます
+// 評価は Animator が行い、各クリップの値を出力ポーズに直接加算します
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include "Imdl.h"
+
+namespace Imase
+{
+    // ノード毎のブレンドの重み（上半身だけ別のアニメーションにする場合など）
+    struct BoneMask
+    {
+        std::vector<float> weights;
+
+        // 指定したノードとその子孫を weight、それ以外を 0 にしたマスクを作成する関数
+        static BoneMask CreateSubtree(const std::vector<NodeInfo>& nodes, int rootNode, float weight = 1.0f);
+    };
+
+    // パラメーターから各クリップの重みを決めるブレンドスペース
+    class BlendSpace
+    {
+    public:
+
+        // サンプル（クリップとパラメーター空間上の位置）
+        struct Sample
+        {
+            int clipIndex;
+            float x;
+            float y;
+        };
+
+    private:
+
+        // サンプル
+        std::vector<Sample> m_samples;
+
+        // パラメーター
+        float m_x = 0.0f;
+        float m_y = 0.0f;
+
+    public:
+
+        // サンプルを追加する関数（1次元の場合は y を省略する）
+        void AddSample(int clipIndex, float x, float y = 0.0f);
+
+        // パラメーターを設定する関数
+        void SetParameter(float x, float y = 0.0f) { m_x = x; m_y = y; }
+
+        // サンプルを取得する関数
+        const std::vector<Sample>& GetSamples() const { return m_samples; }
+
+        // 各サンプルの重みを計算する関数（グラディエントバンド補間、合計は 1）
+        void ComputeWeights(float* outWeights) const;
+    };
+
+    // ブレンドツリーのレイヤー
+    struct BlendLayer
+    {
+        enum class Mode
+        {
+            Override,   // 下のレイヤーを weight の割合で置き換える
+            Additive    // 初期ポーズからの差分を weight の割合で加える
+        };
+
+        Mode mode = Mode::Override;
+
+        // レイヤーの重み
+        float weight = 1.0f;
+
+        // ノード毎の重み（nullptr なら全ノード）
+        const BoneMask* mask = nullptr;
+
+        // ブレンドスペース
+        BlendSpace space;
+
+        // ループ（ON/OFF)
+        bool loop = true;
+
+        // ----- 再生状態（Animator が更新する） ----- //
+
+        // 正規化した再生位置（0～1、長さの異なるクリップの歩調を合わせる）
+        float phase = 0.0f;
+
+        // 各サンプルの重み
+        std::vector<float> sampleWeights;
+
+        // 各サンプルのチャンネル毎の前回のキー位置
+        std::vector<std::vector<uint32_t>> keyCursors;
+    };
+
+    // ブレンドツリー
+    class BlendTree
+    {
+    private:
+
+        // レイヤー（下から順に評価する）
+        std::vector<BlendLayer> m_layers;
+
+    public:
+
+        // レイヤーを追加する関数（戻り値はレイヤー番号）
+        size_t AddLayer(BlendLayer::Mode mode = BlendLayer::Mode::Override, float weight = 1.0f, const BoneMask* mask = nullptr);
+
+        // レイヤーを取得する関数
+        BlendLayer& GetLayer(size_t index) { return m_layers[index]; }
+        const BlendLayer& GetLayer(size_t index) const { return m_layers[index]; }
+
+        // 全てのレイヤーを取得する関数
+        std::vector<BlendLayer>& GetLayers() { return m_layers; }
+        const std::vector<BlendLayer>& GetLayers() const { return m_layers; }
+
+        // レイヤーのパラメーターを設定する関数
+        void SetParameter(size_t layer, float x, float y = 0.0f) { m_layers[layer].space.SetParameter(x, y); }
+
+        // レイヤーの重みを設定する関数
+        void SetLayerWeight(size_t layer, float weight) { m_layers[layer].weight = weight; }
+    };
+}
@@ -0,0 +1,252 @@
+//--------------------------------------------------------------------------------------
+// File: AnimationPose.h
+//
+// ポーズ（各ノードの移動、回転、スケール）を SoA 形式で保持するクラスと
+// 4ノードずつまとめて計算する関数
+//
+// 4ノード分の各成分を XMVECTOR 1つに並べて持つので、補間や行列の作成を
+// DirectXMath の SIMD 命令で4ノード同時に計算できます
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include <vector>
+#include <DirectXMath.h>
+#include "RotationMath.h"
+
+namespace Imase
+{
+    // 4ノード分の移動、回転、スケール
+    struct alignas(16) PoseBlock
+    {
+        static constexpr size_t Width = 4;
+
+        float tx[Width], ty[Width], tz[Width];
+        float rx[Width], ry[Width], rz[Width], rw[Width];
+        float sx[Width], sy[Width], sz[Width];
+    };
+
+    class AnimationPose
+    {
+    private:
+
+        // ノード数
+        size_t m_nodeCount = 0;
+
+        // 4ノード毎のブロック（端数は単位姿勢で埋める）
+        std::vector<PoseBlock> m_blocks;
+
+    public:
+
+        // ノード数を設定する関数（全ノードを単位姿勢で初期化する）
+        void Resize(size_t nodeCount)
+        {
+            m_nodeCount = nodeCount;
+            m_blocks.resize((nodeCount + PoseBlock::Width - 1) / PoseBlock::Width);
+
+            for (auto& block : m_blocks)
+            {
+                for (size_t lane = 0; lane < PoseBlock::Width; lane++)
+                {
+                    block.tx[lane] = block.ty[lane] = block.tz[lane] = 0.0f;
+                    block.rx[lane] = block.ry[lane] = block.rz[lane] = 0.0f;
+                    block.rw[lane] = 1.0f;
+                    block.sx[lane] = block.sy[lane] = block.sz[lane] = 1.0f;
+                }
+            }
+        }
+
+        // ノード数を取得する関数
+        size_t GetNodeCount() const { return m_nodeCount; }
+
+        // ブロックを取得する関数
+        std::vector<PoseBlock>& GetBlocks() { return m_blocks; }
+        const std::vector<PoseBlock>& GetBlocks() const { return m_blocks; }
+
+        // 移動
+        void SetTranslation(size_t node, const DirectX::XMFLOAT3& t)
+        {
+            PoseBlock& b = m_blocks[node / PoseBlock::Width];
+            size_t lane = node % PoseBlock::Width;
+            b.tx[lane] = t.x;
+            b.ty[lane] = t.y;
+            b.tz[lane] = t.z;
+        }
+
+        DirectX::XMFLOAT3 GetTranslation(size_t node) const
+        {
+            const PoseBlock& b = m_blocks[node / PoseBlock::Width];
+            size_t lane = node % PoseBlock::Width;
+            return DirectX::XMFLOAT3(b.tx[lane], b.ty[lane], b.tz[lane]);
+        }
+
+        // 回転
+        void SetRotation(size_t node, const DirectX::XMFLOAT4& r)
+        {
+            PoseBlock& b = m_blocks[node / PoseBlock::Width];
+            size_t lane = node % PoseBlock::Width;
+            b.rx[lane] = r.x;
+            b.ry[lane] = r.y;
+            b.rz[lane] = r.z;
+            b.rw[lane] = r.w;
+        }
+
+        DirectX::XMFLOAT4 GetRotation(size_t node) const
+        {
+            const PoseBlock& b = m_blocks[node / PoseBlock::Width];
+            size_t lane = node % PoseBlock::Width;
+            return DirectX::XMFLOAT4(b.rx[lane], b.ry[lane], b.rz[lane], b.rw[lane]);
+        }
+
+        // スケール
+        void SetScale(size_t node, const DirectX::XMFLOAT3& s)
+        {
+            PoseBlock& b = m_blocks[node / PoseBlock::Width];
+            size_t lane = node % PoseBlock::Width;
+            b.sx[lane] = s.x;
+            b.sy[lane] = s.y;
+            b.sz[lane] = s.z;
+        }
+
+        DirectX::XMFLOAT3 GetScale(size_t node) const
+        {
+            const PoseBlock& b = m_blocks[node / PoseBlock::Width];
+            size_t lane = node % PoseBlock::Width;
+            return DirectX::XMFLOAT3(b.sx[lane], b.sy[lane], b.sz[lane]);
+        }
+    };
+
+    namespace PoseKernel
+    {
+        inline DirectX::XMVECTOR Load(const float* p)
+        {
+            return DirectX::XMLoadFloat4A(reinterpret_cast<const DirectX::XMFLOAT4A*>(p));
+        }
+
+        inline void Store(float* p, DirectX::FXMVECTOR v)
+        {
+            DirectX::XMStoreFloat4A(reinterpret_cast<DirectX::XMFLOAT4A*>(p), v);
+        }
+    }
+
+    // 2つのポーズをブレンドする関数（移動とスケールは線形補間、回転は mode の方式で補間）
+    // out は a または b と同じでもよい
+    inline void BlendPoses(const AnimationPose& a, const AnimationPose& b, float weight, AnimationPose& out, RotationInterpolation mode = RotationInterpolation::Slerp)
+    {
+        using namespace DirectX;
+        using namespace PoseKernel;
+
+        const auto& blocksA = a.GetBlocks();
+        const auto& blocksB = b.GetBlocks();
+        auto& blocksOut = out.GetBlocks();
+
+        XMVECTOR w = XMVectorReplicate(weight);
+
+        for (size_t i = 0; i < blocksA.size(); i++)
+        {
+            const PoseBlock& pa = blocksA[i];
+            const PoseBlock& pb = blocksB[i];
+            PoseBlock& po = blocksOut[i];
+
+            // 移動、スケール
+            Store(po.tx, XMVectorLerpV(Load(pa.tx), Load(pb.tx), w));
+            Store(po.ty, XMVectorLerpV(Load(pa.ty), Load(pb.ty), w));
+            Store(po.tz, XMVectorLerpV(Load(pa.tz), Load(pb.tz), w));
+            Store(po.sx, XMVectorLerpV(Load(pa.sx), Load(pb.sx), w));
+            Store(po.sy, XMVectorLerpV(Load(pa.sy), Load(pb.sy), w));
+            Store(po.sz, XMVectorLerpV(Load(pa.sz), Load(pb.sz), w));
+
+            // 回転（最短経路になるよう内積が負のものは反転する）
+            XMVECTOR ax = Load(pa.rx), ay = Load(pa.ry), az = Load(pa.rz), aw = Load(pa.rw);
+            XMVECTOR bx = Load(pb.rx), by = Load(pb.ry), bz = Load(pb.rz), bw = Load(pb.rw);
+
+            XMVECTOR dot = XMVectorMultiplyAdd(ax, bx, XMVectorMultiplyAdd(ay, by, XMVectorMultiplyAdd(az, bz, XMVectorMultiply(aw, bw))));
+            XMVECTOR sign = XMVectorSelect(XMVectorReplicate(1.0f), XMVectorReplicate(-1.0f), XMVectorLess(dot, XMVectorZero()));
+
+            XMVECTOR wa, wb;
+            GetRotationBlendWeights(mode, XMVectorAbs(dot), w, &wa, &wb);
+            wb = XMVectorMultiply(wb, sign);
+
+            XMVECTOR rx = XMVectorMultiplyAdd(bx, wb, XMVectorMultiply(ax, wa));
+            XMVECTOR ry = XMVectorMultiplyAdd(by, wb, XMVectorMultiply(ay, wa));
+            XMVECTOR rz = XMVectorMultiplyAdd(bz, wb, XMVectorMultiply(az, wa));
+            XMVECTOR rw = XMVectorMultiplyAdd(bw, wb, XMVectorMultiply(aw, wa));
+
+            XMVECTOR lengthSq = XMVectorMultiplyAdd(rx, rx, XMVectorMultiplyAdd(ry, ry, XMVectorMultiplyAdd(rz, rz, XMVectorMultiply(rw, rw))));
+            XMVECTOR invLength = XMVectorReciprocalSqrt(lengthSq);
+
+            Store(po.rx, XMVectorMultiply(rx, invLength));
+            Store(po.ry, XMVectorMultiply(ry, invLength));
+            Store(po.rz, XMVectorMultiply(rz, invLength));
+            Store(po.rw, XMVectorMultiply(rw, invLength));
+        }
+    }
+
+    // 1ブロック（4ノード）のローカル行列（スケール * 回転 * 移動）を作成する関数
+    inline void BuildLocalMatrixBlock(const AnimationPose& pose, size_t blockIndex, DirectX::XMFLOAT4X4* outMatrices)
+    {
+        using namespace DirectX;
+        using namespace PoseKernel;
+
+        XMVECTOR one = XMVectorReplicate(1.0f);
+        XMVECTOR two = XMVectorReplicate(2.0f);
+        XMVECTOR zero = XMVectorZero();
+
+        const PoseBlock& p = pose.GetBlocks()[blockIndex];
+
+        XMVECTOR x = Load(p.rx), y = Load(p.ry), z = Load(p.rz), w = Load(p.rw);
+        XMVECTOR sx = Load(p.sx), sy = Load(p.sy), sz = Load(p.sz);
+
+        XMVECTOR xx = XMVectorMultiply(x, x), yy = XMVectorMultiply(y, y), zz = XMVectorMultiply(z, z);
+        XMVECTOR xy = XMVectorMultiply(x, y), xz = XMVectorMultiply(x, z), yz = XMVectorMultiply(y, z);
+        XMVECTOR wx = XMVectorMultiply(w, x), wy = XMVectorMultiply(w, y), wz = XMVectorMultiply(w, z);
+
+        // XMMatrixRotationQuaternion と同じ並び（行ベクトル）にスケールを掛ける
+        XMVECTOR m00 = XMVectorMultiply(sx, XMVectorNegativeMultiplySubtract(two, XMVectorAdd(yy, zz), one));
+        XMVECTOR m01 = XMVectorMultiply(sx, XMVectorMultiply(two, XMVectorAdd(xy, wz)));
+        XMVECTOR m02 = XMVectorMultiply(sx, XMVectorMultiply(two, XMVectorSubtract(xz, wy)));
+
+        XMVECTOR m10 = XMVectorMultiply(sy, XMVectorMultiply(two, XMVectorSubtract(xy, wz)));
+        XMVECTOR m11 = XMVectorMultiply(sy, XMVectorNegativeMultiplySubtract(two, XMVectorAdd(xx, zz), one));
+        XMVECTOR m12 = XMVectorMultiply(sy, XMVectorMultiply(two, XMVectorAdd(yz, wx)));
+
+        XMVECTOR m20 = XMVectorMultiply(sz, XMVectorMultiply(two, XMVectorAdd(xz, wy)));
+        XMVECTOR m21 = XMVectorMultiply(sz, XMVectorMultiply(two, XMVectorSubtract(yz, wx)));
+        XMVECTOR m22 = XMVectorMultiply(sz, XMVectorNegativeMultiplySubtract(two, XMVectorAdd(xx, yy), one));
+
+        // 転置して4ノード分の各行を取り出す
+        XMMATRIX row0 = XMMatrixTranspose(XMMATRIX(m00, m01, m02, zero));
+        XMMATRIX row1 = XMMatrixTranspose(XMMATRIX(m10, m11, m12, zero));
+        XMMATRIX row2 = XMMatrixTranspose(XMMATRIX(m20, m21, m22, zero));
+        XMMATRIX row3 = XMMatrixTranspose(XMMATRIX(Load(p.tx), Load(p.ty), Load(p.tz), one));
+
+        size_t base = blockIndex * PoseBlock::Width;
+        size_t count = std::min(PoseBlock::Width, pose.GetNodeCount() - base);
+
+        for (size_t lane = 0; lane < count; lane++)
+        {
+            XMMATRIX m(row0.r[lane], row1.r[lane], row2.r[lane], row3.r[lane]);
+            XMStoreFloat4x4(&outMatrices[base + lane], m);
+        }
+    }
+
+    // ポーズから各ノードのローカル行列（スケール * 回転 * 移動）を作成する関数
+    inline void BuildLocalMatrices(const AnimationPose& pose, DirectX::XMFLOAT4X4* outMatrices)
+    {
+        for (size_t i = 0; i < pose.GetBlocks().size(); i++)
+        {
+            BuildLocalMatrixBlock(pose, i, outMatrices);
+        }
+    }
+
+    // 指定したブロックだけローカル行列を作成する関数（他のノードの行列はそのまま）
+    inline void BuildLocalMatrices(const AnimationPose& pose, const std::vector<uint32_t>& blockIndices, DirectX::XMFLOAT4X4* outMatrices)
+    {
+        for (uint32_t i : blockIndices)
+        {
+            BuildLocalMatrixBlock(pose, i, outMatrices);
+        }
+    }
+}
@@ -0,0 +1,139 @@
+//--------------------------------------------------------------------------------------
+// File: AnimationProfile.cpp
+//
+// アニメーションの処理時間を段階毎に計測するクラス（性能の比較用）
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "pch.h"
+#include "AnimationProfile.h"
+
+#include <sstream>
+
+// コンストラクタ
+Imase::AnimationProfile::AnimationProfile()
+    : m_channelSamples{ 0 }
+    , m_keyCursorJumps{ 0 }
+    , m_updateCount{ 0 }
+    , m_wallNanoseconds{ 0 }
+    , m_instanceCount{ 0 }
+    , m_threadCount{ 0 }
+{
+}
+
+// 計測結果をクリアする関数
+void Imase::AnimationProfile::Reset()
+{
+    for (auto& stage : m_stages)
+    {
+        stage.calls = 0;
+        stage.nodes = 0;
+        stage.nanoseconds = 0;
+    }
+    m_channelSamples = 0;
+    m_keyCursorJumps = 0;
+    m_updateCount = 0;
+    m_wallNanoseconds = 0;
+    m_instanceCount = 0;
+    m_threadCount = 0;
+}
+
+// 段階の時間を加算する関数
+void Imase::AnimationProfile::AddStage(Stage stage, uint64_t nodes, uint64_t nanoseconds)
+{
+    StageCounter& counter = m_stages[static_cast<size_t>(stage)];
+    counter.calls.fetch_add(1, std::memory_order_relaxed);
+    counter.nodes.fetch_add(nodes, std::memory_order_relaxed);
+    counter.nanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+}
+
+// サンプリングの回数を加算する関数
+void Imase::AnimationProfile::AddSamples(uint64_t channelSamples, uint64_t keyCursorJumps)
+{
+    m_channelSamples.fetch_add(channelSamples, std::memory_order_relaxed);
+    m_keyCursorJumps.fetch_add(keyCursorJumps, std::memory_order_relaxed);
+}
+
+// AnimationSystem の更新を記録する関数
+void Imase::AnimationProfile::AddUpdate(uint32_t instanceCount, uint32_t threadCount, uint64_t wallNanoseconds)
+{
+    m_updateCount.fetch_add(1, std::memory_order_relaxed);
+    m_wallNanoseconds.fetch_add(wallNanoseconds, std::memory_order_relaxed);
+    m_instanceCount.store(instanceCount, std::memory_order_relaxed);
+    m_threadCount.store(threadCount, std::memory_order_relaxed);
+}
+
+// 段階毎の計測結果を取得する関数
+Imase::AnimationProfile::StageStats Imase::AnimationProfile::GetStageStats(Stage stage) const
+{
+    const StageCounter& counter = m_stages[static_cast<size_t>(stage)];
+
+    StageStats stats;
+    stats.calls = counter.calls.load();
+    stats.nodes = counter.nodes.load();
+    stats.nanoseconds = counter.nanoseconds.load();
+    return stats;
+}
+
+// 計測結果をJSON形式の文字列にする関数
+std::string Imase::AnimationProfile::FormatJson(const std::string& label) const
+{
+    static const char* stageNames[] = { "sample", "blend", "local_matrices", "world_matrices", "skin_palette" };
+    static_assert(std::size(stageNames) == static_cast<size_t>(Stage::Count));
+
+    // ラベルは記号と制御文字をエスケープする
+    std::string name;
+    for (char c : label)
+    {
+        if (c == '\\' || c == '"')
+        {
+            name += '\\';
+            name += c;
+        }
+        else if (static_cast<unsigned char>(c) < 0x20)
+        {
+            char buf[8];
+            snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(c));
+            name += buf;
+        }
+        else
+        {
+            name += c;
+        }
+    }
+
+    uint64_t updateCount = m_updateCount.load();
+    uint64_t wallNanoseconds = m_wallNanoseconds.load();
+    uint64_t channelSamples = m_channelSamples.load();
+    uint64_t keyCursorJumps = m_keyCursorJumps.load();
+
+    std::ostringstream json;
+    json << "{\"label\":\"" << name << "\""
+        << ",\"instances\":" << m_instanceCount.load()
+        << ",\"threads\":" << m_threadCount.load()
+        << ",\"updates\":" << updateCount
+        << ",\"wall_ms_per_update\":" << (updateCount ? wallNanoseconds / 1.0e6 / updateCount : 0.0)
+        << ",\"channel_samples\":" << channelSamples
+        << ",\"key_cursor_jump_rate\":" << (channelSamples ? static_cast<double>(keyCursorJumps) / channelSamples : 0.0)
+        << ",\"stages\":{";
+
+    for (size_t i = 0; i < static_cast<size_t>(Stage::Count); i++)
+    {
+        StageStats stats = GetStageStats(static_cast<Stage>(i));
+
+        // 実時間あたりに処理したノード数（AnimationSystem で計測した場合のみ）
+        double nodesPerSecond = wallNanoseconds ? stats.nodes * 1.0e9 / wallNanoseconds : 0.0;
+
+        json << (i ? "," : "")
+            << "\"" << stageNames[i] << "\":{"
+            << "\"calls\":" << stats.calls
+            << ",\"nodes\":" << stats.nodes
+            << ",\"ms\":" << stats.nanoseconds / 1.0e6
+            << ",\"ns_per_node\":" << stats.GetNanosecondsPerNode()
+            << ",\"nodes_per_s\":" << nodesPerSecond << "}";
+    }
+    json << "}}";
+
+    return json.str();
+}
@@ -0,0 +1,132 @@
+//--------------------------------------------------------------------------------------
+// File: AnimationProfile.h
+//
+// アニメーションの処理時間を段階毎に計測するクラス（性能の比較用）
+//
+// Animator、AnimationSystem、SkinPalette に設定すると、サンプリング、補間、ローカル行列、
+// ワールド行列、スキン行列の各段階の時間と処理したノード数を集計します
+// 並列に更新しても集計できるように、加算はアトミックに行います
+// 設定していない場合は計測しないので、通常の実行には影響しません
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include <atomic>
+#include <chrono>
+
+namespace Imase
+{
+    class AnimationProfile
+    {
+    public:
+
+        // 計測する段階
+        enum class Stage : uint32_t
+        {
+            Sample,         // クリップのサンプリング（ブレンド、ブレンドツリーの加算を含む）
+            Blend,          // 前回の姿勢からの補間（BlendPoses）
+            LocalMatrices,  // ローカル行列の作成
+            WorldMatrices,  // ワールド行列の作成
+            SkinPalette,    // スキン行列の作成
+
+            Count
+        };
+
+        // 段階毎の計測結果
+        struct StageStats
+        {
+            uint64_t calls = 0;         // 呼び出し回数
+            uint64_t nodes = 0;         // 処理したノード（ボーン）数
+            uint64_t nanoseconds = 0;   // 時間の合計（全スレッド分）
+
+            // １ノードあたりの時間（ナノ秒）
+            double GetNanosecondsPerNode() const { return nodes ? static_cast<double>(nanoseconds) / nodes : 0.0; }
+        };
+
+        // 指定した段階の時間をスコープの終わりで加算するクラス（profile が nullptr なら何もしない）
+        class ScopedTimer
+        {
+            AnimationProfile* m_profile;
+            Stage m_stage;
+            uint64_t m_nodes;
+            std::chrono::steady_clock::time_point m_start;
+
+        public:
+
+            ScopedTimer(AnimationProfile* profile, Stage stage, size_t nodes)
+                : m_profile{ profile }
+                , m_stage{ stage }
+                , m_nodes{ nodes }
+            {
+                if (m_profile) m_start = std::chrono::steady_clock::now();
+            }
+
+            ~ScopedTimer()
+            {
+                if (!m_profile) return;
+                auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_start);
+                m_profile->AddStage(m_stage, m_nodes, static_cast<uint64_t>(elapsed.count()));
+            }
+
+            ScopedTimer(const ScopedTimer&) = delete;
+            ScopedTimer& operator=(const ScopedTimer&) = delete;
+        };
+
+    private:
+
+        // 段階毎の集計
+        struct StageCounter
+        {
+            std::atomic<uint64_t> calls{ 0 };
+            std::atomic<uint64_t> nodes{ 0 };
+            std::atomic<uint64_t> nanoseconds{ 0 };
+        };
+        StageCounter m_stages[static_cast<size_t>(Stage::Count)];
+
+        // チャンネルをサンプリングした回数
+        std::atomic<uint64_t> m_channelSamples;
+
+        // 前回のキー位置から次の区間より先へ飛んだ、または戻った回数（探索が必要になった回数）
+        std::atomic<uint64_t> m_keyCursorJumps;
+
+        // AnimationSystem の更新回数、経過時間（実時間）、アニメーター数、スレッド数
+        std::atomic<uint64_t> m_updateCount;
+        std::atomic<uint64_t> m_wallNanoseconds;
+        std::atomic<uint32_t> m_instanceCount;
+        std::atomic<uint32_t> m_threadCount;
+
+    public:
+
+        // コンストラクタ
+        AnimationProfile();
+
+        AnimationProfile(const AnimationProfile&) = delete;
+        AnimationProfile& operator=(const AnimationProfile&) = delete;
+
+        // 計測結果をクリアする関数
+        void Reset();
+
+        // 段階の時間を加算する関数
+        void AddStage(Stage stage, uint64_t nodes, uint64_t nanoseconds);
+
+        // サンプリングの回数を加算する関数
+        void AddSamples(uint64_t channelSamples, uint64_t keyCursorJumps);
+
+        // AnimationSystem の更新を記録する関数
+        void AddUpdate(uint32_t instanceCount, uint32_t threadCount, uint64_t wallNanoseconds);
+
+        // 段階毎の計測結果を取得する関数
+        StageStats GetStageStats(Stage stage) const;
+
+        // チャンネルをサンプリングした回数を取得する関数
+        uint64_t GetChannelSampleCount() const { return m_channelSamples.load(); }
+
+        // キー位置が飛んだ回数を取得する関数
+        uint64_t GetKeyCursorJumpCount() const { return m_keyCursorJumps.load(); }
+
+        // 計測結果をJSON形式の文字列にする関数（label は比較する条件の名前）
+        std::string FormatJson(const std::string& label) const;
+    };
+}
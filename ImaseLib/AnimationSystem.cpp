@@ -0,0 +1,366 @@
+//--------------------------------------------------------------------------------------
+// File: AnimationSystem.cpp
+//
+// 多数のアニメーターをまとめて並列に更新するクラス
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "pch.h"
+#include "AnimationSystem.h"
+
+#include <chrono>
+
+using namespace DirectX;
+
+namespace
+{
+    // 更新にかかった時間の移動平均の係数
+    constexpr float CostSmoothing = 0.1f;
+
+    // 止めていたアニメーターの優先度（補間せずにすぐ更新する）
+    constexpr float ResumePriority = 1.0e6f;
+}
+
+// コンストラクタ
+Imase::AnimationSystem::AnimationSystem(JobSystem* jobSystem)
+    : m_timeBudget{ 0.0f }
+    , m_lodLevels{ LodLevel{} }
+    , m_stats{}
+    , m_poseCache{ nullptr }
+    , m_profile{ nullptr }
+    , m_rotationInterpolation{ RotationInterpolation::Slerp }
+    , m_jobSystem{ jobSystem ? *jobSystem : JobSystem::GetInstance() }
+{
+}
+
+// アニメーターを作成する関数
+uint32_t Imase::AnimationSystem::CreateAnimator(const Imase::ModelAnimationData& model)
+{
+    uint32_t id = static_cast<uint32_t>(m_instances.size());
+
+    Instance instance;
+    instance.animator = std::make_unique<Animator>(model);
+    instance.animator->SetPoseCache(m_poseCache);
+    instance.animator->SetProfile(m_profile);
+    instance.animator->SetRotationInterpolation(m_rotationInterpolation);
+    instance.offset = m_worldMatrices.size();
+    auto [it, inserted] = m_modelIndices.try_emplace(&model, static_cast<uint32_t>(m_modelIndices.size()));
+    instance.modelIndex = it->second;
+    m_instances.push_back(std::move(instance));
+
+    // 初めてのモデルは各ノードの親子の深さを調べておく（親は子より前に並んでいる）
+    if (inserted)
+    {
+        const auto& nodes = model.GetNodes();
+
+        ModelInfo info;
+        info.nodeDepths.resize(nodes.size());
+        for (size_t i = 0; i < nodes.size(); i++)
+        {
+            int parent = nodes[i].parentIndex;
+            info.nodeDepths[i] = (parent >= 0) ? info.nodeDepths[parent] + 1 : 0;
+        }
+        BuildLodNodeMasks(info);
+        m_models.push_back(std::move(info));
+    }
+
+    // 追加した分は単位行列で初期化
+    XMFLOAT4X4 identity;
+    XMStoreFloat4x4(&identity, XMMatrixIdentity());
+    const XMFLOAT4X4* oldData = m_worldMatrices.data();
+    m_worldMatrices.resize(m_worldMatrices.size() + model.GetNodes().size(), identity);
+
+    // 配列が再確保された場合は全てのアニメーターの出力先を設定し直す
+    if (m_worldMatrices.data() != oldData)
+    {
+        BindWorldMatrixBuffers();
+    }
+    else
+    {
+        m_instances.back().animator->SetWorldMatrixBuffer(m_worldMatrices.data() + m_instances.back().offset);
+    }
+
+    return id;
+}
+
+// 全てのアニメーターを削除する関数
+void Imase::AnimationSystem::Clear()
+{
+    m_instances.clear();
+    m_worldMatrices.clear();
+    m_modelIndices.clear();
+    m_models.clear();
+    m_order.clear();
+    m_dueInstances.clear();
+}
+
+// 全てのアニメーターを更新する関数
+void Imase::AnimationSystem::Update(float elapsedTime)
+{
+    if (m_instances.empty()) return;
+
+    auto updateStart = std::chrono::steady_clock::now();
+
+    // 前のフレームの姿勢は使えない
+    if (m_poseCache)
+    {
+        m_poseCache->BeginFrame();
+    }
+
+    // LOD と予算から、姿勢を更新するものと補間だけ行うものを決める
+    ScheduleWork(elapsedTime);
+
+    // バッチに分けて並列に更新する（早く終わったワーカーが残りのバッチを盗むので負荷が偏らない）
+    m_jobSystem.ParallelFor(static_cast<uint32_t>(m_order.size()), BatchSize, [this](uint32_t begin, uint32_t end)
+        {
+            for (uint32_t i = begin; i < end; i++)
+            {
+                WorkItem& item = m_order[i];
+                Instance& instance = m_instances[item.id];
+                Animator& animator = *instance.animator;
+
+                if (item.updatePose)
+                {
+                    const auto& mask = m_models[instance.modelIndex].lodNodeMasks[instance.lod];
+                    animator.SetNodeMask(mask.empty() ? nullptr : mask.data());
+
+                    auto start = std::chrono::steady_clock::now();
+                    bool updated = animator.UpdatePose(instance.pendingTime, item.keepPrevious);
+                    item.milliseconds = std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start).count();
+
+                    instance.pendingTime = 0.0f;
+                    instance.cost = (instance.cost > 0.0f) ? instance.cost + (item.milliseconds - instance.cost) * CostSmoothing : item.milliseconds;
+
+                    if (!updated) continue;
+                }
+
+                animator.BuildMatrices(item.alpha);
+            }
+        }
+    );
+
+    // 実際にかかった時間
+    for (const auto& item : m_order)
+    {
+        m_stats.updateMilliseconds += item.milliseconds;
+    }
+
+    // 呼び出したスレッドも処理するのでワーカー数 + 1
+    if (m_profile)
+    {
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - updateStart);
+        m_profile->AddUpdate(GetAnimatorCount(), m_jobSystem.GetWorkerCount() + 1, static_cast<uint64_t>(elapsed.count()));
+    }
+}
+
+// 姿勢を共有するキャッシュを設定する関数
+void Imase::AnimationSystem::SetPoseCache(PoseCache* cache)
+{
+    m_poseCache = cache;
+
+    for (auto& instance : m_instances)
+    {
+        instance.animator->SetPoseCache(cache);
+    }
+}
+
+// 処理時間を計測する関数
+void Imase::AnimationSystem::SetProfile(AnimationProfile* profile)
+{
+    m_profile = profile;
+
+    for (auto& instance : m_instances)
+    {
+        instance.animator->SetProfile(profile);
+    }
+}
+
+// 全てのアニメーターの回転の補間方式を設定する関数
+void Imase::AnimationSystem::SetRotationInterpolation(RotationInterpolation mode)
+{
+    m_rotationInterpolation = mode;
+
+    for (auto& instance : m_instances)
+    {
+        instance.animator->SetRotationInterpolation(mode);
+    }
+}
+
+// LOD を設定する関数
+void Imase::AnimationSystem::SetLodLevels(const std::vector<LodLevel>& levels)
+{
+    m_lodLevels = levels.empty() ? std::vector<LodLevel>{ LodLevel{} } : levels;
+    std::sort(m_lodLevels.begin(), m_lodLevels.end(), [](const LodLevel& a, const LodLevel& b) { return a.distance < b.distance; });
+
+    for (auto& info : m_models)
+    {
+        BuildLodNodeMasks(info);
+    }
+
+    for (auto& instance : m_instances)
+    {
+        instance.lod = SelectLod(instance.distance);
+    }
+}
+
+// カメラからの距離と画面内かどうかを設定する関数
+void Imase::AnimationSystem::SetViewState(uint32_t id, float distance, bool visible)
+{
+    Instance& instance = m_instances[id];
+    instance.distance = distance;
+    instance.visible = visible;
+}
+
+// 指定したアニメーターのワールド行列を取得する関数
+std::span<const DirectX::XMFLOAT4X4> Imase::AnimationSystem::GetWorldMatrices(uint32_t id) const
+{
+    const Instance& instance = m_instances[id];
+    return { m_worldMatrices.data() + instance.offset, instance.animator->GetModel().GetNodes().size() };
+}
+
+// 並べ替えのキーを作成する関数
+uint64_t Imase::AnimationSystem::MakeSortKey(uint32_t id) const
+{
+    const Animator& animator = *m_instances[id].animator;
+
+    // モデル、ブレンド元のクリップ、ブレンド先のクリップの順に並べる（クリップ無しの -1 は 0 になる）
+    uint64_t model = m_instances[id].modelIndex;
+    uint64_t clipA = static_cast<uint16_t>(animator.GetCurrentAnimationIndex() + 1);
+    uint64_t clipB = static_cast<uint16_t>(animator.GetNextAnimationIndex() + 1);
+
+    return (model << 32) | (clipA << 16) | clipB;
+}
+
+// ワールド行列の出力先を設定し直す関数
+void Imase::AnimationSystem::BindWorldMatrixBuffers()
+{
+    for (auto& instance : m_instances)
+    {
+        instance.animator->SetWorldMatrixBuffer(m_worldMatrices.data() + instance.offset);
+    }
+}
+
+// LOD 毎のサンプリングするノードを作成する関数
+void Imase::AnimationSystem::BuildLodNodeMasks(ModelInfo& info) const
+{
+    uint32_t maxDepth = 0;
+    for (uint32_t depth : info.nodeDepths)
+    {
+        maxDepth = std::max(maxDepth, depth);
+    }
+
+    info.lodNodeMasks.resize(m_lodLevels.size());
+    for (size_t lod = 0; lod < m_lodLevels.size(); lod++)
+    {
+        auto& mask = info.lodNodeMasks[lod];
+        uint32_t limit = m_lodLevels[lod].maxNodeDepth;
+
+        // 全てのノードをサンプリングする場合は空にしておく
+        if (limit >= maxDepth)
+        {
+            mask.clear();
+            continue;
+        }
+
+        mask.resize(info.nodeDepths.size());
+        for (size_t i = 0; i < info.nodeDepths.size(); i++)
+        {
+            mask[i] = (info.nodeDepths[i] <= limit) ? 1 : 0;
+        }
+    }
+}
+
+// 距離から LOD を選ぶ関数
+uint32_t Imase::AnimationSystem::SelectLod(float distance) const
+{
+    uint32_t lod = 0;
+    for (uint32_t i = 1; i < m_lodLevels.size(); i++)
+    {
+        if (distance < m_lodLevels[i].distance) break;
+        lod = i;
+    }
+    return lod;
+}
+
+// 更新する内容を決める関数
+void Imase::AnimationSystem::ScheduleWork(float elapsedTime)
+{
+    m_order.clear();
+    m_dueInstances.clear();
+    m_stats = Stats{};
+
+    for (uint32_t id = 0; id < m_instances.size(); id++)
+    {
+        Instance& instance = m_instances[id];
+
+        // 止めている間も経過時間は貯めておき、見えた時にまとめて進める
+        instance.pendingTime += elapsedTime;
+
+        // 画面外は止める
+        if (!instance.visible)
+        {
+            instance.frozen = true;
+            m_stats.frozenCount++;
+            continue;
+        }
+
+        instance.lod = SelectLod(instance.distance);
+        uint32_t interval = std::max(m_lodLevels[instance.lod].updateInterval, 1u);
+
+        instance.framesSinceUpdate++;
+
+        // 更新の時期が来ている（遅れているほど優先する）
+        if (instance.frozen || instance.framesSinceUpdate >= interval)
+        {
+            float priority = instance.frozen ? ResumePriority : static_cast<float>(instance.framesSinceUpdate) / static_cast<float>(interval);
+            m_dueInstances.emplace_back(priority, id);
+            continue;
+        }
+
+        // 更新の間は前回と今回の姿勢を補間する
+        float alpha = std::min(static_cast<float>(instance.framesSinceUpdate + 1) / static_cast<float>(interval), 1.0f);
+        if (alpha != instance.alpha)
+        {
+            instance.alpha = alpha;
+            m_order.push_back({ MakeSortKey(id), id, alpha, false, false, 0.0f });
+            m_stats.interpolatedCount++;
+        }
+    }
+
+    // 優先度の高い順に予算の範囲で更新する（少なくとも１つは更新する）
+    std::sort(m_dueInstances.begin(), m_dueInstances.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+
+    float spent = 0.0f;
+    for (const auto& [priority, id] : m_dueInstances)
+    {
+        Instance& instance = m_instances[id];
+
+        if (m_timeBudget > 0.0f && m_stats.updatedCount > 0 && spent + instance.cost > m_timeBudget)
+        {
+            // 次のフレームに回す（それまでは最新の姿勢のまま）
+            if (instance.alpha != 1.0f)
+            {
+                instance.alpha = 1.0f;
+                m_order.push_back({ MakeSortKey(id), id, 1.0f, false, false, 0.0f });
+            }
+            m_stats.deferredCount++;
+            continue;
+        }
+        spent += instance.cost;
+
+        // 止めていた場合は前回の姿勢から補間せずにすぐ切り替える
+        uint32_t interval = std::max(m_lodLevels[instance.lod].updateInterval, 1u);
+        bool keepPrevious = (interval > 1) && !instance.frozen;
+
+        instance.alpha = keepPrevious ? 1.0f / static_cast<float>(interval) : 1.0f;
+        instance.framesSinceUpdate = 0;
+        instance.frozen = false;
+
+        m_order.push_back({ MakeSortKey(id), id, instance.alpha, true, keepPrevious, 0.0f });
+        m_stats.updatedCount++;
+    }
+
+    // モデルとクリップ毎に並べ替える
+    std::sort(m_order.begin(), m_order.end());
+}
@@ -0,0 +1,240 @@
+//--------------------------------------------------------------------------------------
+// File: AnimationSystem.h
+//
+// 多数のアニメーターをまとめて並列に更新するクラス
+//
+// 更新時はモデルと再生中のクリップ毎に並べ替えてからバッチに分けるので、
+// 同じクリップのデータが続けて参照されます
+// 全てのアニメーターのワールド行列は１つの連続した配列に出力されます
+//
+// カメラからの距離で LOD を切り替え、遠いアニメーターは更新間隔を空けて間を補間し、
+// 細かいノード（指など）のサンプリングを省きます。画面外のアニメーターは止めておき、
+// 見えた時に止めていた分の時間を進めます。時間の予算を設定すると、予算を超える分の更新は
+// 次のフレーム以降に回されるので、アニメーター数が増えても更新にかかる時間は一定に収まります
+// 姿勢のキャッシュを設定すると、同じクリップを同じ時間で再生しているアニメーター同士で姿勢を共有します
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include "Animator.h"
+#include "JobSystem.h"
+
+#include <unordered_map>
+
+namespace Imase
+{
+    class AnimationSystem
+    {
+    public:
+
+        // 1バッチで更新するアニメーターの数
+        static constexpr uint32_t BatchSize = 32;
+
+        // LOD の設定
+        struct LodLevel
+        {
+            // この距離以上で使う
+            float distance = 0.0f;
+
+            // 何フレーム毎に姿勢を更新するか（間のフレームは補間する）
+            uint32_t updateInterval = 1;
+
+            // サンプリングするノードの親子の深さ（ルートが 0、これより深いノードは初期ポーズのまま）
+            uint32_t maxNodeDepth = UINT32_MAX;
+        };
+
+        // 統計情報（前回の更新）
+        struct Stats
+        {
+            uint32_t updatedCount = 0;      // 姿勢を更新した数
+            uint32_t interpolatedCount = 0; // 補間だけ行った数
+            uint32_t deferredCount = 0;     // 予算を超えたので次のフレームに回した数
+            uint32_t frozenCount = 0;       // 画面外で止めた数
+            float updateMilliseconds = 0.0f;// 姿勢の更新にかかった時間の合計（全スレッド分）
+        };
+
+    private:
+
+        // インスタンス情報
+        struct Instance
+        {
+            std::unique_ptr<Animator> animator;
+
+            // ワールド行列の配列内の先頭位置
+            size_t offset = 0;
+
+            // モデル番号（並べ替え用）
+            uint32_t modelIndex = 0;
+
+            // カメラからの距離
+            float distance = 0.0f;
+
+            // 画面内か
+            bool visible = true;
+
+            // 止めている間か（作成直後と見えた時は補間せずにすぐ更新する）
+            bool frozen = true;
+
+            // 現在の LOD
+            uint32_t lod = 0;
+
+            // まだ姿勢に反映していない経過時間
+            float pendingTime = 0.0f;
+
+            // 前回姿勢を更新してからのフレーム数
+            uint32_t framesSinceUpdate = 0;
+
+            // 前回の補間の割合（変わらなければ行列を作り直さない）
+            float alpha = 1.0f;
+
+            // 姿勢の更新にかかった時間（ミリ秒、移動平均）
+            float cost = 0.0f;
+        };
+
+        // モデル毎の情報
+        struct ModelInfo
+        {
+            // 各ノードの親子の深さ
+            std::vector<uint32_t> nodeDepths;
+
+            // LOD 毎のサンプリングするノード（空なら全て）
+            std::vector<std::vector<uint8_t>> lodNodeMasks;
+        };
+
+        // 更新する内容
+        struct WorkItem
+        {
+            uint64_t key;       // 並べ替えのキー
+            uint32_t id;        // インスタンス番号
+            float alpha;        // 補間の割合
+            bool updatePose;    // 姿勢を更新するか
+            bool keepPrevious;  // 補間用に前回の姿勢を残すか
+            float milliseconds; // 姿勢の更新にかかった時間
+
+            bool operator<(const WorkItem& other) const { return key < other.key; }
+        };
+
+        // 全てのインスタンス
+        std::vector<Instance> m_instances;
+
+        // 全てのアニメーターのワールド行列
+        std::vector<DirectX::XMFLOAT4X4> m_worldMatrices;
+
+        // モデルとモデル番号の対応表
+        std::unordered_map<const Imase::ModelAnimationData*, uint32_t> m_modelIndices;
+
+        // モデル毎の情報（モデル番号順）
+        std::vector<ModelInfo> m_models;
+
+        // LOD の設定（距離の昇順）
+        std::vector<LodLevel> m_lodLevels;
+
+        // １フレームに姿勢の更新に使う時間の予算（ミリ秒、0 なら無制限）
+        float m_timeBudget;
+
+        // 更新する順番（モデルとクリップ毎に並べる）
+        std::vector<WorkItem> m_order;
+
+        // 更新の時期が来ているインスタンス（優先度、インスタンス番号）
+        std::vector<std::pair<float, uint32_t>> m_dueInstances;
+
+        // 統計情報
+        Stats m_stats;
+
+        // 姿勢を共有するキャッシュ（nullptr なら使わない）
+        PoseCache* m_poseCache;
+
+        // 処理時間の計測（nullptr なら計測しない）
+        AnimationProfile* m_profile;
+
+        // 回転の補間方式
+        RotationInterpolation m_rotationInterpolation;
+
+        // バッチを実行するジョブシステム
+        JobSystem& m_jobSystem;
+
+    private:
+
+        // 並べ替えのキーを作成する関数
+        uint64_t MakeSortKey(uint32_t id) const;
+
+        // ワールド行列の出力先を設定し直す関数
+        void BindWorldMatrixBuffers();
+
+        // LOD 毎のサンプリングするノードを作成する関数
+        void BuildLodNodeMasks(ModelInfo& info) const;
+
+        // 距離から LOD を選ぶ関数
+        uint32_t SelectLod(float distance) const;
+
+        // 更新する内容を決める関数
+        void ScheduleWork(float elapsedTime);
+
+    public:
+
+        // コンストラクタ（jobSystem が nullptr なら共有のジョブシステムを使う）
+        explicit AnimationSystem(JobSystem* jobSystem = nullptr);
+
+        // デストラクタ
+        ~AnimationSystem() = default;
+
+        AnimationSystem(const AnimationSystem&) = delete;
+        AnimationSystem& operator=(const AnimationSystem&) = delete;
+
+        // アニメーターを作成する関数（戻り値はインスタンス番号）
+        uint32_t CreateAnimator(const Imase::ModelAnimationData& model);
+
+        // 全てのアニメーターを削除する関数
+        void Clear();
+
+        // アニメーターを取得する関数
+        Animator& GetAnimator(uint32_t id) { return *m_instances[id].animator; }
+        const Animator& GetAnimator(uint32_t id) const { return *m_instances[id].animator; }
+
+        // アニメーターの数を取得する関数
+        uint32_t GetAnimatorCount() const { return static_cast<uint32_t>(m_instances.size()); }
+
+        // 全てのアニメーターを更新する関数
+        void Update(float elapsedTime);
+
+        // ------------------------------------------------------------------- //
+
+        // LOD を設定する関数（先頭は距離 0 にすること、既定は全て毎フレーム更新する１段階）
+        void SetLodLevels(const std::vector<LodLevel>& levels);
+
+        // LOD の設定を取得する関数
+        const std::vector<LodLevel>& GetLodLevels() const { return m_lodLevels; }
+
+        // カメラからの距離と画面内かどうかを設定する関数（毎フレーム更新前に設定する）
+        void SetViewState(uint32_t id, float distance, bool visible);
+
+        // １フレームに姿勢の更新に使う時間の予算を設定する関数（ミリ秒、0 なら無制限）
+        void SetTimeBudget(float milliseconds) { m_timeBudget = milliseconds; }
+
+        // 姿勢を共有するキャッシュを設定する関数（更新毎に BeginFrame を呼ぶ、nullptr で使わない）
+        void SetPoseCache(PoseCache* cache);
+
+        // 処理時間を計測する関数（全てのアニメーターの段階毎の時間と更新の実時間を集計する、nullptr で計測しない）
+        void SetProfile(AnimationProfile* profile);
+
+        // 全てのアニメーターの回転の補間方式を設定する関数（既定は Slerp）
+        void SetRotationInterpolation(RotationInterpolation mode);
+
+        // 現在の LOD を取得する関数
+        uint32_t GetLod(uint32_t id) const { return m_instances[id].lod; }
+
+        // 統計情報を取得する関数
+        const Stats& GetStats() const { return m_stats; }
+
+        // ------------------------------------------------------------------- //
+
+        // 指定したアニメーターのワールド行列を取得する関数
+        std::span<const DirectX::XMFLOAT4X4> GetWorldMatrices(uint32_t id) const;
+
+        // 全てのアニメーターのワールド行列を取得する関数（インスタンス番号順に連続している）
+        const std::vector<DirectX::XMFLOAT4X4>& GetAllWorldMatrices() const { return m_worldMatrices; }
+
+    };
+}
@@ -1,7 +1,7 @@
 //--------------------------------------------------------------------------------------
 // File: Animator.cpp
 //
-// Aj[V̍ĐǗNX
+// アニメーションの再生を管理するクラス
 //
 // Date: 2026.3.3
 // Author: Hideyasu Imase
@@ -12,56 +12,137 @@
 
 using namespace DirectX;
 
-// RXgN^
-Imase::Animator::Animator(const Imase::Model& model)
+namespace
+{
+    // 重みがこれ以下なら無視する
+    constexpr float WeightEpsilon = 1.0e-5f;
+
+    // 姿勢へそのまま設定する visitor
+    struct PoseSetter
+    {
+        Imase::AnimationPose& pose;
+        void Translation(uint32_t node, const XMFLOAT3& v) { pose.SetTranslation(node, v); }
+        void Rotation(uint32_t node, const XMFLOAT4& v) { pose.SetRotation(node, v); }
+        void Scale(uint32_t node, const XMFLOAT3& v) { pose.SetScale(node, v); }
+    };
+
+    // マスクが 0 のノードを飛ばす visitor
+    template <class Visitor>
+    struct MaskedVisitor
+    {
+        Visitor& visitor;
+        const uint8_t* mask;
+        void Translation(uint32_t node, const XMFLOAT3& v) { if (mask[node]) visitor.Translation(node, v); }
+        void Rotation(uint32_t node, const XMFLOAT4& v) { if (mask[node]) visitor.Rotation(node, v); }
+        void Scale(uint32_t node, const XMFLOAT3& v) { if (mask[node]) visitor.Scale(node, v); }
+    };
+
+    // ノードの移動、回転、スケールを scale 倍する関数
+    void ScaleNode(Imase::PoseBlock& b, size_t lane, float scale)
+    {
+        b.tx[lane] *= scale; b.ty[lane] *= scale; b.tz[lane] *= scale;
+        b.rx[lane] *= scale; b.ry[lane] *= scale; b.rz[lane] *= scale; b.rw[lane] *= scale;
+        b.sx[lane] *= scale; b.sy[lane] *= scale; b.sz[lane] *= scale;
+    }
+}
+
+// コンストラクタ
+Imase::Animator::Animator(const Imase::ModelAnimationData& model)
 	: m_model{ model }
     , m_nodes{ model.GetNodes() }
 	, m_loop{ true }
     , m_playMode{ PlayMode::Single }
-    , m_currentPoseState{ -1, 0.0f, std::vector<Transform>(model.GetNodes().size()) }
-    , m_nextPoseState{ -1, 0.0f, std::vector<Transform>(model.GetNodes().size()) }
+    , m_accumulated{ false }
+    , m_blendTree{ nullptr }
+    , m_previousPoseValid{ false }
+    , m_nodeMask{ nullptr }
+    , m_activeNodeMask{ nullptr }
+    , m_rebuildAll{ true }
+    , m_sampledClipIndex{ -1 }
+    , m_sampledTime{ 0.0f }
+    , m_paused{ false }
+    , m_pausedPoseValid{ false }
+    , m_poseCache{ nullptr }
+    , m_cacheHitEntry{ nullptr }
+    , m_cacheFillEntry{ nullptr }
+    , m_profile{ nullptr }
+    , m_rotationInterpolation{ RotationInterpolation::Slerp }
+    , m_channelSampleCount{ 0 }
+    , m_keyCursorJumpCount{ 0 }
+    , m_currentPoseState{ -1, 0.0f, {} }
+    , m_nextPoseState{ -1, 0.0f, {} }
     , m_blendDuration{ 0.0f }
     , m_blendTimer{ 0.0f }
     , m_blendWeight{ 0.0f }
     , m_localMatrices{ std::vector<DirectX::XMFLOAT4X4>(model.GetNodes().size()) }
     , m_worldMatrices{ std::vector<DirectX::XMFLOAT4X4>(model.GetNodes().size()) }
+    , m_worldOutput{ nullptr }
 {
-    // [Js
+    // 初期ポーズを作成
+    m_bindPose.Resize(m_nodes.size());
+    for (size_t i = 0; i < m_nodes.size(); i++)
+    {
+        m_bindPose.SetTranslation(i, m_nodes[i].defaultTranslation);
+        m_bindPose.SetRotation(i, m_nodes[i].defaultRotation);
+        m_bindPose.SetScale(i, m_nodes[i].defaultScale);
+    }
+    m_pose = m_bindPose;
+
+    // ブレンド用の重み（移動、回転、スケール、合計の４つ）
+    m_accumWeights.assign(m_nodes.size() * 4, 0.0f);
+
+    // 動くノードの情報（再生中のクリップの切り替えで再確保しない）
+    m_nodeStates.assign(m_nodes.size(), 0);
+    m_animatedNodes.reserve(m_nodes.size());
+    m_animatedBlocks.reserve(m_pose.GetBlocks().size());
+    m_dirtyNodes.reserve(m_nodes.size());
+
+    // ローカル行列を初期化
     for (auto& m : m_localMatrices)
     {
-        m = SimpleMath::Matrix::Identity;
+        XMStoreFloat4x4(&m, XMMatrixIdentity());
     }
 
-    // [hs
+    // ワールド行列を初期化
     for (auto& m : m_worldMatrices)
     {
-        m = SimpleMath::Matrix::Identity;
+        XMStoreFloat4x4(&m, XMMatrixIdentity());
     }
+    m_worldOutput = m_worldMatrices.data();
 
-    // AjVNbvo^
+    // アニメションクリップ名を登録
+    size_t maxChannelCount = 0;
     int i = 0;
     while (const Imase::AnimationClip* anim = m_model.GetAnimation(i))
     {
         m_animationIndexTable[anim->name] = i;
         m_animationNameTable[i] = anim->name;
+        maxChannelCount = std::max(maxChannelCount, anim->translations.size() + anim->rotations.size() + anim->scales.size());
         i++;
     }
+
+    // キー位置は最大のクリップに合わせて確保しておく（再生中のクリップの切り替えで再確保しない）
+    m_currentPoseState.m_keyCursors.reserve(maxChannelCount);
+    m_nextPoseState.m_keyCursors.reserve(maxChannelCount);
+
+    m_activeClips.reserve(i);
+    m_activeClipsWork.reserve(i);
 }
 
-// AjVCfbNX擾֐
+// アニメションインデックスを取得する関数
 int Imase::Animator::GetAnimationIndex(std::string animationName)
 {
 
     return m_animationIndexTable.at(animationName);
 }
 
-// Aj[V擾֐
+// アニメーション名を取得する関数
 std::string Imase::Animator::GetAnimationName(int animationIndex)
 {
     return m_animationNameTable.at(animationIndex);
 }
 
-// Đ
+// 再生
 void Imase::Animator::Play(std::string animationName, bool loop)
 {
     Play(GetAnimationIndex(animationName), loop);
@@ -75,66 +156,243 @@ void Imase::Animator::Play(int animationIndex, bool loop)
     m_loop = loop;
 }
 
-// XV
+// ブレンドツリーを再生する関数
+void Imase::Animator::PlayBlendTree(BlendTree* blendTree)
+{
+    m_blendTree = blendTree;
+    m_playMode = blendTree ? PlayMode::BlendTree : PlayMode::Single;
+    m_pausedPoseValid = false;
+}
+
+// 更新
 void Imase::Animator::Update(float elapsedTime)
 {
-    // ĐԂXV
-    UpdateTime(elapsedTime);
+    if (UpdatePose(elapsedTime))
+    {
+        BuildMatrices();
+    }
+}
 
-    // ʏ̍Đ
-    if (m_playMode == PlayMode::Single)
+// 姿勢だけを更新する関数
+bool Imase::Animator::UpdatePose(float elapsedTime, bool keepPreviousPose)
+{
+    // 補間用に更新前の姿勢を残す（同じノード数なので２回目以降は再確保しない）
+    if (keepPreviousPose)
     {
-        const AnimationClip* clip = m_model.GetAnimation(m_currentPoseState.m_clipIndex);
-        if (!clip) return;
+        if (m_interpolatedPose.GetNodeCount() != m_nodes.size())
+        {
+            m_interpolatedPose = m_pose;
+        }
+        m_previousPose = m_pose;
+    }
+    m_previousPoseValid = keepPreviousPose;
 
-        // ݂̎Ԃ̃|[Y擾
-        SamplePose(*clip, m_currentPoseState.m_time, m_currentPoseState.m_pose);
+    m_cacheHitEntry = nullptr;
+    m_cacheFillEntry = nullptr;
+
+    // 一時停止中のブレンドとブレンドツリーは、作成済みなら前回と同じ姿勢なので何もしない
+    if (m_paused && m_pausedPoseValid && !m_rebuildAll && m_playMode != PlayMode::Single)
+    {
+        return false;
     }
 
-    // Aj[VuhL̏ꍇ
-    else if (m_playMode == PlayMode::Blend)
+    // ブレンドツリーの再生
+    if (m_playMode == PlayMode::BlendTree)
     {
-        const AnimationClip* clipA = m_model.GetAnimation(m_currentPoseState.m_clipIndex);
-        const AnimationClip* clipB = m_model.GetAnimation(m_nextPoseState.m_clipIndex);
-        if (!clipA || !clipB) return;
+        UpdateBlendTree(elapsedTime);
+        UpdateActiveNodes();
+        {
+            AnimationProfile::ScopedTimer timer(m_profile, AnimationProfile::Stage::Sample, m_animatedNodes.size());
+            EvaluateBlendTree();
+        }
+        m_sampledClipIndex = -1;
+    }
+    else
+    {
+        // 再生時間を更新
+        UpdateTime(elapsedTime);
+        UpdateActiveNodes();
 
-        // uhƃuh̃|[Y擾
-        SamplePose(*clipA, m_currentPoseState.m_time, m_currentPoseState.m_pose);
-        SamplePose(*clipB, m_nextPoseState.m_time, m_nextPoseState.m_pose);
+        // 通常の再生
+        if (m_playMode == PlayMode::Single)
+        {
+            const AnimationClip* clip = m_model.GetAnimation(m_currentPoseState.m_clipIndex);
+            if (!clip) return false;
+
+            // キャッシュを使う場合は量子化した時間でサンプリングする
+            float sampleTime = m_currentPoseState.m_time;
+            int64_t timeKey = 0;
+            if (m_poseCache)
+            {
+                sampleTime = m_poseCache->Quantize(sampleTime, timeKey);
+            }
+
+            // 一時停止中やループ無しで最後まで再生した場合は前回と同じ姿勢なので何もしない
+            if (!m_rebuildAll
+                && m_sampledClipIndex == m_currentPoseState.m_clipIndex
+                && m_sampledTime == sampleTime)
+            {
+                return false;
+            }
+
+            // 同じ姿勢が既にあればコピーするだけ、無ければサンプリングして BuildMatrices で書き込む
+            bool hit = false;
+            PoseCache::Entry* entry = nullptr;
+            if (m_poseCache)
+            {
+                entry = m_poseCache->Acquire({ &m_model, m_nodeMask, m_currentPoseState.m_clipIndex, timeKey, m_rotationInterpolation }, hit);
+            }
+
+            if (hit)
+            {
+                m_pose = entry->pose;
+                m_cacheHitEntry = entry;
+            }
+            else
+            {
+                // 現在の時間のポーズを取得
+                AnimationProfile::ScopedTimer timer(m_profile, AnimationProfile::Stage::Sample, m_animatedNodes.size());
+                SamplePose(*clip, sampleTime, m_currentPoseState);
+                m_cacheFillEntry = entry;
+            }
+            m_sampledClipIndex = m_currentPoseState.m_clipIndex;
+            m_sampledTime = sampleTime;
+        }
 
-        // Aj[Vuh
-        Pose resultPose;
-        BlendPose(m_currentPoseState.m_pose, m_nextPoseState.m_pose, m_blendWeight, resultPose);
-        m_currentPoseState.m_pose = resultPose;
+        // アニメーションブレンド有りの場合
+        else if (m_playMode == PlayMode::Blend)
+        {
+            const AnimationClip* clipA = m_model.GetAnimation(m_currentPoseState.m_clipIndex);
+            const AnimationClip* clipB = m_model.GetAnimation(m_nextPoseState.m_clipIndex);
+            if (!clipA || !clipB) return false;
+
+            // ブレンド元とブレンド先の値を姿勢へ直接加算する（ポーズを２つ作らない）
+            AnimationProfile::ScopedTimer timer(m_profile, AnimationProfile::Stage::Sample, m_animatedNodes.size());
+            BeginAccumulate();
+            BeginLayer(1.0f, nullptr);
+            AccumulateClip(*clipA, m_currentPoseState.m_clipIndex, m_currentPoseState.m_time, 1.0f - m_blendWeight, nullptr, m_currentPoseState.m_keyCursors);
+            AccumulateClip(*clipB, m_nextPoseState.m_clipIndex, m_nextPoseState.m_time, m_blendWeight, nullptr, m_nextPoseState.m_keyCursors);
+            EndAccumulate();
+            m_sampledClipIndex = -1;
+        }
     }
 
-    // em[h̃[Js𐶐
-    BuildLocalMatrices();
+    m_pausedPoseValid = m_paused && m_playMode != PlayMode::Single;
 
-    // eqĊem[h̃[hs𐶐
-    BuildWorldMatrices();
+    // サンプリングの回数はまとめて加算する
+    if (m_profile)
+    {
+        m_profile->AddSamples(m_channelSampleCount, m_keyCursorJumpCount);
+        m_channelSampleCount = 0;
+        m_keyCursorJumpCount = 0;
+    }
+
+    return true;
 }
 
-// em[h̃[hs擾֐
-const std::vector<DirectX::XMFLOAT4X4>& Imase::Animator::GetWorldMatrices() const
+// 姿勢からワールド行列を作成する関数
+void Imase::Animator::BuildMatrices(float alpha)
 {
-    return m_worldMatrices;
+    const AnimationPose* pose = &m_pose;
+
+    // 前回の姿勢から補間する（4ノードずつ計算）
+    if (alpha < 1.0f && m_previousPoseValid)
+    {
+        AnimationProfile::ScopedTimer timer(m_profile, AnimationProfile::Stage::Blend, m_nodes.size());
+        BlendPoses(m_previousPose, m_pose, std::max(alpha, 0.0f), m_interpolatedPose, m_rotationInterpolation);
+        pose = &m_interpolatedPose;
+    }
+
+    // キャッシュの姿勢を使う場合はワールド行列をコピーするだけ
+    // （動くノードのローカル行列は古いままだが、次に計算する時に全て作り直すので問題ない）
+    if (m_cacheHitEntry && pose == &m_pose)
+    {
+        if (m_rebuildAll)
+        {
+            const auto& bindLocalMatrices = m_model.GetBindLocalMatrices();
+            std::copy(bindLocalMatrices.begin(), bindLocalMatrices.end(), m_localMatrices.begin());
+            m_rebuildAll = false;
+        }
+        std::copy(m_cacheHitEntry->worldMatrices.begin(), m_cacheHitEntry->worldMatrices.end(), m_worldOutput);
+        m_cacheHitEntry = nullptr;
+        return;
+    }
+    m_cacheHitEntry = nullptr;
+
+    // 再生中のクリップが変わった場合や出力先が変わった場合は全てのノードを作り直す
+    if (m_rebuildAll)
+    {
+        {
+            // 動かないノードは初期ポーズのローカル行列のまま
+            AnimationProfile::ScopedTimer timer(m_profile, AnimationProfile::Stage::LocalMatrices, m_nodes.size());
+            const auto& bindLocalMatrices = m_model.GetBindLocalMatrices();
+            std::copy(bindLocalMatrices.begin(), bindLocalMatrices.end(), m_localMatrices.begin());
+            BuildLocalMatrices(*pose);
+        }
+
+        // 親子合成をして各ノードのワールド行列を生成する
+        AnimationProfile::ScopedTimer timer(m_profile, AnimationProfile::Stage::WorldMatrices, m_nodes.size());
+        BuildWorldMatrices();
+
+        m_rebuildAll = false;
+    }
+    else
+    {
+        // 動くノードのローカル行列と、動くノードとその子孫のワールド行列だけ作り直す
+        {
+            AnimationProfile::ScopedTimer timer(m_profile, AnimationProfile::Stage::LocalMatrices, m_animatedBlocks.size() * PoseBlock::Width);
+            BuildLocalMatrices(*pose);
+        }
+
+        AnimationProfile::ScopedTimer timer(m_profile, AnimationProfile::Stage::WorldMatrices, m_dirtyNodes.size());
+        for (uint32_t node : m_dirtyNodes)
+        {
+            BuildWorldMatrix(node);
+        }
+    }
+
+    // サンプリングした姿勢をキャッシュに書き込む（補間した場合は書き込まない）
+    if (m_cacheFillEntry)
+    {
+        if (pose == &m_pose)
+        {
+            m_cacheFillEntry->pose = m_pose;
+            m_cacheFillEntry->worldMatrices.assign(m_worldOutput, m_worldOutput + m_nodes.size());
+            m_poseCache->Publish(m_cacheFillEntry);
+        }
+        m_cacheFillEntry = nullptr;
+    }
 }
 
-// Aj[VAj[VCfbNXŎ擾֐
+// 各ノードのワールド行列を取得する関数
+std::span<const DirectX::XMFLOAT4X4> Imase::Animator::GetWorldMatrices() const
+{
+    return { m_worldOutput, m_nodes.size() };
+}
+
+// ワールド行列の出力先を設定する関数
+void Imase::Animator::SetWorldMatrixBuffer(DirectX::XMFLOAT4X4* buffer)
+{
+    m_worldOutput = buffer ? buffer : m_worldMatrices.data();
+
+    // 新しい出力先には動かないノードの行列も書き込む
+    m_rebuildAll = true;
+}
+
+// アニメーション名をアニメーションインデックス順で取得する関数
 const std::vector<std::string> Imase::Animator::GetAnimationNames() const
 {
-    // map̗vfpairvectorɃRs[
+    // mapの要素をpairのvectorにコピー
     std::vector<std::pair<std::string, int>> vec(m_animationIndexTable.begin(), m_animationIndexTable.end());
 
-    // Aj[VCfbNX̏Ń\[g
+    // アニメーションインデックスの昇順でソート
     std::sort(vec.begin(), vec.end(), [](const auto& a, const auto& b)
         {
-            return a.second < b.second; // 
+            return a.second < b.second; // 昇順
         }
     );
 
-    // L[(Aj[V)𒊏o
+    // キー(アニメーション名)だけを抽出
     std::vector<std::string> keys;
     keys.reserve(vec.size());
     for (const auto& pair : vec)
@@ -145,13 +403,13 @@ const std::vector<std::string> Imase::Animator::GetAnimationNames() const
     return keys;
 }
 
-// ĐԂ擾֐
+// 再生時間を取得する関数
 float Imase::Animator::GetPlayTime() const
 {
     return m_currentPoseState.m_time;
 }
 
-// Aj[V̒ivԁj擾֐
+// アニメーションの長さ（所要時間）を取得する関数
 float Imase::Animator::GetAnimationDuration(int animationIndex) const
 {
     const AnimationClip* clip = m_model.GetAnimation(animationIndex);
@@ -168,12 +426,17 @@ float Imase::Animator::GetRestTime() const
     return rest;
 }
 
-int Imase::Animator::GetCurrentAnimationIndex()
+int Imase::Animator::GetCurrentAnimationIndex() const
 {
     return m_currentPoseState.m_clipIndex;
 }
 
-// NXtF[h֐
+int Imase::Animator::GetNextAnimationIndex() const
+{
+    return (m_playMode == PlayMode::Blend) ? m_nextPoseState.m_clipIndex : -1;
+}
+
+// クロスフェードする関数
 void Imase::Animator::CrossFade(std::string nextAnimationName, float duration)
 {
     CrossFade(GetAnimationIndex(nextAnimationName), duration);
@@ -188,194 +451,613 @@ void Imase::Animator::CrossFade(int animationIndex, float duration)
     m_blendTimer = 0.0f;
 
     m_playMode = PlayMode::Blend;
+    m_pausedPoseValid = false;
 }
 
-// w莞Ԃ̒l擾֐ix,y,zj
-DirectX::XMFLOAT3 Imase::Animator::SampleVec3(const Imase::AnimationChannelVec3& ch, float time)
+// 指定時間を含むキーの区間を探す関数
+size_t Imase::Animator::FindKey(const std::vector<float>& times, float time, uint32_t& cursor)
 {
-    if (ch.times.empty() || ch.values.empty())
-    {
-        return XMFLOAT3(0.0f, 0.0f, 0.0f);
-    }
+    // 前方へ進める最大数（これを超える場合は二分探索の方が速い）
+    constexpr uint32_t MaxForwardSteps = 4;
 
-    // w莞Ԃ̒lԂi`ԁj
-    for (size_t i = 0; i < ch.times.size() - 1; i++)
+    size_t last = times.size() - 2;
+    size_t i = std::min<size_t>(cursor, last);
+
+    if (times[i] <= time)
     {
-        if ((time >= ch.times[i]) && (time <= ch.times[i + 1]))
+        // 通常の再生（前回の区間かその少し先にある）
+        uint32_t steps = 0;
+        while (i < last && times[i + 1] <= time && steps < MaxForwardSteps)
         {
-            float t = (time - ch.times[i]) / (ch.times[i + 1] - ch.times[i]);
+            i++;
+            steps++;
+        }
 
-            XMVECTOR a = XMLoadFloat3(&ch.values[i]);
-            XMVECTOR b = XMLoadFloat3(&ch.values[i + 1]);
+        if (i < last && times[i + 1] <= time)
+        {
+            // 大きく進んだ場合
+            i = std::upper_bound(times.begin() + i, times.end(), time) - times.begin() - 1;
+        }
+    }
+    else
+    {
+        // ループや再生開始で時間が戻った場合
+        auto it = std::upper_bound(times.begin(), times.begin() + i + 1, time);
+        i = (it == times.begin()) ? 0 : static_cast<size_t>(it - times.begin() - 1);
+    }
 
-            XMVECTOR result = XMVectorLerp(a, b, t);
+    i = std::min(i, last);
+    cursor = static_cast<uint32_t>(i);
+    return i;
+}
 
-            XMFLOAT3 out;
-            XMStoreFloat3(&out, result);
-            return out;
-        }
+// 指定時間の値を取得する関数（x,y,z）
+DirectX::XMFLOAT3 Imase::Animator::SampleVec3(const Imase::AnimationChannelVec3& ch, float time, uint32_t& cursor)
+{
+    if (ch.times.empty() || ch.values.empty())
+    {
+        return XMFLOAT3(0.0f, 0.0f, 0.0f);
     }
 
-    if (time <= ch.times.front())
+    if (time <= ch.times.front() || ch.times.size() == 1)
         return ch.values.front();
 
     if (time >= ch.times.back())
         return ch.values.back();
 
-    return ch.values.back();
+    // 指定時間の値を返す（線形補間）
+    uint32_t previousCursor = cursor;
+    size_t i = FindKey(ch.times, time, cursor);
+
+    if (m_profile)
+    {
+        // 前回の区間かその次の区間に無かった場合は探索が必要だった
+        m_channelSampleCount++;
+        if (cursor < previousCursor || cursor > previousCursor + 1) m_keyCursorJumpCount++;
+    }
+
+    float t = (time - ch.times[i]) / (ch.times[i + 1] - ch.times[i]);
+
+    XMVECTOR a = XMLoadFloat3(&ch.values[i]);
+    XMVECTOR b = XMLoadFloat3(&ch.values[i + 1]);
+
+    XMVECTOR result = XMVectorLerp(a, b, t);
+
+    XMFLOAT3 out;
+    XMStoreFloat3(&out, result);
+    return out;
 }
 
-// w莞Ԃ̒l擾֐ix,y,z,wj
-DirectX::XMFLOAT4 Imase::Animator::SampleQuat(const Imase::AnimationChannelQuat& ch, float time)
+// 指定時間の値を取得する関数（x,y,z,w）
+DirectX::XMFLOAT4 Imase::Animator::SampleQuat(const Imase::AnimationChannelQuat& ch, float time, uint32_t& cursor)
 {
     if (ch.times.empty() || ch.values.empty())
     {
-        // PʃNH[^jIԂ
+        // 単位クォータニオンを返す
         return XMFLOAT4(0.0f, 0.0f, 0.0f, 1.0f);
     }
 
-    // w莞Ԃ̒lԂiʐ`ԁj
-    for (size_t i = 0; i < ch.times.size() - 1; i++)
+    if (time <= ch.times.front() || ch.times.size() == 1)
+        return ch.values.front();
+
+    if (time >= ch.times.back())
+        return ch.values.back();
+
+    // 指定時間の値を返す（回転の補間方式で補間）
+    uint32_t previousCursor = cursor;
+    size_t i = FindKey(ch.times, time, cursor);
+
+    if (m_profile)
     {
-        if (time >= ch.times[i] && time <= ch.times[i + 1])
-        {
-            float t = (time - ch.times[i]) / (ch.times[i + 1] - ch.times[i]);
+        // 前回の区間かその次の区間に無かった場合は探索が必要だった
+        m_channelSampleCount++;
+        if (cursor < previousCursor || cursor > previousCursor + 1) m_keyCursorJumpCount++;
+    }
 
-            XMVECTOR a = XMLoadFloat4(&ch.values[i]);
-            XMVECTOR b = XMLoadFloat4(&ch.values[i + 1]);
+    float t = (time - ch.times[i]) / (ch.times[i + 1] - ch.times[i]);
 
-            XMVECTOR result = XMQuaternionSlerp(a, b, t);
+    XMVECTOR a = XMLoadFloat4(&ch.values[i]);
+    XMVECTOR b = XMLoadFloat4(&ch.values[i + 1]);
 
-            XMFLOAT4 out;
-            XMStoreFloat4(&out, result);
-            return out;
+    XMVECTOR result = InterpolateRotation(m_rotationInterpolation, a, b, t);
+
+    XMFLOAT4 out;
+    XMStoreFloat4(&out, result);
+    return out;
+}
+
+// 初期ポーズへリセットする関数
+void Imase::Animator::ResetPoseToBind(AnimationPose& pose)
+{
+    // 同じノード数なので再確保せずにコピーされる
+    pose = m_bindPose;
+}
+
+// クリップの各チャンネルの指定時間の値を visitor に渡す関数
+template <class Visitor>
+void Imase::Animator::VisitClip(const AnimationClip& clip, int clipIndex, float time, std::vector<uint32_t>& cursors, Visitor& visitor)
+{
+    // 焼き込んだクリップがあればキーを検索せずにサンプリングする
+    if (const BakedAnimationClip* baked = m_model.GetBakedAnimation(static_cast<uint32_t>(clipIndex)))
+    {
+        if (m_nodeMask)
+        {
+            VisitBakedClip(*baked, time, MaskedVisitor<Visitor>{ visitor, m_nodeMask });
+        }
+        else
+        {
+            VisitBakedClip(*baked, time, visitor);
         }
+        return;
     }
 
-    if (time <= ch.times.front())
-        return ch.values.front();
+    // クリップが変わった場合はキー位置を作り直す（先頭から二分探索される）
+    size_t channelCount = clip.translations.size() + clip.rotations.size() + clip.scales.size();
+    if (cursors.size() != channelCount)
+    {
+        cursors.assign(channelCount, 0);
+    }
+    uint32_t* cursor = cursors.data();
 
-    if (time >= ch.times.back())
-        return ch.values.back();
+    // マスクが 0 のノードはキーの検索も補間もしない
+    const uint8_t* mask = m_nodeMask;
+
+    // 移動
+    for (const auto& ch : clip.translations)
+    {
+        uint32_t& c = *cursor++;
+        if (mask && !mask[ch.nodeIndex]) continue;
+        visitor.Translation(ch.nodeIndex, SampleVec3(ch, time, c));
+    }
 
-    return ch.values.back();
+    // 回転
+    for (const auto& ch : clip.rotations)
+    {
+        uint32_t& c = *cursor++;
+        if (mask && !mask[ch.nodeIndex]) continue;
+        visitor.Rotation(ch.nodeIndex, SampleQuat(ch, time, c));
+    }
+
+    // スケール
+    for (const auto& ch : clip.scales)
+    {
+        uint32_t& c = *cursor++;
+        if (mask && !mask[ch.nodeIndex]) continue;
+        visitor.Scale(ch.nodeIndex, SampleVec3(ch, time, c));
+    }
 }
 
-// |[YփZbg֐
-void Imase::Animator::ResetPoseToBind(Pose& pose)
+// 再生時間のポーズを取得する関数
+void Imase::Animator::SamplePose(const AnimationClip& clip, float time, AnimationState& state)
 {
-    const auto& nodes = m_model.GetNodes();
+    // 動くノードは毎回同じチャンネルで上書きされるので初期ポーズへ戻す必要は無い
+    // （再生中のクリップが変わった時は UpdateActiveNodes で戻している）
+    PoseSetter setter{ m_pose };
+    VisitClip(clip, state.m_clipIndex, time, state.m_keyCursors, setter);
+}
+
+// 加算を開始する関数
+void Imase::Animator::BeginAccumulate()
+{
+    auto& blocks = m_pose.GetBlocks();
 
-    for (size_t i = 0; i < nodes.size(); ++i)
+    // 動くノードだけ 0 にする（他のノードは初期ポーズのまま）
+    for (uint32_t i : m_animatedNodes)
     {
-        pose.transforms[i].translation = nodes[i].defaultTranslation;
-        pose.transforms[i].rotation = nodes[i].defaultRotation;
-        pose.transforms[i].scale = nodes[i].defaultScale;
+        ScaleNode(blocks[i / PoseBlock::Width], i % PoseBlock::Width, 0.0f);
+        std::fill_n(&m_accumWeights[i * 4], 4, 0.0f);
     }
+    m_accumulated = false;
 }
 
-// ĐԂ̃|[Y擾֐
-void Imase::Animator::SamplePose(const AnimationClip& clip, float time, Pose& outPose)
+// レイヤーを開始する関数
+void Imase::Animator::BeginLayer(float weight, const float* mask)
 {
-    // |[YZbg
-    ResetPoseToBind(outPose);
+    auto& blocks = m_pose.GetBlocks();
 
-    // ړ
-    for (const auto& ch : clip.translations)
+    for (uint32_t i : m_animatedNodes)
     {
-        outPose.transforms[ch.nodeIndex].translation = SampleVec3(ch, time);
+        float a = std::clamp(weight * (mask ? mask[i] : 1.0f), 0.0f, 1.0f);
+        float* w = &m_accumWeights[i * 4];
+
+        // 下のレイヤーの加算結果を 1 - a の割合に縮める
+        if (m_accumulated)
+        {
+            float keep = 1.0f - a;
+            ScaleNode(blocks[i / PoseBlock::Width], i % PoseBlock::Width, keep);
+            w[0] *= keep;
+            w[1] *= keep;
+            w[2] *= keep;
+            w[3] *= keep;
+        }
+        w[3] += a;
     }
 
-    // ]
-    for (const auto& ch : clip.rotations)
+    m_accumulated = true;
+}
+
+// クリップの値を重み付きで加算する関数
+void Imase::Animator::AccumulateClip(const AnimationClip& clip, int clipIndex, float time, float weight, const float* mask, std::vector<uint32_t>& cursors)
+{
+    if (weight <= WeightEpsilon) return;
+
+    struct Accumulator
     {
-        outPose.transforms[ch.nodeIndex].rotation = SampleQuat(ch, time);
+        std::vector<PoseBlock>& blocks;
+        float* weights;
+        float weight;
+        const float* mask;
+
+        float NodeWeight(uint32_t node) const { return mask ? weight * mask[node] : weight; }
+
+        void Translation(uint32_t node, const XMFLOAT3& v)
+        {
+            float a = NodeWeight(node);
+            PoseBlock& b = blocks[node / PoseBlock::Width];
+            size_t lane = node % PoseBlock::Width;
+            b.tx[lane] += v.x * a;
+            b.ty[lane] += v.y * a;
+            b.tz[lane] += v.z * a;
+            weights[node * 4 + 0] += a;
+        }
+
+        void Rotation(uint32_t node, const XMFLOAT4& v)
+        {
+            float a = NodeWeight(node);
+            PoseBlock& b = blocks[node / PoseBlock::Width];
+            size_t lane = node % PoseBlock::Width;
+
+            // 加算済みの値と同じ半球に揃える（遠回りの補間を防ぐ）
+            float dot = b.rx[lane] * v.x + b.ry[lane] * v.y + b.rz[lane] * v.z + b.rw[lane] * v.w;
+            if (dot < 0.0f) a = -a;
+
+            b.rx[lane] += v.x * a;
+            b.ry[lane] += v.y * a;
+            b.rz[lane] += v.z * a;
+            b.rw[lane] += v.w * a;
+            weights[node * 4 + 1] += std::abs(a);
+        }
+
+        void Scale(uint32_t node, const XMFLOAT3& v)
+        {
+            float a = NodeWeight(node);
+            PoseBlock& b = blocks[node / PoseBlock::Width];
+            size_t lane = node % PoseBlock::Width;
+            b.sx[lane] += v.x * a;
+            b.sy[lane] += v.y * a;
+            b.sz[lane] += v.z * a;
+            weights[node * 4 + 2] += a;
+        }
+    };
+
+    Accumulator accumulator{ m_pose.GetBlocks(), m_accumWeights.data(), weight, mask };
+    VisitClip(clip, clipIndex, time, cursors, accumulator);
+}
+
+// 加算を終了する関数
+void Imase::Animator::EndAccumulate()
+{
+    auto& blocks = m_pose.GetBlocks();
+    const auto& bindBlocks = m_bindPose.GetBlocks();
+
+    for (uint32_t i : m_animatedNodes)
+    {
+        PoseBlock& b = blocks[i / PoseBlock::Width];
+        const PoseBlock& bind = bindBlocks[i / PoseBlock::Width];
+        size_t lane = i % PoseBlock::Width;
+        const float* w = &m_accumWeights[i * 4];
+
+        float total = w[3];
+        if (total <= WeightEpsilon)
+        {
+            m_pose.SetTranslation(i, m_bindPose.GetTranslation(i));
+            m_pose.SetRotation(i, m_bindPose.GetRotation(i));
+            m_pose.SetScale(i, m_bindPose.GetScale(i));
+            continue;
+        }
+
+        // クリップが動かさない分の重みは初期ポーズの値にする
+        float inv = 1.0f / total;
+        float restT = total - w[0];
+        float restR = total - w[1];
+        float restS = total - w[2];
+
+        b.tx[lane] = (b.tx[lane] + bind.tx[lane] * restT) * inv;
+        b.ty[lane] = (b.ty[lane] + bind.ty[lane] * restT) * inv;
+        b.tz[lane] = (b.tz[lane] + bind.tz[lane] * restT) * inv;
+
+        b.sx[lane] = (b.sx[lane] + bind.sx[lane] * restS) * inv;
+        b.sy[lane] = (b.sy[lane] + bind.sy[lane] * restS) * inv;
+        b.sz[lane] = (b.sz[lane] + bind.sz[lane] * restS) * inv;
+
+        float dot = b.rx[lane] * bind.rx[lane] + b.ry[lane] * bind.ry[lane] + b.rz[lane] * bind.rz[lane] + b.rw[lane] * bind.rw[lane];
+        if (dot < 0.0f) restR = -restR;
+
+        XMVECTOR r = XMVectorSet(
+            b.rx[lane] + bind.rx[lane] * restR,
+            b.ry[lane] + bind.ry[lane] * restR,
+            b.rz[lane] + bind.rz[lane] * restR,
+            b.rw[lane] + bind.rw[lane] * restR);
+
+        XMFLOAT4 q;
+        XMStoreFloat4(&q, XMQuaternionNormalize(r));
+        m_pose.SetRotation(i, q);
     }
+}
 
-    // XP[
-    for (const auto& ch : clip.scales)
+// クリップの初期ポーズからの差分を加える関数
+void Imase::Animator::ApplyAdditiveClip(const AnimationClip& clip, int clipIndex, float time, float weight, const float* mask, std::vector<uint32_t>& cursors)
+{
+    if (weight <= WeightEpsilon) return;
+
+    struct Additive
     {
-        outPose.transforms[ch.nodeIndex].scale = SampleVec3(ch, time);
+        AnimationPose& pose;
+        const AnimationPose& bindPose;
+        float weight;
+        const float* mask;
+
+        float NodeWeight(uint32_t node) const { return mask ? weight * mask[node] : weight; }
+
+        void Translation(uint32_t node, const XMFLOAT3& v)
+        {
+            XMFLOAT3 bind = bindPose.GetTranslation(node);
+            XMVECTOR delta = XMVectorSubtract(XMLoadFloat3(&v), XMLoadFloat3(&bind));
+            XMFLOAT3 t = pose.GetTranslation(node);
+            XMStoreFloat3(&t, XMVectorMultiplyAdd(delta, XMVectorReplicate(NodeWeight(node)), XMLoadFloat3(&t)));
+            pose.SetTranslation(node, t);
+        }
+
+        void Rotation(uint32_t node, const XMFLOAT4& v)
+        {
+            XMFLOAT4 bind = bindPose.GetRotation(node);
+            XMFLOAT4 current = pose.GetRotation(node);
+
+            // 初期ポーズからの差分の回転（短い方の回り方にして重みの割合だけ回す）
+            XMVECTOR delta = XMQuaternionMultiply(XMQuaternionInverse(XMLoadFloat4(&bind)), XMLoadFloat4(&v));
+            if (XMVectorGetW(delta) < 0.0f) delta = XMVectorNegate(delta);
+            delta = XMQuaternionNormalize(XMVectorLerp(XMQuaternionIdentity(), delta, NodeWeight(node)));
+
+            XMStoreFloat4(&current, XMQuaternionMultiply(delta, XMLoadFloat4(&current)));
+            pose.SetRotation(node, current);
+        }
+
+        void Scale(uint32_t node, const XMFLOAT3& v)
+        {
+            XMFLOAT3 bind = bindPose.GetScale(node);
+            XMVECTOR delta = XMVectorSubtract(XMLoadFloat3(&v), XMLoadFloat3(&bind));
+            XMFLOAT3 s = pose.GetScale(node);
+            XMStoreFloat3(&s, XMVectorMultiplyAdd(delta, XMVectorReplicate(NodeWeight(node)), XMLoadFloat3(&s)));
+            pose.SetScale(node, s);
+        }
+    };
+
+    Additive additive{ m_pose, m_bindPose, weight, mask };
+    VisitClip(clip, clipIndex, time, cursors, additive);
+}
+
+// ブレンドツリーの再生位置と重みを更新する関数
+void Imase::Animator::UpdateBlendTree(float elapsedTime)
+{
+    // 一時停止中は再生位置を進めない
+    if (!m_blendTree || m_paused) return;
+
+    for (auto& layer : m_blendTree->GetLayers())
+    {
+        const auto& samples = layer.space.GetSamples();
+        if (samples.empty()) continue;
+
+        // サンプル数が変わった時だけ作り直す
+        if (layer.sampleWeights.size() != samples.size())
+        {
+            layer.sampleWeights.assign(samples.size(), 0.0f);
+            layer.keyCursors.resize(samples.size());
+        }
+        layer.space.ComputeWeights(layer.sampleWeights.data());
+
+        // 重みで平均した長さで再生位置を進める（歩きと走りなどの歩調が揃う）
+        float duration = 0.0f;
+        for (size_t i = 0; i < samples.size(); i++)
+        {
+            if (const AnimationClip* clip = m_model.GetAnimation(samples[i].clipIndex))
+            {
+                duration += clip->duration * layer.sampleWeights[i];
+            }
+        }
+
+        if (duration <= 0.0f)
+        {
+            layer.phase = 0.0f;
+            continue;
+        }
+
+        layer.phase += elapsedTime / duration;
+        if (layer.loop)
+        {
+            layer.phase -= std::floor(layer.phase);
+        }
+        else
+        {
+            layer.phase = std::clamp(layer.phase, 0.0f, 1.0f);
+        }
     }
 }
 
-// em[h̃[Js𐶐֐
-void Imase::Animator::BuildLocalMatrices()
+// ブレンドツリーを評価する関数
+void Imase::Animator::EvaluateBlendTree()
 {
-    for (size_t i = 0; i < m_currentPoseState.m_pose.transforms.size(); i++)
+    if (!m_blendTree)
     {
-        Transform& transform = m_currentPoseState.m_pose.transforms[i];
+        ResetPoseToBind(m_pose);
+        return;
+    }
+
+    auto& layers = m_blendTree->GetLayers();
+
+    // 上書きレイヤーを下から順に加算する
+    BeginAccumulate();
+    for (auto& layer : layers)
+    {
+        if (layer.mode != BlendLayer::Mode::Override || layer.weight <= 0.0f) continue;
+
+        const auto& samples = layer.space.GetSamples();
+        if (layer.sampleWeights.size() != samples.size()) continue;
+
+        const float* mask = layer.mask ? layer.mask->weights.data() : nullptr;
+        BeginLayer(layer.weight, mask);
+
+        for (size_t i = 0; i < samples.size(); i++)
+        {
+            const AnimationClip* clip = m_model.GetAnimation(samples[i].clipIndex);
+            if (!clip) continue;
 
-        XMVECTOR t = XMLoadFloat3(&transform.translation);
-        XMVECTOR r = XMLoadFloat4(&transform.rotation);
-        XMVECTOR s = XMLoadFloat3(&transform.scale);
+            // レイヤー内の重みの合計は 1 なので、加算した重みの合計は BeginLayer で加えた重みと一致する
+            AccumulateClip(*clip, samples[i].clipIndex, layer.phase * clip->duration, layer.weight * layer.sampleWeights[i], mask, layer.keyCursors[i]);
+        }
+    }
+    EndAccumulate();
+
+    // 加算レイヤー
+    for (auto& layer : layers)
+    {
+        if (layer.mode != BlendLayer::Mode::Additive || layer.weight <= 0.0f) continue;
 
-        XMMATRIX M = XMMatrixScalingFromVector(s) * XMMatrixRotationQuaternion(r) *  XMMatrixTranslationFromVector(t);
+        const auto& samples = layer.space.GetSamples();
+        if (layer.sampleWeights.size() != samples.size()) continue;
 
-        XMStoreFloat4x4(&m_localMatrices[i], M);
+        const float* mask = layer.mask ? layer.mask->weights.data() : nullptr;
+
+        for (size_t i = 0; i < samples.size(); i++)
+        {
+            const AnimationClip* clip = m_model.GetAnimation(samples[i].clipIndex);
+            if (!clip) continue;
+
+            ApplyAdditiveClip(*clip, samples[i].clipIndex, layer.phase * clip->duration, layer.weight * layer.sampleWeights[i], mask, layer.keyCursors[i]);
+        }
     }
 }
 
-// em[h̃[hsvZ֐
+// 各ノードのローカル行列を生成する関数
+void Imase::Animator::BuildLocalMatrices(const AnimationPose& pose)
+{
+    // 動くノードを含むブロックだけ4ノードずつ計算
+    Imase::BuildLocalMatrices(pose, m_animatedBlocks, m_localMatrices.data());
+}
+
+// 各ノードのワールド行列を計算する関数
 void Imase::Animator::BuildWorldMatrices()
 {
     for (size_t i = 0; i < m_nodes.size(); i++)
     {
-        int parent = m_nodes[i].parentIndex;
+        BuildWorldMatrix(i);
+    }
+}
 
-        XMMATRIX local = XMLoadFloat4x4(&m_localMatrices[i]);
+// 指定したノードのワールド行列を計算する関数（親のワールド行列は計算済みであること）
+void Imase::Animator::BuildWorldMatrix(size_t node)
+{
+    int parent = m_nodes[node].parentIndex;
 
-        if (parent >= 0)
-        {
-            XMMATRIX parentWorld = XMLoadFloat4x4(&m_worldMatrices[parent]);
-            local = local * parentWorld;
-        }
+    XMMATRIX local = XMLoadFloat4x4(&m_localMatrices[node]);
 
-        XMStoreFloat4x4(&m_worldMatrices[i], local);
+    if (parent >= 0)
+    {
+        XMMATRIX parentWorld = XMLoadFloat4x4(&m_worldOutput[parent]);
+        local = local * parentWorld;
     }
+
+    XMStoreFloat4x4(&m_worldOutput[node], local);
 }
 
-// |[Ỹuh֐
-void Imase::Animator::BlendPose(const Pose& a, const Pose& b, float weight, Pose& outPose)
+// 再生中のクリップが変わった場合に動くノードを調べ直す関数
+void Imase::Animator::UpdateActiveNodes()
 {
-    size_t count = a.transforms.size();
+    // 再生中のクリップを集める
+    m_activeClipsWork.clear();
+    if (m_playMode == PlayMode::BlendTree)
+    {
+        if (m_blendTree)
+        {
+            for (const auto& layer : m_blendTree->GetLayers())
+            {
+                for (const auto& sample : layer.space.GetSamples())
+                {
+                    m_activeClipsWork.push_back(sample.clipIndex);
+                }
+            }
+        }
+    }
+    else
+    {
+        m_activeClipsWork.push_back(m_currentPoseState.m_clipIndex);
+        if (m_playMode == PlayMode::Blend)
+        {
+            m_activeClipsWork.push_back(m_nextPoseState.m_clipIndex);
+        }
+    }
+    std::sort(m_activeClipsWork.begin(), m_activeClipsWork.end());
+    m_activeClipsWork.erase(std::unique(m_activeClipsWork.begin(), m_activeClipsWork.end()), m_activeClipsWork.end());
+
+    // 変わっていなければ何もしない
+    if (m_activeClipsWork == m_activeClips && m_activeNodeMask == m_nodeMask) return;
 
-    outPose.transforms.resize(count);
+    m_activeClips.swap(m_activeClipsWork);
+    m_activeNodeMask = m_nodeMask;
 
-    for (size_t i = 0; i < count; ++i)
+    // クリップのチャンネルが対象にしているノード（サンプリングしないノードは除く）
+    std::fill(m_nodeStates.begin(), m_nodeStates.end(), static_cast<uint8_t>(0));
+    for (int clipIndex : m_activeClips)
     {
-        // Translation
-        XMVECTOR tA = XMLoadFloat3(&a.transforms[i].translation);
-        XMVECTOR tB = XMLoadFloat3(&b.transforms[i].translation);
-        XMVECTOR t = XMVectorLerp(tA, tB, weight);
-        XMStoreFloat3(&outPose.transforms[i].translation, t);
+        const std::vector<uint32_t>* nodes = m_model.GetAnimatedNodes(static_cast<uint32_t>(clipIndex));
+        if (!nodes) continue;
 
-        // Scale
-        XMVECTOR sA = XMLoadFloat3(&a.transforms[i].scale);
-        XMVECTOR sB = XMLoadFloat3(&b.transforms[i].scale);
-        XMVECTOR s = XMVectorLerp(sA, sB, weight);
-        XMStoreFloat3(&outPose.transforms[i].scale, s);
+        for (uint32_t node : *nodes)
+        {
+            if (!m_nodeMask || m_nodeMask[node]) m_nodeStates[node] = 1;
+        }
+    }
 
-        // Rotation
-        XMVECTOR rA = XMLoadFloat4(&a.transforms[i].rotation);
-        XMVECTOR rB = XMLoadFloat4(&b.transforms[i].rotation);
+    // 親が動くノードはワールド行列だけ計算し直す（親は子より前に並んでいる）
+    m_animatedNodes.clear();
+    m_animatedBlocks.clear();
+    m_dirtyNodes.clear();
+    for (uint32_t i = 0; i < m_nodes.size(); i++)
+    {
+        int parent = m_nodes[i].parentIndex;
+        if (m_nodeStates[i] == 0 && parent >= 0 && m_nodeStates[parent] != 0)
+        {
+            m_nodeStates[i] = 2;
+        }
 
-        // NH[^jI̕Ԃ̍ŒZ̑I
-        if (XMVectorGetX(XMVector4Dot(rA, rB)) < 0.0f)
+        if (m_nodeStates[i] == 1)
         {
-            // ςOȉȂ̂ŕЕ̃NH[^jI𔽓]
-            rB = XMVectorNegate(rB);
+            m_animatedNodes.push_back(i);
+
+            uint32_t block = i / PoseBlock::Width;
+            if (m_animatedBlocks.empty() || m_animatedBlocks.back() != block)
+            {
+                m_animatedBlocks.push_back(block);
+            }
         }
 
-        // ʐ`
-        XMVECTOR r = XMQuaternionSlerp(rA, rB, weight);
-        XMStoreFloat4(&outPose.transforms[i].rotation, r);
+        if (m_nodeStates[i] != 0)
+        {
+            m_dirtyNodes.push_back(i);
+        }
     }
+
+    // 前のクリップで動かしたノードを初期ポーズへ戻して、全ての行列を作り直す
+    ResetPoseToBind(m_pose);
+    m_previousPoseValid = false;
+    m_rebuildAll = true;
 }
 
-// ĐԂi߂֐
+// 再生時間を進める関数
 void Imase::Animator::UpdateTime(float elapsedTime)
 {
+    // 一時停止中は時間を進めない
+    if (m_paused) return;
+
     m_currentPoseState.m_time += elapsedTime;
 
     const AnimationClip* clipA = m_model.GetAnimation(m_currentPoseState.m_clipIndex);
@@ -385,7 +1067,7 @@ void Imase::Animator::UpdateTime(float elapsedTime)
         return;
     }
 
-    // Aj[V̒𒴂̎Ԃ̏
+    // アニメーションの長さを超えた時の時間の処理
     if (clipA->duration > 0.0f)
     {
         if (m_loop)
@@ -404,7 +1086,7 @@ void Imase::Animator::UpdateTime(float elapsedTime)
         m_currentPoseState.m_time = 0.0f;
     }
 
-    // ----- uh ----- //
+    // ----- ブレンド ----- //
     if (m_playMode == PlayMode::Blend)
     {
         const AnimationClip* clipB = m_model.GetAnimation(m_nextPoseState.m_clipIndex);
@@ -414,7 +1096,7 @@ void Imase::Animator::UpdateTime(float elapsedTime)
             return;
         }
 
-        // Ԃi߂
+        // 時間を進める
         m_nextPoseState.m_time += elapsedTime;
 
         if (clipB->duration > 0.0f)
@@ -422,7 +1104,7 @@ void Imase::Animator::UpdateTime(float elapsedTime)
             m_nextPoseState.m_time = fmod(m_nextPoseState.m_time, clipB->duration);
         }
 
-        // uh̊Zo
+        // ブレンドの割合を算出
         m_blendTimer += elapsedTime;
 
         if (m_blendDuration <= 0.0f)
@@ -435,12 +1117,13 @@ void Imase::Animator::UpdateTime(float elapsedTime)
             m_blendWeight = std::clamp(m_blendWeight, 0.0f, 1.0f);
         }
 
-        // ̃Aj[Vֈڍs
+        // 次のアニメーションへ移行完了
         if (m_blendWeight >= 1.0f)
         {
-            // ̃Aj[V
+            // 次のアニメーションへ
             m_currentPoseState.m_clipIndex = m_nextPoseState.m_clipIndex;
             m_currentPoseState.m_time = m_nextPoseState.m_time;
+            m_currentPoseState.m_keyCursors.swap(m_nextPoseState.m_keyCursors);
             m_playMode = PlayMode::Single;
 
             m_nextPoseState.m_clipIndex = -1;
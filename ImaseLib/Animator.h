@@ -1,14 +1,21 @@
 //--------------------------------------------------------------------------------------
 // File: Animator.h
 //
-// Aj[V̍ĐǗNX
+// アニメーションの再生を管理するクラス
 //
 // Date: 2026.3.3
 // Author: Hideyasu Imase
 //--------------------------------------------------------------------------------------
 #pragma once
 
-#include "Model.h"
+#include "ModelAnimationData.h"
+#include "AnimationPose.h"
+#include "AnimationBlendTree.h"
+#include "PoseCache.h"
+#include "AnimationProfile.h"
+
+#include <string>
+#include <unordered_map>
 
 namespace Imase
 {
@@ -19,152 +26,301 @@ namespace Imase
 
         enum class PlayMode
         {
-            Single,     // PĐ
-            Blend       // uhĐ
+            Single,     // 単一再生
+            Blend,      // ブレンド再生
+            BlendTree   // ブレンドツリー再生
         };
 
     private:
 
-        // ړA]AXP[܂Ƃ߂\
-        struct Transform
-        {
-            DirectX::XMFLOAT3 translation;
-            DirectX::XMFLOAT4 rotation;
-            DirectX::XMFLOAT3 scale;
-        };
-
-        // f̃|[Y\
-        struct Pose
-        {
-            std::vector<Transform> transforms;
-        };
-
-        // Aj[VXe[g
+        // アニメーションステート
         struct AnimationState
         {
-            // Aj[VNbvCfbNX
+            // アニメーションクリップインデックス
             int m_clipIndex = -1;
 
-            // ĐAj[VNbv̎
+            // 再生アニメーションクリップの時間
             float m_time = 0.0f;
 
-            // p
-            Pose m_pose;
+            // チャンネル毎の前回のキー位置（移動、回転、スケールの順）
+            std::vector<uint32_t> m_keyCursors;
         };
 
-        // fւ̎Q
-        const Imase::Model& m_model;
+        // モデルへの参照
+        const Imase::ModelAnimationData& m_model;
 
-        // m[hւ̎Q
+        // ノード情報への参照
         const std::vector<NodeInfo>& m_nodes;
         
-        // AjVNbvƃCfbNX̑Ή\iOCfbNXj
+        // アニメションクリップ名とインデックスの対応表（名前→インデックス）
         std::unordered_map<std::string, int> m_animationIndexTable;
 
-        // AjVNbvƃCfbNX̑Ή\iCfbNXOj
+        // アニメションクリップ名とインデックスの対応表（インデックス→名前）
         std::unordered_map<int, std::string> m_animationNameTable;
 
-        // Đ[h
+        // 再生モード
         PlayMode m_playMode;
 
-        // [viON/OFF)
+        // ループ（ON/OFF)
         bool m_loop;
 
-        // ݂̎p
+        // 初期ポーズ
+        AnimationPose m_bindPose;
+
+        // 姿勢（ブレンド時は各クリップの値をここへ直接加算する）
+        AnimationPose m_pose;
+
+        // ブレンド時のノード毎の加算した重み（移動、回転、スケール、レイヤーの合計の順）
+        std::vector<float> m_accumWeights;
+
+        // 加算済みのレイヤーがあるか
+        bool m_accumulated;
+
+        // ブレンドツリー
+        BlendTree* m_blendTree;
+
+        // 前回更新した姿勢（更新間隔を空ける場合に補間するため）
+        AnimationPose m_previousPose;
+
+        // 前回の姿勢が有効か
+        bool m_previousPoseValid;
+
+        // 補間した姿勢
+        AnimationPose m_interpolatedPose;
+
+        // サンプリングするノード（nullptr なら全て、0 のノードは初期ポーズのまま）
+        const uint8_t* m_nodeMask;
+
+        // ----- 動くノードだけ計算するための情報（再生中のクリップが変わった時に作り直す） ----- //
+
+        // 再生中のクリップ（昇順）
+        std::vector<int> m_activeClips;
+
+        // 再生中のクリップの作業用
+        std::vector<int> m_activeClipsWork;
+
+        // 動くノードを調べた時のサンプリングするノード
+        const uint8_t* m_activeNodeMask;
+
+        // ノード毎の状態（0:変化しない、1:アニメーションで動く、2:親が動く）
+        std::vector<uint8_t> m_nodeStates;
+
+        // アニメーションで動くノード
+        std::vector<uint32_t> m_animatedNodes;
+
+        // アニメーションで動くノードを含むブロック（4ノード毎）
+        std::vector<uint32_t> m_animatedBlocks;
+
+        // ワールド行列を計算し直すノード（動くノードとその子孫、親から順）
+        std::vector<uint32_t> m_dirtyNodes;
+
+        // 全てのノードの行列を作り直す必要があるか
+        bool m_rebuildAll;
+
+        // 前回サンプリングしたクリップと時間（同じなら姿勢の更新を省く）
+        int m_sampledClipIndex;
+        float m_sampledTime;
+
+        // 一時停止
+        bool m_paused;
+
+        // 一時停止中にブレンドとブレンドツリーの姿勢を作成済みか（作成済みなら同じ姿勢なので更新を省く）
+        bool m_pausedPoseValid;
+
+        // 姿勢を共有するキャッシュ（nullptr なら使わない）
+        PoseCache* m_poseCache;
+
+        // キャッシュから取得した姿勢（BuildMatrices でワールド行列をコピーする）
+        const PoseCache::Entry* m_cacheHitEntry;
+
+        // キャッシュへ書き込むエントリー（BuildMatrices で書き込む）
+        PoseCache::Entry* m_cacheFillEntry;
+
+        // 処理時間の計測（nullptr なら計測しない）
+        AnimationProfile* m_profile;
+
+        // 回転の補間方式（キーのサンプリングと前回の姿勢からの補間に使う）
+        RotationInterpolation m_rotationInterpolation;
+
+        // 計測中のチャンネルのサンプリング回数とキー位置が飛んだ回数（UpdatePose の最後に加算する）
+        uint32_t m_channelSampleCount;
+        uint32_t m_keyCursorJumpCount;
+
+        // 現在の姿勢
         AnimationState m_currentPoseState;
 
-        // ̎p
+        // 次の姿勢
         AnimationState m_nextPoseState;
 
-        // uhԊu
+        // ブレンド間隔
         float m_blendDuration;
 
-        // uhp^C}[
+        // ブレンド用タイマー
         float m_blendTimer;
 
-        // uhpEGCg
+        // ブレンド用ウエイト
         float m_blendWeight;
  
-        // em[h̃[Js
+        // 各ノードのローカル行列
         std::vector<DirectX::XMFLOAT4X4> m_localMatrices;
 
-        // em[h̃[hs
+        // 各ノードのワールド行列
         std::vector<DirectX::XMFLOAT4X4> m_worldMatrices;
 
+        // ワールド行列の出力先（通常は m_worldMatrices、AnimationSystem では共有の配列）
+        DirectX::XMFLOAT4X4* m_worldOutput;
+
     private:
 
-        // Aj[V`lw莞Ԃ̒l擾֐i`ԁFړAXP[p)
-        DirectX::XMFLOAT3 SampleVec3(const Imase::AnimationChannelVec3& ch, float time);
+        // 指定時間を含むキーの区間を探す関数（times[i] <= time < times[i + 1] となる i を返す）
+        // 通常の再生では前回の位置から前へ進めるだけで済み、時間が戻った場合は二分探索する
+        static size_t FindKey(const std::vector<float>& times, float time, uint32_t& cursor);
+
+        // アニメーションチャンネルから指定時間の値を取得する関数（線形補間：移動、スケール用)
+        DirectX::XMFLOAT3 SampleVec3(const Imase::AnimationChannelVec3& ch, float time, uint32_t& cursor);
 
-        // Aj[V`lw莞Ԃ̒l擾֐iʐ`ԁF]p)
-        DirectX::XMFLOAT4 SampleQuat(const Imase::AnimationChannelQuat& ch, float time);
+        // アニメーションチャンネルから指定時間の値を取得する関数（球面線形補間：回転用)
+        DirectX::XMFLOAT4 SampleQuat(const Imase::AnimationChannelQuat& ch, float time, uint32_t& cursor);
         
-        // |[YփZbg֐
-        void ResetPoseToBind(Pose& pose);
+        // 初期ポーズへリセットする関数
+        void ResetPoseToBind(AnimationPose& pose);
+
+        // 再生中のクリップが変わった場合に動くノードを調べ直す関数
+        void UpdateActiveNodes();
+
+        // クリップの各チャンネルの指定時間の値を visitor に渡す関数
+        template <class Visitor>
+        void VisitClip(const AnimationClip& clip, int clipIndex, float time, std::vector<uint32_t>& cursors, Visitor& visitor);
+
+        // 各ノードの移動、回転、スケールを計算する関数
+        void SamplePose(const AnimationClip& clip, float time, AnimationState& state);
+
+        // ----- ブレンド（各クリップの値を姿勢へ直接加算する） ----- //
+
+        // 加算を開始する関数
+        void BeginAccumulate();
+
+        // レイヤーを開始する関数（下のレイヤーを 1 - weight の割合に縮める）
+        void BeginLayer(float weight, const float* mask);
+
+        // クリップの値を重み付きで加算する関数
+        void AccumulateClip(const AnimationClip& clip, int clipIndex, float time, float weight, const float* mask, std::vector<uint32_t>& cursors);
+
+        // 加算を終了する関数（重みで割り、クリップが動かさない分は初期ポーズで埋める）
+        void EndAccumulate();
+
+        // クリップの初期ポーズからの差分を加える関数
+        void ApplyAdditiveClip(const AnimationClip& clip, int clipIndex, float time, float weight, const float* mask, std::vector<uint32_t>& cursors);
 
-        // em[ḧړA]AXP[vZ֐
-        void SamplePose(const AnimationClip& clip, float time, Pose& outPose);
+        // ブレンドツリーの再生位置と重みを更新する関数
+        void UpdateBlendTree(float elapsedTime);
 
-        // em[h̃[Jsݒ肷֐
-        void BuildLocalMatrices();
+        // ブレンドツリーを評価する関数
+        void EvaluateBlendTree();
 
-        // em[h̃[hsݒ肷֐
+        // 各ノードのローカル行列を設定する関数
+        void BuildLocalMatrices(const AnimationPose& pose);
+
+        // 各ノードのワールド行列を設定する関数
         void BuildWorldMatrices();
 
-        // |[Ỹuh֐
-        void BlendPose(const Pose& a, const Pose& b, float weight, Pose& outPose);
+        // 指定したノードのワールド行列を設定する関数
+        void BuildWorldMatrix(size_t node);
 
-        // ĐԂi߂֐
+        // 再生時間を進める関数
         void UpdateTime(float elapsedTime);
 
     public:
 
-        // RXgN^
-        Animator(const Imase::Model& model);
+        // コンストラクタ
+        Animator(const Imase::ModelAnimationData& model);
 
-        // fXgN^
+        // デストラクタ
         virtual ~Animator() = default;
 
-        // XV
+        // 更新
         void Update(float elapsedTime);
 
-        // em[h̃[hs擾֐
-        const std::vector<DirectX::XMFLOAT4X4>& GetWorldMatrices() const;
+        // 姿勢だけを更新する関数（行列は作らない、再生中のクリップが無ければ false）
+        // keepPreviousPose が true なら更新前の姿勢を残し、BuildMatrices で補間できるようにする
+        bool UpdatePose(float elapsedTime, bool keepPreviousPose = false);
+
+        // 姿勢からワールド行列を作成する関数（alpha が 1 未満なら前回の姿勢から補間する）
+        void BuildMatrices(float alpha = 1.0f);
+
+        // サンプリングするノードを設定する関数（ノード数分、0 のノードは初期ポーズのまま、nullptr で全て）
+        void SetNodeMask(const uint8_t* mask) { m_nodeMask = mask; }
+
+        // 各ノードのワールド行列を取得する関数
+        std::span<const DirectX::XMFLOAT4X4> GetWorldMatrices() const;
 
-        // Aj[VAj[VCfbNXŎ擾֐
+        // ワールド行列の出力先を設定する関数（ノード数分の領域が必要、nullptr で内部の配列に戻す）
+        void SetWorldMatrixBuffer(DirectX::XMFLOAT4X4* buffer);
+
+        // モデルを取得する関数
+        const Imase::ModelAnimationData& GetModel() const { return m_model; }
+
+        // アニメーション名をアニメーションインデックス順で取得する関数
         const std::vector<std::string> GetAnimationNames() const;
 
         // ------------------------------------------------------------------- //
         
-        // Đ
+        // 再生
         void Play(std::string animationName, bool loop = true);
         void Play(int animationIndex, bool loop = true);
 
-        // ̃Aj[Vւ̃NXtF[h֐
+        // 次のアニメーションへのクロスフェードする関数
         void CrossFade(std::string nextAnimationName, float duration);
         void CrossFade(int animationIndex, float duration);
 
+        // 一時停止する関数（停止中は姿勢の更新を省く）
+        void SetPaused(bool paused) { m_paused = paused; m_pausedPoseValid = false; }
+
+        // 一時停止中か調べる関数
+        bool IsPaused() const { return m_paused; }
+
+        // 姿勢を共有するキャッシュを設定する関数（単一再生のみ、nullptr で使わない）
+        void SetPoseCache(PoseCache* cache) { m_poseCache = cache; }
+
+        // 処理時間を計測する関数（nullptr で計測しない）
+        void SetProfile(AnimationProfile* profile) { m_profile = profile; }
+
+        // 回転の補間方式を設定する関数（既定は Slerp、姿勢のキャッシュは方式が同じアニメーター同士でだけ共有される）
+        void SetRotationInterpolation(RotationInterpolation mode) { m_rotationInterpolation = mode; }
+
+        // 回転の補間方式を取得する関数
+        RotationInterpolation GetRotationInterpolation() const { return m_rotationInterpolation; }
+
+        // ブレンドツリーを再生する関数（ブレンドツリーは再生中に存在すること）
+        void PlayBlendTree(BlendTree* blendTree);
+
+        // 再生中のブレンドツリーを取得する関数
+        BlendTree* GetBlendTree() const { return m_blendTree; }
+
         // ------------------------------------------------------------------- //
 
-        // AjVCfbNX擾֐
+        // アニメションインデックスを取得する関数
         int GetAnimationIndex(std::string animationName);
 
-        // Aj[V擾֐
+        // アニメーション名を取得する関数
         std::string GetAnimationName(int animationIndex);
 
-        // Aj[V̒ivԁj擾֐
+        // アニメーションの長さ（所要時間）を取得する関数
         float GetAnimationDuration(int animationIndex) const;
 
         // ------------------------------------------------------------------- //
 
-        // ĐԂ擾֐
+        // 再生時間を取得する関数
         float GetPlayTime() const;
 
-        // Aj[V̏I܂ł̎c莞Ԃ擾֐
+        // アニメーションの終了するまでの残り時間を取得する関数
         float GetRestTime() const;
 
-        // Đ̃AjVCfbNX擾֐
-        int GetCurrentAnimationIndex();
+        // 再生中のアニメションインデックスを取得する関数
+        int GetCurrentAnimationIndex() const;
+
+        // ブレンド先のアニメションインデックスを取得する関数（ブレンド中でなければ -1）
+        int GetNextAnimationIndex() const;
 
     };
 
@@ -0,0 +1,207 @@
+//--------------------------------------------------------------------------------------
+// File: AssetCache.cpp
+//
+// ロード済みのモデルを共有するキャッシュクラス
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "pch.h"
+#include "AssetCache.h"
+#include "ContentHash.h"
+
+#include <bit>
+
+using namespace Imase;
+
+// コンストラクタ
+Imase::AssetCache::AssetCache()
+	: m_registry{ std::make_shared<Registry>() }
+{
+}
+
+// ロードオプションからキーに使う値を作成する関数
+uint64_t Imase::AssetCache::GetOptionBits(const Imase::ImdlLoadOptions& options)
+{
+	// parallelDecode、collectStats は結果に影響しないので含めない
+	uint32_t bits = 0;
+	if (options.packVertices) bits |= 1 << 0;
+	if (options.quantizePositions) bits |= 1 << 1;
+	if (options.optimizeMesh) bits |= 1 << 2;
+	bits |= options.vertexCacheSize << 8;
+
+	// 焼き込むレートはビット列のまま使う（0 以下は焼き込まないので全て 0 にする）
+	float bakeSampleRate = options.bakeSampleRate > 0.0f ? options.bakeSampleRate : 0.0f;
+	uint64_t bakeBits = std::bit_cast<uint32_t>(bakeSampleRate);
+
+	return (bakeBits << 32) | bits;
+}
+
+// ファイルの内容のハッシュ値を取得する関数
+bool Imase::AssetCache::GetContentHash(const std::wstring& fname, uint64_t& hash)
+{
+	// サイズと更新日時が前回と同じなら計算済みの値を使う（取得できなければ毎回計算する）
+	std::error_code ec;
+	uintmax_t size = std::filesystem::file_size(fname, ec);
+	std::filesystem::file_time_type writeTime{};
+	if (!ec)
+	{
+		writeTime = std::filesystem::last_write_time(fname, ec);
+	}
+	bool stamped = !ec;
+
+	if (stamped)
+	{
+		std::lock_guard<std::mutex> lock(m_registry->mutex);
+
+		auto it = m_registry->hashes.find(fname);
+		if (it != m_registry->hashes.end() && it->second.size == size && it->second.writeTime == writeTime)
+		{
+			hash = it->second.hash;
+			return true;
+		}
+	}
+
+	// ファイルの内容のハッシュ値を計算（パスが違っても内容が同じなら共有する）
+	{
+		MappedFile file;
+		if (!file.Open(fname))
+		{
+			return false;
+		}
+		hash = ComputeContentHash(std::span<const uint8_t>(file.Data(), file.Size()));
+	}
+
+	if (stamped)
+	{
+		std::lock_guard<std::mutex> lock(m_registry->mutex);
+		m_registry->hashes[fname] = { size, writeTime, hash };
+	}
+
+	return true;
+}
+
+// モデルを取得する関数
+std::shared_ptr<Imase::Model> Imase::AssetCache::LoadModel(
+	ID3D11Device* device,
+	const std::wstring& fname,
+	Imase::Effect* pEffect,
+	const Imase::ImdlLoadOptions& options
+)
+{
+	uint64_t hash = 0;
+	if (!GetContentHash(fname, hash))
+	{
+		OutputDebugString(L"Failed to load IMDL file.\n");
+		return nullptr;
+	}
+
+	Key key{ hash, pEffect, GetOptionBits(options) };
+
+	std::promise<std::shared_ptr<Model>> promise;
+	{
+		std::unique_lock<std::mutex> lock(m_registry->mutex);
+
+		Entry& entry = m_registry->models[key];
+
+		// キャッシュにあればそれを返す（エフェクトへの登録はロックの外で行う）
+		if (auto model = entry.model.lock())
+		{
+			m_registry->stats.hits++;
+			lock.unlock();
+			model->RegisterToEffect();
+			return model;
+		}
+
+		// 他のスレッドが作成中なら完了を待つ
+		if (entry.pending.valid())
+		{
+			std::shared_future<std::shared_ptr<Model>> pending = entry.pending;
+			m_registry->stats.hits++;
+			lock.unlock();
+			std::shared_ptr<Model> model = pending.get();
+			if (model) model->RegisterToEffect();
+			return model;
+		}
+
+		entry.pending = promise.get_future().share();
+	}
+
+	// 作成中でなくなったので要素を更新する関数（失敗した場合は取り除く）
+	auto finish = [this, &key](const std::shared_ptr<Model>& model)
+		{
+			std::lock_guard<std::mutex> lock(m_registry->mutex);
+
+			auto it = m_registry->models.find(key);
+			if (model)
+			{
+				it->second.model = model;
+				it->second.pending = {};
+				m_registry->stats.misses++;
+			}
+			else
+			{
+				m_registry->models.erase(it);
+			}
+		};
+
+	// 新たにロードする（ロックの外で作成するので他のモデルの取得を止めない）
+	// 作成中はエフェクトを変更しない（エフェクトはスレッドセーフではないので登録は最後に行う）
+	std::shared_ptr<Model> model;
+	try
+	{
+		std::unique_ptr<Model> created = Model::LoadFromImdl(device, fname, pEffect, options);
+		if (created)
+		{
+			// 最後の参照が解放された時点でキャッシュから取り除く
+			std::weak_ptr<Registry> registry = m_registry;
+			model = std::shared_ptr<Model>(created.release(), [registry, key](Model* p)
+				{
+					delete p;
+
+					if (auto r = registry.lock())
+					{
+						std::lock_guard<std::mutex> lock(r->mutex);
+						auto it = r->models.find(key);
+						if (it != r->models.end() && it->second.model.expired() && !it->second.pending.valid())
+						{
+							r->models.erase(it);
+							r->stats.evictions++;
+						}
+					}
+				});
+		}
+	}
+	catch (...)
+	{
+		// 待っているスレッドにも同じ例外を伝える
+		finish(nullptr);
+		promise.set_exception(std::current_exception());
+		throw;
+	}
+
+	finish(model);
+	promise.set_value(model);
+
+	// キャッシュから返す場合と同じく、呼び出し側のスレッドでエフェクトに登録する
+	if (model)
+	{
+		model->RegisterToEffect();
+	}
+
+	return model;
+}
+
+// キャッシュされているモデルの数を取得する関数
+size_t Imase::AssetCache::GetModelCount() const
+{
+	std::lock_guard<std::mutex> lock(m_registry->mutex);
+	return m_registry->models.size();
+}
+
+// 統計情報を取得する関数
+Imase::AssetCache::Stats Imase::AssetCache::GetStats() const
+{
+	std::lock_guard<std::mutex> lock(m_registry->mutex);
+	return m_registry->stats;
+}
@@ -0,0 +1,103 @@
+//--------------------------------------------------------------------------------------
+// File: AssetCache.h
+//
+// ロード済みのモデルを共有するキャッシュクラス
+//
+// 同じ内容のIMDLファイルは一度だけロードし、参照カウント付きで共有します
+// モデルの作成中もロックは保持しないので、他のモデルの取得を妨げません
+// ポーズなどインスタンス毎の状態は Animator が持つので、モデル自体は共有できます
+// 最後の参照が解放された時点でキャッシュからも取り除かれます
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include "Model.h"
+
+#include <filesystem>
+#include <future>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+namespace Imase
+{
+	class AssetCache
+	{
+	public:
+
+		// 統計情報
+		struct Stats
+		{
+			uint32_t hits = 0;		// キャッシュから返した回数
+			uint32_t misses = 0;	// 新たにロードした回数
+			uint32_t evictions = 0;	// 参照が無くなり取り除いた回数
+		};
+
+	private:
+
+		// キャッシュのキー（内容のハッシュ値、登録先のエフェクト、モデルの作り方に影響するオプション）
+		using Key = std::tuple<uint64_t, Imase::Effect*, uint64_t>;
+
+		// キャッシュの要素
+		struct Entry
+		{
+			// 共有中のモデル
+			std::weak_ptr<Model> model;
+
+			// 作成中のモデル（作成中に同じキーを要求したスレッドはこれを待つ）
+			std::shared_future<std::shared_ptr<Model>> pending;
+		};
+
+		// ファイル毎に計算済みの内容のハッシュ値（サイズと更新日時が同じなら読み直さない）
+		struct FileHash
+		{
+			uintmax_t size;
+			std::filesystem::file_time_type writeTime;
+			uint64_t hash;
+		};
+
+		// キャッシュ本体（モデルの解放時に参照するので共有ポインタで持つ）
+		struct Registry
+		{
+			std::mutex mutex;
+			std::map<Key, Entry> models;
+			std::map<std::wstring, FileHash> hashes;
+			Stats stats;
+		};
+
+		std::shared_ptr<Registry> m_registry;
+
+	private:
+
+		// ロードオプションからキーに使う値を作成する関数（上位32bitは焼き込みのレート）
+		static uint64_t GetOptionBits(const Imase::ImdlLoadOptions& options);
+
+		// ファイルの内容のハッシュ値を取得する関数（失敗した場合は false を返す）
+		bool GetContentHash(const std::wstring& fname, uint64_t& hash);
+
+	public:
+
+		// コンストラクタ
+		AssetCache();
+
+		// モデルを取得する関数（キャッシュに無ければロードする）
+		// 返すモデルのテクスチャとマテリアルは呼び出し側のスレッドでエフェクトに登録するので、
+		// 同じエフェクトを使う場合はそのエフェクトで描画するスレッドから呼び出すこと
+		// 失敗した場合は nullptr を返す
+		std::shared_ptr<Model> LoadModel(
+			ID3D11Device* device,
+			const std::wstring& fname,
+			Imase::Effect* pEffect,
+			const Imase::ImdlLoadOptions& options = {}
+		);
+
+		// キャッシュされているモデルの数を取得する関数
+		size_t GetModelCount() const;
+
+		// 統計情報を取得する関数
+		Stats GetStats() const;
+
+	};
+}
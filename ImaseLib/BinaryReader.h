@@ -1,9 +1,9 @@
 //--------------------------------------------------------------------------------------
 // File: BinaryReader.h
 //
-// f[^wTCỸf[^擾NX
+// データから指定サイズのデータを取得するクラス
 //
-// Ńf[^ǂݎƓǂݎʒuړĂ܂
+// ※内部でデータを読み取ると読み取り位置を移動しています
 //
 // Date: 2026.2.16
 // Author: Hideyasu Imase
@@ -18,14 +18,23 @@ namespace Imase
     {
     public:
 
-        // RXgN^
+        // コンストラクタ
         BinaryReader(const std::vector<uint8_t>& data)
-            : m_buffer(data)
+            : m_data(data.data())
+            , m_size(data.size())
             , m_offset(0)
         {
         }
 
-        // yint16_tzǂݎ֐
+        // コンストラクタ（メモリマップ等の外部バッファを直接参照）
+        BinaryReader(const uint8_t* data, size_t size)
+            : m_data(data)
+            , m_size(size)
+            , m_offset(0)
+        {
+        }
+
+        // 【int16_t】を読み取る関数
         int16_t ReadInt16()
         {
             int16_t v;
@@ -33,7 +42,7 @@ namespace Imase
             return v;
         }
 
-        // yuint32_tzǂݎ֐
+        // 【uint32_t】を読み取る関数
         uint32_t ReadUInt32()
         {
             uint32_t v;
@@ -41,7 +50,7 @@ namespace Imase
             return v;
         }
 
-        // yint32_tzǂݎ֐
+        // 【int32_t】を読み取る関数
         int32_t ReadInt32()
         {
             int32_t v;
@@ -49,7 +58,7 @@ namespace Imase
             return v;
         }
 
-        // yfloatzǂݎ֐
+        // 【float】を読み取る関数
         float ReadFloat()
         {
             float v;
@@ -57,18 +66,38 @@ namespace Imase
             return v;
         }
 
-        // y1bytezǂݎ֐
+        // 【1byte】を読み取る関数
         void ReadBytes(void* dst, size_t size)
         {
             ReadRaw(dst, size);
         }
 
-        // yTzwǂݎ֐
-        // yuint32_tz(count) + yTz * count
+        // 指定サイズ分読み進めて先頭アドレスを返す関数（コピーしない）
+        const uint8_t* ReadView(size_t size)
+        {
+            if (m_offset + size > m_size)
+            {
+                throw std::runtime_error("BinaryReader overflow");
+            }
+
+            const uint8_t* p = m_data + m_offset;
+            m_offset += size;
+            return p;
+        }
+
+        // 【T】を指定個数を読み取る関数
+        // 【uint32_t】(count) + 【T】 * count
         template<typename T>
         std::vector<T> ReadVector()
         {
             uint32_t count = ReadUInt32();
+
+            // 壊れた個数で大きな領域を確保しないように、残りのサイズを先に調べる
+            if (count > GetRemainingSize() / sizeof(T))
+            {
+                throw std::runtime_error("BinaryReader overflow");
+            }
+
             std::vector<T> vec(count);
             if (count > 0)
             {
@@ -77,11 +106,15 @@ namespace Imase
             return vec;
         }
 
-        // std::stringǂݎ֐
-        //yuint32_tz(count) + y1bytez * count
+        // std::stringを読み取る関数
+        //【uint32_t】(count) + 【1byte】 * count
         std::string ReadString()
         {
             uint32_t length = ReadUInt32();
+            if (length > GetRemainingSize())
+            {
+                throw std::runtime_error("BinaryReader overflow");
+            }
 
             std::string str;
             str.resize(length);
@@ -91,29 +124,49 @@ namespace Imase
             return str;
         }
 
-        // f[^I[܂œǂݏItrueԂ֐
+        // 読み取り位置を指定バイト境界まで進める関数
+        void Align(size_t alignment)
+        {
+            size_t aligned = (m_offset + alignment - 1) / alignment * alignment;
+            if (aligned > m_size)
+            {
+                throw std::runtime_error("BinaryReader overflow");
+            }
+            m_offset = aligned;
+        }
+
+        // データが終端まで読み終わったらtrueを返す関数
         bool End() const
         {
-            return m_offset >= m_buffer.size();
+            return m_offset >= m_size;
+        }
+
+        // 残りのバイト数を取得する関数
+        size_t GetRemainingSize() const
+        {
+            return m_offset < m_size ? m_size - m_offset : 0;
         }
 
     private:
 
-        // ǂݎpobt@
-        const std::vector<uint8_t>& m_buffer;
+        // 読み取り用バッファ
+        const uint8_t* m_data;
+
+        // バッファサイズ
+        size_t m_size;
 
-        // ݂̓ǂݎʒu
+        // 現在の読み取り位置
         size_t m_offset;
 
-        // wTCỸf[^obt@ǂݎ֐
+        // 指定サイズのデータをバッファから読み取る関数
         void ReadRaw(void* dst, size_t size)
         {
-            if (m_offset + size > m_buffer.size())
+            if (m_offset + size > m_size)
             {
                 throw std::runtime_error("BinaryReader overflow");
             }
 
-            std::memcpy(dst, m_buffer.data() + m_offset, size);
+            std::memcpy(dst, m_data + m_offset, size);
             m_offset += size;
         }
     };
@@ -1,7 +1,7 @@
 //--------------------------------------------------------------------------------------
 // File: ChunkIO.h
 //
-// `Nf[^݂̏Ɠǂݍ
+// チャンクデータの書き込みと読み込み
 //
 // Date: 2026.2.16
 // Author: Hideyasu Imase
@@ -14,14 +14,14 @@
 
 namespace Imase
 {
-    // `Nwb_̍\
+    // チャンクヘッダの構造体
     struct ChunkHeader
     {
-        uint32_t type;  // f[^^Cv
-        uint32_t size;  // f[^TCY
+        uint32_t type;  // データタイプ
+        uint32_t size;  // データサイズ
     };
 
-    // `Nf[^o֐
+    // チャンクデータ書き出し関数
     inline void WriteChunk(std::ofstream& ofs, uint32_t type, const std::vector<uint8_t>& data)
     {
         ChunkHeader header{};
@@ -32,7 +32,22 @@ namespace Imase
         ofs.write((char*)data.data(), data.size());
     }
 
-    // `Nf[^ǂݍފ֐
+    // チャンクデータを書き出す関数（v2：データを4バイト境界までパディング）
+    inline void WriteChunkAligned(std::ofstream& ofs, uint32_t type, const std::vector<uint8_t>& data)
+    {
+        static const uint8_t padding[4] = {};
+        size_t padSize = (4 - data.size() % 4) % 4;
+
+        ChunkHeader header{};
+        header.type = type;
+        header.size = (uint32_t)(data.size() + padSize);
+
+        ofs.write((char*)&header, sizeof(header));
+        ofs.write((char*)data.data(), data.size());
+        ofs.write((char*)padding, padSize);
+    }
+
+    // チャンクデータを読み込む関数
     inline bool ReadChunk(std::ifstream& ifs, ChunkHeader& header, std::vector<uint8_t>& buffer)
     {
         if (!ifs.read(reinterpret_cast<char*>(&header), sizeof(header)))
@@ -49,4 +64,26 @@ namespace Imase
 
         return true;
     }
+
+    // メモリ上のチャンクデータを参照する関数（データはコピーしない）
+    inline bool ReadChunk(const uint8_t* data, size_t size, size_t& offset, ChunkHeader& header, const uint8_t*& payload)
+    {
+        if (offset + sizeof(header) > size)
+        {
+            return false;
+        }
+
+        std::memcpy(&header, data + offset, sizeof(header));
+        offset += sizeof(header);
+
+        if (offset + header.size > size)
+        {
+            return false;
+        }
+
+        payload = data + offset;
+        offset += header.size;
+
+        return true;
+    }
 }
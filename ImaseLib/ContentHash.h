@@ -0,0 +1,32 @@
+//--------------------------------------------------------------------------------------
+// File: ContentHash.h
+//
+// データの内容から 64bit のハッシュ値を計算する関数（FNV-1a）
+//
+// アセットの同一判定に使います（暗号学的な強度はありません）
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+namespace Imase
+{
+    constexpr uint64_t CONTENT_HASH_SEED = 14695981039346656037ull;
+    constexpr uint64_t CONTENT_HASH_PRIME = 1099511628211ull;
+
+    // バイト列のハッシュ値を計算する関数（seed に前回の値を渡すと続きから計算できる）
+    inline uint64_t ComputeContentHash(std::span<const uint8_t> data, uint64_t seed = CONTENT_HASH_SEED)
+    {
+        uint64_t hash = seed;
+        for (uint8_t byte : data)
+        {
+            hash ^= byte;
+            hash *= CONTENT_HASH_PRIME;
+        }
+        return hash;
+    }
+}
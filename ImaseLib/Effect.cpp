@@ -1,18 +1,19 @@
 //--------------------------------------------------------------------------------------
 // File: Effect.cpp
 //
-// `ɕKvȐݒsNX
+// 描画に必要な設定を行うクラス
 //
 // Date: 2025.2.11
 // Author: Hideyasu Imase
 //--------------------------------------------------------------------------------------
 #include "pch.h"
 #include "Effect.h"
+#include "TextureRegistry.h"
 
 using namespace DirectX;
 using namespace Imase;
 
-// RXgN^
+// コンストラクタ
 Imase::Effect::Effect(ID3D11Device* device, Imase::ShaderBase* pShader)
     : m_pShader{ pShader }
     , m_dirtyFlags{ 0xFFFFFFFF }
@@ -24,11 +25,18 @@ Imase::Effect::Effect(ID3D11Device* device, Imase::ShaderBase* pShader)
     , m_materials{}
     , m_materialIndex{}
     , m_lightStates{}
+    , m_skinBuffer{}
+    , m_skinSRV{}
+    , m_skinBufferOffset{}
     , m_useSkin{}
+    , m_skinFormat{ Imase::SkinFormat::Matrix4x4 }
+    , m_vertexFormat{ Imase::VertexFormat::Standard }
+    , m_positionScale{ 1.0f, 1.0f, 1.0f }
+    , m_positionOffset{ 0.0f, 0.0f, 0.0f }
 {
-    // ----- Tv[Xe[g ----- //
+    // ----- サンプラーステート ----- //
     {
-        // Tv[e[g̍쐬
+        // サンプラーテートの作成
         D3D11_SAMPLER_DESC desc = {};
         desc.Filter = D3D11_FILTER_MIN_MAG_MIP_LINEAR;
         desc.AddressU = D3D11_TEXTURE_ADDRESS_WRAP;
@@ -42,34 +50,34 @@ Imase::Effect::Effect(ID3D11Device* device, Imase::ShaderBase* pShader)
         );
     }
 
-    // 萔obt@쐬
+    // 定数バッファ作成
     CreatePerFrameCB(device);
     CreatePerObjectCB(device);
     CreatePerMaterialCB(device);
     CreateSkinCB(device);
 
-    // fBtHgCg̐ݒ
+    // ディフォルトライトの設定
     EnableDefaultLighting();
 }
 
-// t[Jn̏
+// フレーム開始時の処理
 void Imase::Effect::BeginFrame(ID3D11DeviceContext* context)
 {
-    // r[sƃvWFNVs񂪕ύXꂽ
+    // ビュー行列とプロジェクション行列が変更された
     if (m_dirtyFlags & EffectDirtyFlags::ViewProjection)
     {
         m_dirtyFlags &= ~EffectDirtyFlags::ViewProjection;
         m_dirtyFlags |= EffectDirtyFlags::ConstantBuffer_b0;
     }
 
-    // CgύXꂽ
+    // ライトが変更された
     if (m_dirtyFlags & EffectDirtyFlags::Light)
     {
         m_dirtyFlags &= ~EffectDirtyFlags::Light;
         m_dirtyFlags |= EffectDirtyFlags::ConstantBuffer_b0;
     }
 
-    // ύXΒ萔obt@XV
+    // 変更があれば定数バッファを更新
     if (m_dirtyFlags & EffectDirtyFlags::ConstantBuffer_b0)
     {
         UpdatePerFrameCB(context);
@@ -77,24 +85,31 @@ void Imase::Effect::BeginFrame(ID3D11DeviceContext* context)
     }
 }
 
-// GtFNgK֐
+// エフェクトを適応する関数
 void Imase::Effect::Apply(ID3D11DeviceContext* context)
 {
-    // [hs񂪕ύXꂽ
+    // ワールド行列が変更された
     if (m_dirtyFlags & EffectDirtyFlags::World)
     {
         m_dirtyFlags &= ~EffectDirtyFlags::World;
         m_dirtyFlags |= EffectDirtyFlags::ConstantBuffer_b1;
     }
 
-    // XLLEȂύXꂽ
+    // スキン有り・なしが変更された
     if (m_dirtyFlags & EffectDirtyFlags::UseSkin)
     {
         m_dirtyFlags &= ~EffectDirtyFlags::UseSkin;
         m_dirtyFlags |= EffectDirtyFlags::ConstantBuffer_b1;
     }
 
-    // }eAύXꂽ
+    // 頂点形式が変更された
+    if (m_dirtyFlags & EffectDirtyFlags::VertexFormat)
+    {
+        m_dirtyFlags &= ~EffectDirtyFlags::VertexFormat;
+        m_dirtyFlags |= EffectDirtyFlags::ConstantBuffer_b1;
+    }
+
+    // マテリアルが変更された
     if (m_dirtyFlags & EffectDirtyFlags::Material)
     {
         m_dirtyFlags &= ~EffectDirtyFlags::Material;
@@ -102,37 +117,42 @@ void Imase::Effect::Apply(ID3D11DeviceContext* context)
     }
 
     // ----------------------------------------------------------- //
-    // 萔obt@ b1 b2 XV
+    // 定数バッファ b1 b2 更新
     // ----------------------------------------------------------- //
 
-    // ύXΒ萔obt@XV
+    // 変更があれば定数バッファを更新
     if (m_dirtyFlags & EffectDirtyFlags::ConstantBuffer_b1)
     {
-        // 萔obt@XViIuWFNgj
+        // 定数バッファを更新（オブジェクト毎）
         UpdatePerObjectCB(context);
         m_dirtyFlags &= ~EffectDirtyFlags::ConstantBuffer_b1;
     }
  
-    // ύXΒ萔obt@XV
+    // 変更があれば定数バッファを更新
     if (m_dirtyFlags & EffectDirtyFlags::ConstantBuffer_b2)
     {
-        // 萔obt@XVi}eAj
+        // 定数バッファを更新（マテリアル）
         UpdatePerMaterialCB(context);
         m_dirtyFlags &= ~EffectDirtyFlags::ConstantBuffer_b2;
     }
 
-    // VF[_[oCh
-    m_pShader->Bind(context);
+    // シェーダーをバインド
+    m_pShader->Bind(context, m_vertexFormat);
 
-    // 萔obt@ݒ
-    ID3D11Buffer* cbBuffers[] = { m_perFrameCB.Get(), m_perObjectCB.Get(), m_perMaterialCB.Get(), m_skinCB.Get()};
+    // 定数バッファを設定
+    ID3D11Buffer* skinBuffer = m_skinBuffer ? m_skinBuffer : m_skinCB.Get();
+    ID3D11Buffer* cbBuffers[] = { m_perFrameCB.Get(), m_perObjectCB.Get(), m_perMaterialCB.Get(), skinBuffer };
     context->VSSetConstantBuffers(0, 4, cbBuffers);
+
+    // スキン行列をまとめたストラクチャードバッファ（t0）
+    ID3D11ShaderResourceView* skinSRV[] = { m_skinSRV };
+    context->VSSetShaderResources(0, 1, skinSRV);
     context->PSSetConstantBuffers(0, 3, cbBuffers);
 
-    // Tv[Xe[g̐ݒiLinearWrapj
+    // サンプラーステートの設定（LinearWrap）
     context->PSSetSamplers(0, 1, m_samplerState.GetAddressOf());
 
-    // x[XJ[(BaseColor)
+    // ベースカラー(BaseColor)
     if (m_materials[m_materialIndex].baseColorTexIndex >= 0)
     {
         ID3D11ShaderResourceView* srv[] = { m_textures[m_materials[m_materialIndex].baseColorTexIndex].Get() };
@@ -144,7 +164,7 @@ void Imase::Effect::Apply(ID3D11DeviceContext* context)
         context->PSSetShaderResources(0, 1, nullSRV);
     }
 
-    // @}bv(NormalMap)
+    // 法線マップ(NormalMap)
     if (m_materials[m_materialIndex].normalTexIndex >= 0)
     {
         ID3D11ShaderResourceView* srv[] = { m_textures[m_materials[m_materialIndex].normalTexIndex].Get() };
@@ -156,7 +176,7 @@ void Imase::Effect::Apply(ID3D11DeviceContext* context)
         context->PSSetShaderResources(1, 1, nullSRV);
     }
 
-    // ArGgIN[WƃtlXƃ^bN(ORM)
+    // アンビエントオクルージョンとラフネスとメタリック(ORM)
     if (m_materials[m_materialIndex].metalRoughTexIndex >= 0)
     {
         ID3D11ShaderResourceView* srv[] = { m_textures[m_materials[m_materialIndex].metalRoughTexIndex].Get() };
@@ -168,8 +188,8 @@ void Imase::Effect::Apply(ID3D11DeviceContext* context)
         context->PSSetShaderResources(2, 1, nullSRV);
     }
 
-    // gUIBL
-    // ͂̕ii}bvjuǂ̕Aǂꂭ炢̋̌͂Ă邩v𕽋ωEċL^}bv
+    // 拡散IBL
+    // 周囲の風景（環境マップ）から「どの方向から、どれくらいの強さの光が届いているか」を平均化・平滑化して記録したマップ
     if (m_irradianceMap)
     {
         ID3D11ShaderResourceView* srv[] = { m_irradianceMap.Get() };
@@ -181,8 +201,8 @@ void Imase::Effect::Apply(ID3D11DeviceContext* context)
         context->PSSetShaderResources(3, 1, nullSRV);
     }
 
-    // IBL
-    // ͂̊摜u̔ˁvƂĕ̂ɉf荞܂}bv
+    // 鏡面IBL
+    // 周囲の環境画像を「光の反射」として物体に映り込ませるマップ
     if (m_prefilterMap)
     {
         ID3D11ShaderResourceView* srv[] = { m_prefilterMap.Get() };
@@ -194,8 +214,8 @@ void Imase::Effect::Apply(ID3D11DeviceContext* context)
         context->PSSetShaderResources(4, 1, nullSRV);
     }
 
-    // BRDF LUTiBidirectional Reflectance Distribution Function Look-Up Tablej
-    // x[X_OiPBRjɂāA̔ˌvZ邽߂ɂ炩ߌvZʂۑĂ摜f[^
+    // BRDF LUT（Bidirectional Reflectance Distribution Function Look-Up Table）
+    // 物理ベースレンダリング（PBR）において、光の反射計算を高速化するためにあらかじめ計算結果を保存しておく画像データ
     if (m_brdfLut)
     {
         ID3D11ShaderResourceView* srv[] = { m_brdfLut.Get() };
@@ -209,7 +229,7 @@ void Imase::Effect::Apply(ID3D11DeviceContext* context)
 
 }
 
-// r[sƃvWFNVsݒ肷֐
+// ビュー行列とプロジェクション行列を設定する関数
 void Imase::Effect::SetViewProjection(DirectX::XMMATRIX view, DirectX::XMMATRIX projection)
 {
     m_view = view;
@@ -217,7 +237,7 @@ void Imase::Effect::SetViewProjection(DirectX::XMMATRIX view, DirectX::XMMATRIX
     m_dirtyFlags |= EffectDirtyFlags::ViewProjection;
 }
 
-// w胉Cg̗LEݒ肷֐
+// 指定ライトの有効・無効を設定する関数
 void Imase::Effect::SetLightEnabled(int lightNo, bool value)
 {
     ValidateLightIndex(lightNo);
@@ -225,7 +245,7 @@ void Imase::Effect::SetLightEnabled(int lightNo, bool value)
     m_dirtyFlags |= EffectDirtyFlags::Light;
 }
 
-// w胉Cg̕ݒ肷֐
+// 指定ライトの方向を設定する関数
 void Imase::Effect::SetLightDirection(int lightNo, DirectX::XMFLOAT3 direction)
 {
     ValidateLightIndex(lightNo);
@@ -233,7 +253,7 @@ void Imase::Effect::SetLightDirection(int lightNo, DirectX::XMFLOAT3 direction)
     m_dirtyFlags |= EffectDirtyFlags::Light;
 }
 
-// w胉Cg̃fBt[YFݒ肷֐
+// 指定ライトのディフューズ色を設定する関数
 void Imase::Effect::SetLightDiffuseColor(int lightNo, DirectX::XMVECTOR diffuseColor)
 {
     ValidateLightIndex(lightNo);
@@ -241,7 +261,7 @@ void Imase::Effect::SetLightDiffuseColor(int lightNo, DirectX::XMVECTOR diffuseC
     m_dirtyFlags |= EffectDirtyFlags::Light;
 }
 
-// w胉Cg̃XyLFݒ肷֐
+// 指定ライトのスペキュラ色を設定する関数
 void Imase::Effect::SetLightSpecularColor(int lightNo, DirectX::XMVECTOR specularColor)
 {
     ValidateLightIndex(lightNo);
@@ -249,44 +269,77 @@ void Imase::Effect::SetLightSpecularColor(int lightNo, DirectX::XMVECTOR specula
     m_dirtyFlags |= EffectDirtyFlags::Light;
 }
 
-// [hsݒ肷֐
+// ワールド行列を設定する関数
 void Imase::Effect::SetWorld(const DirectX::XMMATRIX& world)
 {
     m_world = world;
     m_dirtyFlags |= EffectDirtyFlags::World;
 }
 
-// XLgpLݒ肷֐
+// スキン使用有無を設定する関数
 void Imase::Effect::SetUseSkin(bool useSkin)
 {
     m_useSkin = useSkin;
     m_dirtyFlags |= EffectDirtyFlags::UseSkin;
 }
 
-// O[oArGgFݒ肷֐
+// 頂点形式を設定する関数
+void Imase::Effect::SetVertexFormat(
+    Imase::VertexFormat format,
+    const DirectX::XMFLOAT3& positionScale,
+    const DirectX::XMFLOAT3& positionOffset
+)
+{
+    m_vertexFormat = format;
+    m_positionScale = positionScale;
+    m_positionOffset = positionOffset;
+    m_dirtyFlags |= EffectDirtyFlags::VertexFormat;
+}
+
+// グローバルアンビエント色を設定する関数
 void Imase::Effect::SetAmbientLightColor(DirectX::XMVECTOR ambientColor)
 {
     XMStoreFloat4(&m_ambientLightColor, ambientColor);
     m_dirtyFlags |= EffectDirtyFlags::Light;
 }
 
-// eNX`̃VF_[\[X쐬ēo^֐
+// テクスチャのシェダーリソースを作成して登録する関数
 void Imase::Effect::RegisterTextures(ID3D11Device* device, std::vector<TextureEntry>& textures)
 {
     m_textures.resize(textures.size());
     for (size_t i = 0; i < textures.size(); i++)
     {
-        DX::ThrowIfFailed(
-            CreateDDSTextureFromMemory(
-                device,
-                textures[i].data.data(), textures[i].data.size(),
-                nullptr,
-                m_textures[i].ReleaseAndGetAddressOf())
-        );
+        m_textures[i] = TextureRegistry::GetInstance().GetOrCreate(device, textures[i].data);
+    }
+}
+
+void Imase::Effect::RegisterTextures(ID3D11Device* device, const std::vector<TextureView>& textures)
+{
+    RegisterTextures(CreateTextures(device, textures));
+}
+
+// 作成済みのシェダーリソースを登録する関数
+void Imase::Effect::RegisterTextures(std::vector<Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>> textures)
+{
+    m_textures = std::move(textures);
+}
+
+// テクスチャのシェダーリソースを作成する関数
+std::vector<Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>> Imase::Effect::CreateTextures(
+    ID3D11Device* device,
+    const std::vector<TextureView>& textures
+)
+{
+    // 内容が同じテクスチャは他のモデルと共有する
+    std::vector<Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>> srvs(textures.size());
+    for (size_t i = 0; i < textures.size(); i++)
+    {
+        srvs[i] = TextureRegistry::GetInstance().GetOrCreate(device, textures[i].data);
     }
+    return srvs;
 }
 
-// }eAo^֐
+// マテリアルを登録する関数
 void Imase::Effect::RegisterMaterials(const std::vector<MaterialInfo>& materials)
 {
     for (size_t i = 0; i < materials.size(); i++)
@@ -295,14 +348,22 @@ void Imase::Effect::RegisterMaterials(const std::vector<MaterialInfo>& materials
     }
 }
 
-// }eAݒ肷֐
+// マテリアルを置き換える関数
+void Imase::Effect::SetMaterials(const std::vector<MaterialInfo>& materials)
+{
+    m_materials = materials;
+    m_materialIndex = 0;
+    m_dirtyFlags |= EffectDirtyFlags::Material;
+}
+
+// マテリアルを設定する関数
 void Imase::Effect::SetMaterialIndex(uint32_t materialIndex)
 {
     m_materialIndex = materialIndex;
     m_dirtyFlags |= EffectDirtyFlags::Material;
 }
 
-// fBtHgCg̐ݒ֐
+// ディフォルトライトの設定関数
 void Imase::Effect::EnableDefaultLighting()
 {
     static const XMFLOAT3 defaultDirections[MaxLights] =
@@ -339,10 +400,10 @@ void Imase::Effect::EnableDefaultLighting()
     }
 }
 
-// 萔obt@̍쐬֐it[XVj
+// 定数バッファの作成関数（フレーム更新時）
 void Imase::Effect::CreatePerFrameCB(ID3D11Device* device)
 {
-    // 萔obt@̍쐬
+    // 定数バッファの作成
     D3D11_BUFFER_DESC desc = {};
     desc.ByteWidth = sizeof(Imase::PerFrameCB);
     desc.Usage = D3D11_USAGE_DYNAMIC;
@@ -353,10 +414,10 @@ void Imase::Effect::CreatePerFrameCB(ID3D11Device* device)
     );
 }
 
-// 萔obt@̍쐬֐ifɍXVj
+// 定数バッファの作成関数（モデル毎に更新）
 void Imase::Effect::CreatePerObjectCB(ID3D11Device* device)
 {
-    // 萔obt@̍쐬
+    // 定数バッファの作成
     D3D11_BUFFER_DESC desc = {};
     desc.ByteWidth = sizeof(Imase::PerObjectCB);
     desc.Usage = D3D11_USAGE_DYNAMIC;
@@ -367,10 +428,10 @@ void Imase::Effect::CreatePerObjectCB(ID3D11Device* device)
     );
 }
 
-// 萔obt@̍쐬֐i}eAj
+// 定数バッファの作成関数（マテリアル）
 void Imase::Effect::CreatePerMaterialCB(ID3D11Device* device)
 {
-    // 萔obt@̍쐬
+    // 定数バッファの作成
     D3D11_BUFFER_DESC desc = {};
     desc.ByteWidth = sizeof(Imase::PerMaterialCB);
     desc.Usage = D3D11_USAGE_DYNAMIC;
@@ -381,10 +442,10 @@ void Imase::Effect::CreatePerMaterialCB(ID3D11Device* device)
     );
 }
 
-// 萔obt@̍쐬֐iXLsj
+// 定数バッファの作成関数（スキン行列）
 void Imase::Effect::CreateSkinCB(ID3D11Device* device)
 {
-    // 萔obt@̍쐬
+    // 定数バッファの作成
     D3D11_BUFFER_DESC desc = {};
     desc.ByteWidth = sizeof(Imase::SkinCB);
     desc.Usage = D3D11_USAGE_DYNAMIC;
@@ -395,25 +456,25 @@ void Imase::Effect::CreateSkinCB(ID3D11Device* device)
     );
 }
 
-// 萔obt@XV֐it[XVj
+// 定数バッファ更新関数（フレーム更新時）
 void Imase::Effect::UpdatePerFrameCB(ID3D11DeviceContext* context)
 {
     Imase::PerFrameCB cb = {};
 
-    // r[s
+    // ビュー行列
     cb.View = m_view;
 
-    // ˉes
+    // 射影行列
     cb.Projection = m_projection;
 
-    // J̈ʒu
+    // カメラの位置
     XMMATRIX viewInverse = XMMatrixInverse(nullptr, m_view);
     XMStoreFloat4(&cb.EyePosition, viewInverse.r[3]);
 
-    // O[oArGgF
+    // グローバルアンビエント色
     cb.AmbientLightColor = m_ambientLightColor;
  
-    // Cg
+    // ライト
     for (int i = 0; i < MaxLights; i++)
     {
         if (m_lightStates.lights[i].enable)
@@ -432,7 +493,7 @@ void Imase::Effect::UpdatePerFrameCB(ID3D11DeviceContext* context)
         }
     }
 
-    // 萔obt@XV(b0)
+    // 定数バッファ更新(b0)
     D3D11_MAPPED_SUBRESOURCE mapped = {};
     DX::ThrowIfFailed(
         context->Map(m_perFrameCB.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped)
@@ -441,20 +502,27 @@ void Imase::Effect::UpdatePerFrameCB(ID3D11DeviceContext* context)
     context->Unmap(m_perFrameCB.Get(), 0);
 }
 
-// 萔obt@XV֐ifɍXVj
+// 定数バッファ更新関数（モデル毎に更新）
 void Imase::Effect::UpdatePerObjectCB(ID3D11DeviceContext* context)
 {
     Imase::PerObjectCB cb = {};
 
-    // [hs
+    // ワールド行列
     cb.World = m_world;
-    // [hs̋t]us
+    // ワールド行列の逆転置行列
     cb.WorldInverseTranspose = XMMatrixTranspose(XMMatrixInverse(nullptr, m_world));
 
-    // XL̎gpL
+    // スキンの使用有無
     cb.UseSkin = m_useSkin;
+    cb.SkinFormat = static_cast<uint32_t>(m_skinFormat);
+    cb.SkinBufferOffset = m_skinBufferOffset;
+    cb.UseSkinBuffer = m_skinSRV ? 1 : 0;
 
-    // 萔obt@XV(b1)
+    // 量子化された位置の復元用
+    cb.PositionScale = XMFLOAT4(m_positionScale.x, m_positionScale.y, m_positionScale.z, 0.0f);
+    cb.PositionOffset = XMFLOAT4(m_positionOffset.x, m_positionOffset.y, m_positionOffset.z, 0.0f);
+
+    // 定数バッファ更新(b1)
     D3D11_MAPPED_SUBRESOURCE mapped = {};
     DX::ThrowIfFailed(
         context->Map(m_perObjectCB.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped)
@@ -463,7 +531,7 @@ void Imase::Effect::UpdatePerObjectCB(ID3D11DeviceContext* context)
     context->Unmap(m_perObjectCB.Get(), 0);
 }
 
-// 萔obt@XV֐i}eAj
+// 定数バッファ更新関数（マテリアル）
 void Imase::Effect::UpdatePerMaterialCB(ID3D11DeviceContext* context)
 {
     Imase::PerMaterialCB cb = {};
@@ -478,7 +546,7 @@ void Imase::Effect::UpdatePerMaterialCB(ID3D11DeviceContext* context)
     if (m.normalTexIndex >= 0) cb.Flags |= FLAG_NORMALMAP_TEX;
     if (m.metalRoughTexIndex >= 0) cb.Flags |= FLAG_ROUGHNESS_METALLIC_TEX;
 
-    // 萔obt@XV(b2)
+    // 定数バッファ更新(b2)
     D3D11_MAPPED_SUBRESOURCE mapped = {};
     DX::ThrowIfFailed(
         context->Map(m_perMaterialCB.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped)
@@ -487,25 +555,60 @@ void Imase::Effect::UpdatePerMaterialCB(ID3D11DeviceContext* context)
     context->Unmap(m_perMaterialCB.Get(), 0);
 }
 
-// 萔obt@XV֐iXLsj
-void Imase::Effect::UpdateSkinCB(ID3D11DeviceContext* context, const std::vector<DirectX::XMMATRIX>& matrices)
+// 定数バッファ更新関数（スキン行列、使用するボーンの分だけ指定した形式で転送する）
+void Imase::Effect::UpdateSkinCB(
+    ID3D11DeviceContext* context,
+    std::span<const DirectX::XMMATRIX> matrices,
+    Imase::SkinFormat format
+)
 {
-    Imase::SkinCB cb = {};
-
     assert(matrices.size() <= MaxBones);
 
-    for (size_t i = 0; i < matrices.size(); ++i)
-    {
-        cb.SkinMatrices[i] = XMMatrixTranspose(matrices[i]);
-    }
-
-    // 萔obt@XV(b3)
+    // 定数バッファ更新(b3)
     D3D11_MAPPED_SUBRESOURCE mapped = {};
     DX::ThrowIfFailed(
         context->Map(m_skinCB.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped)
     );
-    memcpy(mapped.pData, &cb, sizeof(cb));
+
+    // マップしたメモリに直接書き込む（使わないボーンの分は転送しない）
+    XMFLOAT4* palette = static_cast<XMFLOAT4*>(mapped.pData);
+    size_t stride = GetSkinVectorCount(format);
+    for (size_t i = 0; i < matrices.size(); ++i)
+    {
+        PackSkinMatrix(format, matrices[i], palette + i * stride);
+    }
+
     context->Unmap(m_skinCB.Get(), 0);
+
+    // 外部のバッファを使っていた場合は元に戻す
+    SetSkinBuffer(nullptr, format);
+}
+
+// スキン行列の定数バッファを設定する関数
+void Imase::Effect::SetSkinBuffer(ID3D11Buffer* buffer, Imase::SkinFormat format)
+{
+    m_skinBuffer = buffer;
+
+    if (m_skinFormat != format || m_skinSRV)
+    {
+        m_skinFormat = format;
+        m_skinSRV = nullptr;
+        m_dirtyFlags |= EffectDirtyFlags::UseSkin;
+    }
+}
+
+// スキン行列をまとめたストラクチャードバッファを設定する関数（offset は float4 単位）
+void Imase::Effect::SetSkinBuffer(ID3D11ShaderResourceView* srv, uint32_t offset, Imase::SkinFormat format)
+{
+    m_skinBuffer = nullptr;
+
+    if (m_skinSRV != srv || m_skinBufferOffset != offset || m_skinFormat != format)
+    {
+        m_skinSRV = srv;
+        m_skinBufferOffset = offset;
+        m_skinFormat = format;
+        m_dirtyFlags |= EffectDirtyFlags::UseSkin;
+    }
 }
 
 void Imase::Effect::LoadIrradianceTexture(ID3D11Device* device, const wchar_t* fname)
@@ -529,7 +632,7 @@ void Imase::Effect::LoadBrdfTexture(ID3D11Device* device, const wchar_t* fname)
     );
 }
 
-// Cg̔ԍ؂֐
+// ライトの番号を検証する関数
 void Imase::Effect::ValidateLightIndex(int lightNo)
 {
     if (lightNo < 0 || lightNo >= MaxLights)
@@ -1,7 +1,7 @@
 //--------------------------------------------------------------------------------------
 // File: Effect.h
 //
-// `ɕKvȐݒsNX
+// 描画に必要な設定を行うクラス
 //
 // Date: 2025.2.11
 // Author: Hideyasu Imase
@@ -10,38 +10,42 @@
 
 #include "Shaders/ShaderBase.h"
 #include "Imdl.h"
+#include "SkinningMath.h"
+
+#include <span>
 
 namespace Imase
 {
-    // ő{[
+    // 定数バッファで扱える最大ボーン数（超える場合は SkinPaletteBuffer を使う）
     static constexpr int MaxBones = 128;
 
-    // 萔obt@ύXtO
+    // 定数バッファ変更フラグ
     namespace EffectDirtyFlags
     {
-        constexpr uint32_t ConstantBuffer_b0 = 1 << 0;  // 萔obt@̖it[1j
-        constexpr uint32_t ConstantBuffer_b1 = 1 << 1;  // 萔obt@̖iIuWFNgj
-        constexpr uint32_t ConstantBuffer_b2 = 1 << 2;  // 萔obt@̖i}eAj
+        constexpr uint32_t ConstantBuffer_b0 = 1 << 0;  // 定数バッファの役割（フレームで1回）
+        constexpr uint32_t ConstantBuffer_b1 = 1 << 1;  // 定数バッファの役割（オブジェクト毎）
+        constexpr uint32_t ConstantBuffer_b2 = 1 << 2;  // 定数バッファの役割（マテリアル）
 
         constexpr uint32_t ViewProjection    = 1 << 3;   // b0
         constexpr uint32_t Light             = 1 << 4;   // b0
         constexpr uint32_t World             = 1 << 5;   // b1
         constexpr uint32_t UseSkin           = 1 << 6;   // b1
         constexpr uint32_t Material          = 1 << 7;   // b2
+        constexpr uint32_t VertexFormat      = 1 << 8;   // b1
     }
 
-    // }eAptO
+    // マテリアル用フラグ
     enum MaterialFlags
     {
-        FLAG_BASECOLOR_TEX = 1 << 0,            // x[XJ[peNX`gpL
-        FLAG_NORMALMAP_TEX = 1 << 1,            // @}bvpeNX`gpL
-        FLAG_ROUGHNESS_METALLIC_TEX = 1 << 2,   // tlXA^bNpeNX`gpL
+        FLAG_BASECOLOR_TEX = 1 << 0,            // ベースカラー用テクスチャ使用有無
+        FLAG_NORMALMAP_TEX = 1 << 1,            // 法線マップ用テクスチャ使用有無
+        FLAG_ROUGHNESS_METALLIC_TEX = 1 << 2,   // ラフネス、メタリック用テクスチャ使用有無
     };
 
-    // Cg̍ő吔
+    // ライトの最大数
     static constexpr int MaxLights = 3;
 
-    // t[̍ŏɍXVib0j
+    // フレームの最初に更新（b0）
     struct PerFrameCB
     {
         DirectX::XMMATRIX View;
@@ -56,17 +60,22 @@ namespace Imase
         DirectX::XMFLOAT4 EyePosition;
     };
 
-    // IuWFNgɍXVib1j
+    // オブジェクト毎に更新（b1）
     struct PerObjectCB
     {
         DirectX::XMMATRIX World;
         DirectX::XMMATRIX WorldInverseTranspose;
 
         uint32_t UseSkin;
-        float padding[3];
+        uint32_t SkinFormat;        // Imase::SkinFormat
+        uint32_t SkinBufferOffset;  // ストラクチャードバッファ内の先頭位置（float4 単位）
+        uint32_t UseSkinBuffer;     // 1:ストラクチャードバッファ 0:定数バッファ
+
+        DirectX::XMFLOAT4 PositionScale;    // 量子化された位置の復元用（xyz）
+        DirectX::XMFLOAT4 PositionOffset;
     };
 
-    // }eAib2j
+    // マテリアル（b2）
     struct PerMaterialCB
     {
         DirectX::XMFLOAT4 BaseColor;
@@ -79,13 +88,13 @@ namespace Imase
         float             padding[2];
     };
 
-    // XLjOpsib3j
+    // スキニング用行列（b3、１ボーンあたり GetSkinVectorCount 個の float4）
     struct SkinCB
     {
-        DirectX::XMMATRIX SkinMatrices[MaxBones];
+        DirectX::XMFLOAT4 SkinPalette[MaxBones * 4];
     };
 
-    // Cg
+    // ライト
     struct LightState
     {
         bool enable;
@@ -94,7 +103,7 @@ namespace Imase
         DirectX::XMFLOAT4 specular;
     };
 
-    // Cg̏
+    // ライトの状態
     struct LightingStates
     {
         LightState lights[MaxLights];
@@ -104,54 +113,73 @@ namespace Imase
 	{
     private:
 
-        // VF[_[ւ̃|C^
+        // シェーダーへのポインタ
         Imase::ShaderBase* m_pShader;
 
-        // ύXꂽێtO
+        // 変更された情報を保持するフラグ
         uint32_t m_dirtyFlags;
 
-        // [hs
+        // ワールド行列
         DirectX::XMMATRIX m_world;
 
-        // r[s
+        // ビュー行列
         DirectX::XMMATRIX m_view;
 
-        // vWFNVs
+        // プロジェクション行列
         DirectX::XMMATRIX m_projection;
 
-        // eNX`nh
+        // テクスチャハンドル
         std::vector<Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>> m_textures;
 
-        // }eA
+        // マテリアル情報
         std::vector<MaterialInfo> m_materials;
 
-        // }eACfbNX
+        // マテリアルインデックス
         uint32_t m_materialIndex;
 
-        // O[oArGgF
+        // グローバルアンビエント色
         DirectX::XMFLOAT4 m_ambientLightColor;
 
-        // Cg
+        // ライト
         Imase::LightingStates m_lightStates;
 
-        // 萔obt@it[̍ŏɍXVpj
+        // 定数バッファ（フレームの最初に更新用）
         Microsoft::WRL::ComPtr<ID3D11Buffer> m_perFrameCB;
 
-        // 萔obt@iIuWFNgɍXVpj
+        // 定数バッファ（オブジェクト毎に更新用）
         Microsoft::WRL::ComPtr<ID3D11Buffer> m_perObjectCB;
 
-        // 萔obt@i}eApj
+        // 定数バッファ（マテリアル用）
         Microsoft::WRL::ComPtr<ID3D11Buffer> m_perMaterialCB;
 
-        // 萔obt@iXLspj
+        // 定数バッファ（スキン行列用）
         Microsoft::WRL::ComPtr<ID3D11Buffer> m_skinCB;
 
-        // Tv[Xe[g
+        // 外部のスキン行列の定数バッファ（nullptr なら m_skinCB を使う）
+        ID3D11Buffer* m_skinBuffer;
+
+        // スキン行列をまとめたストラクチャードバッファ（VS の t0、nullptr なら定数バッファを使う）
+        ID3D11ShaderResourceView* m_skinSRV;
+
+        // ストラクチャードバッファ内の先頭位置（float4 単位）
+        uint32_t m_skinBufferOffset;
+
+        // サンプラーステート
         Microsoft::WRL::ComPtr<ID3D11SamplerState> m_samplerState;
 
-        // XLgpL
+        // スキン使用有無
         bool m_useSkin;
 
+        // スキン行列の形式
+        Imase::SkinFormat m_skinFormat;
+
+        // 頂点形式
+        Imase::VertexFormat m_vertexFormat;
+
+        // 量子化された位置の復元用スケールとオフセット
+        DirectX::XMFLOAT3 m_positionScale;
+        DirectX::XMFLOAT3 m_positionOffset;
+
         // Irradiance Map(t3)
         Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> m_irradianceMap;
 
@@ -163,53 +191,83 @@ namespace Imase
 
     public:
 
-        // RXgN^
+        // コンストラクタ
         Effect(ID3D11Device* device, Imase::ShaderBase* pShader);
 
-        // t[ŏɂPĂяo֐
+        // フレーム最初に１回呼び出す関数
         void BeginFrame(ID3D11DeviceContext* context);
 
-        // GtFNgK֐
+        // エフェクトを適応する関数
         void Apply(ID3D11DeviceContext* context);
 
-        // r[sƃvWFNVsݒ肷֐
+        // ビュー行列とプロジェクション行列を設定する関数
         void SetViewProjection(DirectX::XMMATRIX view, DirectX::XMMATRIX projection);
 
-        // w胉Cg̗LEݒ肷֐
+        // 指定ライトの有効・無効を設定する関数
         void SetLightEnabled(int lightNo, bool value);
 
-        // w胉Cg̕ݒ肷֐
+        // 指定ライトの方向を設定する関数
         void SetLightDirection(int lightNo, DirectX::XMFLOAT3 direction);
 
-        // w胉Cg̃fBt[YFݒ肷֐
+        // 指定ライトのディフューズ色を設定する関数
         void SetLightDiffuseColor(int lightNo, DirectX::XMVECTOR diffuseColor);
 
-        // w胉Cg̃XyLFݒ肷֐
+        // 指定ライトのスペキュラ色を設定する関数
         void SetLightSpecularColor(int lightNo, DirectX::XMVECTOR specularColor);
 
-        // [hsݒ肷֐
+        // ワールド行列を設定する関数
         void SetWorld(const DirectX::XMMATRIX& world);
 
-        // XLgpLݒ肷֐
+        // スキン使用有無を設定する関数
         void SetUseSkin(bool useSkin);
 
-        // O[oArGgFݒ肷֐
+        // 頂点形式を設定する関数（量子化された位置は position * scale + offset で復元）
+        void SetVertexFormat(
+            Imase::VertexFormat format,
+            const DirectX::XMFLOAT3& positionScale = { 1.0f, 1.0f, 1.0f },
+            const DirectX::XMFLOAT3& positionOffset = { 0.0f, 0.0f, 0.0f }
+        );
+
+        // グローバルアンビエント色を設定する関数
         void SetAmbientLightColor(DirectX::XMVECTOR ambientColor);
 
-        // eNX`̃VF_[\[X쐬ēo^֐
+        // テクスチャのシェダーリソースを作成して登録する関数
         void RegisterTextures(ID3D11Device* device, std::vector<TextureEntry>& textures);
+        void RegisterTextures(ID3D11Device* device, const std::vector<TextureView>& textures);
+
+        // 作成済みのシェダーリソースを登録する関数
+        void RegisterTextures(std::vector<Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>> textures);
+
+        // テクスチャのシェダーリソースを作成する関数（エフェクトを変更しないのでワーカースレッドから呼び出し可）
+        static std::vector<Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>> CreateTextures(
+            ID3D11Device* device,
+            const std::vector<TextureView>& textures
+        );
 
-        // }eAo^֐
+        // マテリアルを登録する関数
         void RegisterMaterials(const std::vector<MaterialInfo>& materials);
 
-        // }eAݒ肷֐
+        // マテリアルを置き換える関数
+        void SetMaterials(const std::vector<MaterialInfo>& materials);
+
+        // マテリアルを設定する関数
         void SetMaterialIndex(uint32_t materialIndex);
 
-        // fBtHgCg̐ݒ֐
+        // ディフォルトライトの設定関数
         void EnableDefaultLighting();
 
-        // 萔obt@XV֐iXLsj
-        void UpdateSkinCB(ID3D11DeviceContext* context, const std::vector<DirectX::XMMATRIX>& matrices);
+        // 定数バッファ更新関数（スキン行列、使用するボーンの分だけ指定した形式で転送する）
+        void UpdateSkinCB(
+            ID3D11DeviceContext* context,
+            std::span<const DirectX::XMMATRIX> matrices,
+            Imase::SkinFormat format = Imase::SkinFormat::Matrix4x4
+        );
+
+        // スキン行列の定数バッファを設定する関数（更新済みのバッファを b3 にバインドする、nullptr で元に戻す）
+        void SetSkinBuffer(ID3D11Buffer* buffer, Imase::SkinFormat format = Imase::SkinFormat::Matrix4x4);
+
+        // スキン行列をまとめたストラクチャードバッファを設定する関数（offset は float4 単位）
+        void SetSkinBuffer(ID3D11ShaderResourceView* srv, uint32_t offset, Imase::SkinFormat format);
 
         // Irradiance Map(t3)
         void LoadIrradianceTexture(ID3D11Device* device, const wchar_t* fname);
@@ -222,28 +280,28 @@ namespace Imase
 
     private:
     
-        // 萔obt@쐬֐it[XVj
+        // 定数バッファ作成関数（フレーム更新時）
         void CreatePerFrameCB(ID3D11Device* device);
 
-        // 萔obt@쐬֐iIuWFNgj
+        // 定数バッファ作成関数（オブジェクト毎）
         void CreatePerObjectCB(ID3D11Device* device);
 
-        // 萔obt@쐬֐i}eAj
+        // 定数バッファ作成関数（マテリアル）
         void CreatePerMaterialCB(ID3D11Device* device);
 
-        // 萔obt@쐬֐iXLsj
+        // 定数バッファ作成関数（スキン行列）
         void CreateSkinCB(ID3D11Device* device);
 
-        // 萔obt@XV֐it[XVj
+        // 定数バッファ更新関数（フレーム更新時）
         void UpdatePerFrameCB(ID3D11DeviceContext* context);
 
-        // 萔obt@XV֐iIuWFNgj
+        // 定数バッファ更新関数（オブジェクト毎）
         void UpdatePerObjectCB(ID3D11DeviceContext* context);
 
-        // 萔obt@XV֐i}eAj
+        // 定数バッファ更新関数（マテリアル）
         void UpdatePerMaterialCB(ID3D11DeviceContext* context);
 
-        // Cg̔ԍ؂֐
+        // ライトの番号を検証する関数
         void ValidateLightIndex(int lightNo);
     };
 }
\ No newline at end of file
@@ -0,0 +1,95 @@
+//--------------------------------------------------------------------------------------
+// File: FrameArena.cpp
+//
+// １フレームの間だけ使う一時メモリを確保するクラス（線形アロケーター）
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "pch.h"
+#include "FrameArena.h"
+
+// コンストラクタ
+Imase::FrameArena::FrameArena()
+    : m_buffer{ std::make_unique<std::byte[]>(DefaultCapacity) }
+    , m_capacity{ DefaultCapacity }
+    , m_offset{ 0 }
+    , m_overflowBytes{ 0 }
+{
+    m_stats.capacity = m_capacity;
+}
+
+// インスタンスを取得する関数
+Imase::FrameArena& Imase::FrameArena::GetInstance()
+{
+    static FrameArena instance;
+    return instance;
+}
+
+// メモリを確保する関数
+void* Imase::FrameArena::Allocate(size_t size, size_t alignment)
+{
+    uintptr_t base = reinterpret_cast<uintptr_t>(m_buffer.get());
+
+    size_t offset = m_offset.load(std::memory_order_relaxed);
+    size_t aligned, end;
+    do
+    {
+        // アドレスをアライメントに合わせる
+        aligned = ((base + offset + alignment - 1) & ~(alignment - 1)) - base;
+        end = aligned + size;
+
+        if (end > m_capacity)
+        {
+            return AllocateOverflow(size, alignment);
+        }
+    } while (!m_offset.compare_exchange_weak(offset, end, std::memory_order_relaxed));
+
+    return m_buffer.get() + aligned;
+}
+
+// 容量を超えた分をヒープから確保する関数
+void* Imase::FrameArena::AllocateOverflow(size_t size, size_t alignment)
+{
+    std::lock_guard<std::mutex> lock(m_overflowMutex);
+
+    m_overflowBlocks.push_back(std::make_unique<std::byte[]>(size + alignment));
+    m_overflowBytes += size + alignment;
+    m_stats.overflowCount++;
+
+    uintptr_t p = reinterpret_cast<uintptr_t>(m_overflowBlocks.back().get());
+    return reinterpret_cast<void*>((p + alignment - 1) & ~(alignment - 1));
+}
+
+// 全て解放する関数
+void Imase::FrameArena::Reset()
+{
+    size_t used = std::min(m_offset.load(), m_capacity) + m_overflowBytes;
+    m_stats.usedBytes = used;
+    m_stats.peakBytes = std::max(m_stats.peakBytes, used);
+
+    // 容量が足りなかった場合は次のフレームから不足しない大きさにする
+    if (m_overflowBytes > 0)
+    {
+        size_t capacity = m_capacity;
+        while (capacity < used)
+        {
+            capacity *= 2;
+        }
+
+        m_buffer = std::make_unique<std::byte[]>(capacity);
+        m_capacity = capacity;
+        m_stats.capacity = capacity;
+
+        m_overflowBlocks.clear();
+        m_overflowBytes = 0;
+    }
+
+    m_offset.store(0);
+}
+
+// 統計情報を取得する関数
+Imase::FrameArena::Stats Imase::FrameArena::GetStats() const
+{
+    return m_stats;
+}
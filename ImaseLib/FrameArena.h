@@ -0,0 +1,96 @@
+//--------------------------------------------------------------------------------------
+// File: FrameArena.h
+//
+// １フレームの間だけ使う一時メモリを確保するクラス（線形アロケーター）
+//
+// 確保は先頭から順に進めるだけで、解放はフレームの先頭の Reset でまとめて行います
+// 容量を超えた分はヒープから確保し、次の Reset で不足しない大きさに拡張します
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <span>
+
+namespace Imase
+{
+    class FrameArena
+    {
+    public:
+
+        // 初期容量
+        static constexpr size_t DefaultCapacity = 256 * 1024;
+
+        // 統計情報
+        struct Stats
+        {
+            size_t capacity = 0;        // 容量
+            size_t usedBytes = 0;       // 前のフレームで使用したサイズ（容量を超えた分も含む）
+            size_t peakBytes = 0;       // これまでのフレームの使用サイズの最大値
+            uint32_t overflowCount = 0; // 容量を超えてヒープから確保した回数の合計
+        };
+
+    private:
+
+        // バッファ
+        std::unique_ptr<std::byte[]> m_buffer;
+
+        // 容量
+        size_t m_capacity;
+
+        // 使用済みの位置
+        std::atomic<size_t> m_offset;
+
+        // 容量を超えた分（次の Reset で解放）
+        std::vector<std::unique_ptr<std::byte[]>> m_overflowBlocks;
+        size_t m_overflowBytes;
+        std::mutex m_overflowMutex;
+
+        // 統計情報
+        Stats m_stats;
+
+    private:
+
+        // コンストラクタ
+        FrameArena();
+
+        // 容量を超えた分をヒープから確保する関数
+        void* AllocateOverflow(size_t size, size_t alignment);
+
+    public:
+
+        // インスタンスを取得する関数
+        static FrameArena& GetInstance();
+
+        FrameArena(const FrameArena&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+
+        // メモリを確保する関数（複数のスレッドから呼び出せる）
+        void* Allocate(size_t size, size_t alignment = 16);
+
+        // 配列を確保する関数（デストラクタは呼ばれないので後始末の不要な型のみ）
+        template <class T>
+        std::span<T> AllocateArray(size_t count);
+
+        // 全て解放する関数（フレームの先頭で呼び出す、確保したメモリを使っている処理が無いこと）
+        void Reset();
+
+        // 統計情報を取得する関数
+        Stats GetStats() const;
+
+    };
+
+    // 配列を確保する関数
+    template <class T>
+    std::span<T> FrameArena::AllocateArray(size_t count)
+    {
+        static_assert(std::is_trivially_destructible_v<T>, "FrameArena does not call destructors.");
+
+        T* p = static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+        std::uninitialized_default_construct_n(p, count);
+        return { p, count };
+    }
+}
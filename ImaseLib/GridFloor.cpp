@@ -1,7 +1,7 @@
 //--------------------------------------------------------------------------------------
 // File: GridFloor.cpp
 //
-// Obh̏`悷NX
+// グリッドの床を描画するクラス
 //
 // Date: 2023.5.6
 // Author: Hideyasu Imase
@@ -12,7 +12,7 @@
 using namespace DirectX;
 using namespace Imase;
 
-// 1ӂ̃TCY
+// 床の1辺のサイズ
 const  float GridFloor::FLOOR_SIZE = 10.0f;
 
 GridFloor::GridFloor(
@@ -28,16 +28,16 @@ GridFloor::GridFloor(
 	, m_size(size)
 	, m_divs(divs)
 {
-	// v~eBuob`̍쐬
+	// プリミティブバッチの作成
 	m_primitiveBatch = std::make_unique<PrimitiveBatch<VertexPositionColor>>(pContext);
 
-	// x[VbNGtFNg̍쐬
+	// ベーシックエフェクトの作成
 	m_basicEffect = std::make_unique<BasicEffect>(pDevice);
 	m_basicEffect->SetVertexColorEnabled(true);
 	m_basicEffect->SetLightingEnabled(false);
 	m_basicEffect->SetTextureEnabled(false);
 
-	// ̓CAEg̍쐬
+	// 入力レイアウトの作成
 	DX::ThrowIfFailed(
 		CreateInputLayoutFromEffect<VertexPositionColor>(
 			pDevice,
@@ -53,26 +53,26 @@ void GridFloor::Render(
 	const SimpleMath::Matrix& proj
 )
 {
-	// uhXe[g̐ݒisj
+	// ブレンドステートの設定（不透明）
 	pContext->OMSetBlendState(m_pStates->Opaque(), nullptr, 0xFFFFFFFF);
-	// [xobt@̐ݒiʏj
+	// 深度バッファの設定（通常）
 	pContext->OMSetDepthStencilState(m_pStates->DepthDefault(), 0);
-	// JO̐ݒiJOȂj
+	// カリングの設定（カリングなし）
 	pContext->RSSetState(m_pStates->CullNone());
 
-	// es̐ݒ
+	// 各行列の設定
 	SimpleMath::Matrix world;
 	m_basicEffect->SetWorld(world);
 	m_basicEffect->SetView(view);
 	m_basicEffect->SetProjection(proj);
 
-	// GtFNgKp
+	// エフェクトを適用する
 	m_basicEffect->Apply(pContext);
 
-	// ̓CAEgݒ
+	// 入力レイアウトを設定
 	pContext->IASetInputLayout(m_inputLayout.Get());
 
-	// Obh̏`
+	// グリッドの床を描画
 	m_primitiveBatch->Begin();
 
 	DX::DrawGrid(
@@ -1,7 +1,7 @@
 //--------------------------------------------------------------------------------------
 // File: GridFloor.h
 //
-// Obh̏`悷NX
+// グリッドの床を描画するクラス
 //
 // Date: 2023.5.6
 // Author: Hideyasu Imase
@@ -10,12 +10,12 @@
 
 namespace Imase
 {
-	// Obh̏\^XN
+	// グリッドの床を表示するタスク
 	class GridFloor
 	{
 	public:
 
-		// RXgN^
+		// コンストラクタ
 		GridFloor(
 			ID3D11Device* pDevice,
 			ID3D11DeviceContext* pContext,
@@ -25,7 +25,7 @@ namespace Imase
 			size_t divs = FLOOR_DIVS
 		);
 
-		// `
+		// 描画
 		void Render(
 			ID3D11DeviceContext* pContext,
 			const DirectX::SimpleMath::Matrix& view,
@@ -34,42 +34,42 @@ namespace Imase
 
 	private:
 
-		// ʃXe[gւ̃|C^
+		// 共通ステートへのポインタ
 		DirectX::CommonStates* m_pStates;
 
-		// x[VbNGtFNgւ̃|C^
+		// ベーシックエフェクトへのポインタ
 		std::unique_ptr<DirectX::BasicEffect> m_basicEffect;
 
-		// v~eBuob`ւ̃|C^
+		// プリミティブバッチへのポインタ
 		std::unique_ptr<DirectX::PrimitiveBatch<DirectX::VertexPositionColor>> m_primitiveBatch;
 
-		// ̓CAEg
+		// 入力レイアウト
 		Microsoft::WRL::ComPtr<ID3D11InputLayout> m_inputLayout;
 
-		// TCY
+		// サイズ
 		float m_size;
 
-		// 
+		// 分割数
 		size_t m_divs;
 
-		// \F
+		// 表示色
 		DirectX::SimpleMath::Color m_color;
 
 	public:
 
-		// 1ӂ̃TCY
+		// 床の1辺のサイズ
 		static const float FLOOR_SIZE;
 
-		// 
+		// 分割数
 		static const size_t FLOOR_DIVS = 10;
 
-		// ̂Pӂ̃TCYύX֐
+		// 床の１辺のサイズを変更する関数
 		void SetSize(float size) { m_size = size; }
 
-		// ̕ύX֐
+		// 床の分割数を変更する関数
 		void SetDivs(size_t divs) { m_divs = divs; }
 
-		// Fݒ肷֐
+		// 色を設定する関数
 		void SetColor(DirectX::FXMVECTOR color) { m_color = color; }
 
 	};
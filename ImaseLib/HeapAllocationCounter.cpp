@@ -0,0 +1,82 @@
+//--------------------------------------------------------------------------------------
+// File: HeapAllocationCounter.cpp
+//
+// ヒープの確保回数を数えるクラス（デバッグ用）
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "pch.h"
+#include "HeapAllocationCounter.h"
+
+#include <new>
+
+namespace
+{
+    // 全てのスレッドの確保回数
+    std::atomic<uint64_t> s_allocationCount{ 0 };
+
+    // スレッド毎の確保回数（operator new から使うので動的な初期化をしない型にする）
+    thread_local uint64_t t_allocationCount = 0;
+}
+
+// これまでの確保回数を取得する関数
+uint64_t Imase::HeapAllocationCounter::GetCount()
+{
+    return s_allocationCount.load(std::memory_order_relaxed);
+}
+
+// 現在のスレッドのこれまでの確保回数を取得する関数
+uint64_t Imase::HeapAllocationCounter::GetThreadCount()
+{
+    return t_allocationCount;
+}
+
+// 確保回数を増やす関数
+void Imase::HeapAllocationCounter::Increment()
+{
+    s_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    t_allocationCount++;
+}
+
+#ifdef _DEBUG
+
+// 全体の operator new の置き換え（アライメント指定の new は既定のまま数えない）
+
+void* operator new(size_t size)
+{
+    Imase::HeapAllocationCounter::Increment();
+
+    if (void* p = std::malloc(size ? size : 1))
+    {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size)
+{
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept
+{
+    std::free(p);
+}
+
+void operator delete(void* p, size_t) noexcept
+{
+    std::free(p);
+}
+
+void operator delete[](void* p, size_t) noexcept
+{
+    std::free(p);
+}
+
+#endif
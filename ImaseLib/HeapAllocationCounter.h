@@ -0,0 +1,61 @@
+//--------------------------------------------------------------------------------------
+// File: HeapAllocationCounter.h
+//
+// ヒープの確保回数を数えるクラス（デバッグ用）
+//
+// デバッグビルドでは全体の operator new を置き換えて確保回数を数えます
+// 毎フレームの処理でヒープを確保していないことの確認に使います
+// 確保回数は全体とスレッド毎の両方を数え、確認は作成したスレッドの確保だけを対象にします
+// （ロード用のスレッドなど、他のスレッドの確保で失敗しないようにするため）
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include <atomic>
+
+namespace Imase
+{
+    class HeapAllocationCounter
+    {
+    public:
+
+        // これまでの確保回数を取得する関数（全てのスレッドの合計、リリースビルドでは常に 0）
+        static uint64_t GetCount();
+
+        // 現在のスレッドのこれまでの確保回数を取得する関数（リリースビルドでは常に 0）
+        static uint64_t GetThreadCount();
+
+        // 確保回数を増やす関数（operator new から呼ばれる）
+        static void Increment();
+
+    };
+
+    // スコープ内で現在のスレッドがヒープを確保していないことを確認するクラス
+    // （ワーカースレッドなど、他のスレッドの確保は数えない）
+    class HeapAllocationCheck
+    {
+        uint64_t m_startCount;
+        bool m_enabled;
+
+    public:
+
+        explicit HeapAllocationCheck(bool enabled = true)
+            : m_startCount{ HeapAllocationCounter::GetThreadCount() }
+            , m_enabled{ enabled }
+        {
+        }
+
+        ~HeapAllocationCheck()
+        {
+            assert(!m_enabled || HeapAllocationCounter::GetThreadCount() == m_startCount);
+        }
+
+        HeapAllocationCheck(const HeapAllocationCheck&) = delete;
+        HeapAllocationCheck& operator=(const HeapAllocationCheck&) = delete;
+
+        // スコープ内の現在のスレッドの確保回数を取得する関数
+        uint64_t GetCount() const { return HeapAllocationCounter::GetThreadCount() - m_startCount; }
+    };
+}
@@ -1,7 +1,7 @@
 //--------------------------------------------------------------------------------------
 // File: Imdl.h
 //
-// ff[^ʃwb_iϊRo[^[Ɠǂݍݑʁj
+// モデルデータ共通ヘッダ（変換コンバーターと読み込み側共通）
 //
 // Date: 2026.2.16
 // Author: Hideyasu Imase
@@ -9,47 +9,50 @@
 #pragma once
 
 #include <vector>
+#include <span>
+#include <type_traits>
 #include <DirectXMath.h>
+#include <DirectXPackedVector.h>
 
 namespace Imase
 {
-    // }eA
+    // マテリアル情報
     struct MaterialInfo
     {
         // -------------------
-        // {F / PBRp[^
+        // 基本色 / PBRパラメータ
         // -------------------
-        DirectX::XMFLOAT4 diffuseColor = { 1.0f, 1.0f, 1.0f, 1.0f };    // BaseColor ()
-        float metallicFactor = 0.0f;                                    // x (0:, 1:)
-        float roughnessFactor = 1.0f;                                   // e (0:cc, 1:e)
-        DirectX::XMFLOAT3 emissiveColor = { 0.0f, 0.0f, 0.0f };         // ːF
-        float emissiveStrength = 1.0f;                                  // x
+        DirectX::XMFLOAT4 diffuseColor = { 1.0f, 1.0f, 1.0f, 1.0f };    // BaseColor (白)
+        float metallicFactor = 0.0f;                                    // 金属度 (0:非金属, 1:金属)
+        float roughnessFactor = 1.0f;                                   // 粗さ (0:ツルツル, 1:粗い)
+        DirectX::XMFLOAT3 emissiveColor = { 0.0f, 0.0f, 0.0f };         // 放射色
+        float emissiveStrength = 1.0f;                                  // 発光強度
 
         // -------------------
-        // eNX`CfbNX (-1 = )
+        // テクスチャインデックス (-1 = 無効)
         // -------------------
-        int baseColorTexIndex = -1;   // BaseColor eNX`
-        int normalTexIndex = -1;      // NormalMap eNX`
-        int metalRoughTexIndex = -1;  // Metallic-Roughness eNX`
-        int emissiveTexIndex = -1;    // Emissive eNX`
+        int baseColorTexIndex = -1;   // BaseColor テクスチャ
+        int normalTexIndex = -1;      // NormalMap テクスチャ
+        int metalRoughTexIndex = -1;  // Metallic-Roughness テクスチャ
+        int emissiveTexIndex = -1;    // Emissive テクスチャ
     };
 
-    // TubV
+    // サブメッシュ情報
     struct SubMeshInfo
     {
-        uint32_t startIndex;        // X^[gCfbNX  
-        uint32_t indexCount;        // CfbNX
-        uint32_t materialIndex;     // }eACfbNX
+        uint32_t startIndex;        // スタートインデックス  
+        uint32_t indexCount;        // インデックス数
+        uint32_t materialIndex;     // マテリアルインデックス
     };
 
-    // bVO[v
+    // メッシュグループ情報
     struct MeshGroupInfo
     {
         uint32_t subMeshStart;
         uint32_t subMeshCount;
     };
 
-    // m[h
+    // ノード情報
     struct NodeInfo
     {
         int32_t meshGroupIndex;
@@ -61,21 +64,70 @@ namespace Imase
         DirectX::XMFLOAT3 defaultScale;
     };
 
-    // _
+    // 頂点情報
     struct VertexPositionNormalTextureTangent
     {
-        DirectX::XMFLOAT3 position;    // ʒu
-        DirectX::XMFLOAT3 normal;      // @
-        DirectX::XMFLOAT2 texcoord;    // eNX`W
-        DirectX::XMFLOAT4 tangent;     // xyz = ڐ, w = ]ڐ̌𒲐i1,-1)
+        DirectX::XMFLOAT3 position;    // 位置
+        DirectX::XMFLOAT3 normal;      // 法線
+        DirectX::XMFLOAT2 texcoord;    // テクスチャ座標
+        DirectX::XMFLOAT4 tangent;     // xyz = 接線, w = 従接線の向きを調整（1,-1)
 
-        // ----- XLjOp ----- //
+        // ----- スキニング用 ----- //
         DirectX::XMUINT4 joint;
         DirectX::XMFLOAT4 weight;
     };
 
+    // 頂点情報（圧縮形式：32バイト）
+    struct VertexPacked
+    {
+        DirectX::XMFLOAT3 position;                     // 位置
+        DirectX::PackedVector::XMSHORTN4 normalTangent; // 八面体エンコードした法線(xy)と接線(zw)
+        DirectX::PackedVector::XMHALF2 texcoord;        // テクスチャ座標
+
+        // ----- スキニング用 ----- //
+        DirectX::PackedVector::XMUBYTE4 joint;          // ジョイントインデックス（MaxBones <= 256）
+        DirectX::PackedVector::XMUBYTEN4 weight;        // xyz = ウエイト（w は 1 - x - y - z で復元）, w = 従接線の向き（0:-1, 1:+1）
+    };
+
+    // 頂点情報（圧縮形式＋位置をメッシュのAABBで量子化：28バイト）
+    struct VertexPackedQuantized
+    {
+        DirectX::PackedVector::XMUSHORTN4 position;     // AABB内の正規化位置（w は未使用）
+        DirectX::PackedVector::XMSHORTN4 normalTangent; // 八面体エンコードした法線(xy)と接線(zw)
+        DirectX::PackedVector::XMHALF2 texcoord;        // テクスチャ座標
+
+        // ----- スキニング用 ----- //
+        DirectX::PackedVector::XMUBYTE4 joint;          // ジョイントインデックス（MaxBones <= 256）
+        DirectX::PackedVector::XMUBYTEN4 weight;        // xyz = ウエイト（w は 1 - x - y - z で復元）, w = 従接線の向き（0:-1, 1:+1）
+    };
+
+    // 圧縮頂点用フラグ
+    enum PackedVertexFlags : uint32_t
+    {
+        PACKED_VERTEX_QUANTIZED_POSITION = 1 << 0,      // 位置を量子化（VertexPackedQuantized）
+    };
+
+    // 圧縮頂点チャンクのヘッダ
+    struct PackedVertexHeader
+    {
+        uint32_t flags;                 // PackedVertexFlags
+        DirectX::XMFLOAT3 boundsMin;    // 量子化に使ったAABB
+        DirectX::XMFLOAT3 boundsMax;
+    };
+
+    // -------------------------------------------------------------------------------------- //
+    // v2 以降はレコード配列を構造体のままファイルへ格納するためレイアウトを固定する
+    static_assert(sizeof(MaterialInfo) == 56 && std::is_trivially_copyable_v<MaterialInfo>);
+    static_assert(sizeof(SubMeshInfo) == 12 && std::is_trivially_copyable_v<SubMeshInfo>);
+    static_assert(sizeof(MeshGroupInfo) == 8 && std::is_trivially_copyable_v<MeshGroupInfo>);
+    static_assert(sizeof(NodeInfo) == 52 && std::is_trivially_copyable_v<NodeInfo>);
+    static_assert(sizeof(VertexPositionNormalTextureTangent) == 80 && std::is_trivially_copyable_v<VertexPositionNormalTextureTangent>);
+    static_assert(sizeof(VertexPacked) == 32 && std::is_trivially_copyable_v<VertexPacked>);
+    static_assert(sizeof(VertexPackedQuantized) == 28 && std::is_trivially_copyable_v<VertexPackedQuantized>);
+    static_assert(sizeof(PackedVertexHeader) == 28 && std::is_trivially_copyable_v<PackedVertexHeader>);
+
     // -------------------------------------------------------------------------------------- //
-    // wb_
+    // ヘッダ
     struct FileHeader
     {
         uint32_t magic;      // 'IMDL'
@@ -83,7 +135,27 @@ namespace Imase
         uint32_t chunkCount;
     };
 
-    // `N^Cv
+    // マジックナンバー
+    static constexpr uint32_t IMDL_MAGIC = 0x4C444D49;  // 'IMDL'
+
+    // バージョン
+    //  v1 : 各フィールドを順番に書き出した形式
+    //  v2 : レコード配列を【uint32_t】(count) + 【uint32_t】(stride) + 構造体 * count で格納
+    //       チャンクと文字列は4バイト境界にパディングし、配列を構造体のまま参照できるようにする
+    //  v3 : v2 に加えてヘッダの直後にチャンクディレクトリを格納
+    static constexpr uint32_t IMDL_VERSION_1 = 1;
+    static constexpr uint32_t IMDL_VERSION_2 = 2;
+    static constexpr uint32_t IMDL_VERSION_3 = 3;
+
+    // チャンクディレクトリ（v3 以降はヘッダの直後に chunkCount 個並ぶ）
+    struct ChunkDirectoryEntry
+    {
+        uint32_t type;      // チャンクタイプ
+        uint32_t size;      // データサイズ
+        uint64_t offset;    // データ先頭のファイル位置（チャンクヘッダの直後）
+    };
+
+    // チャンクタイプ
     enum ChunkType : uint32_t
     {
         CHUNK_TEXTURE = 'TXTR',
@@ -94,10 +166,12 @@ namespace Imase
         CHUNK_VERTEX = 'VERT',
         CHUNK_INDEX = 'INDX',
         CHUNK_ANIMATION = 'ANIM',
-        CHUNK_SKIN = 'SKIN'
+        CHUNK_SKIN = 'SKIN',
+        CHUNK_VERTEX_PACKED = 'VTXP',   // PackedVertexHeader + 圧縮頂点の配列
+        CHUNK_INDEX_COMPRESSED = 'INDC' // インデックス数 + バイト数 + 圧縮インデックス（IndexCompression.h）
     };
 
-    // eNX`^Cv
+    // テクスチャタイプ
     enum class TextureType
     {
         BaseColor,
@@ -106,18 +180,25 @@ namespace Imase
         Emissive
     };
 
-    // eNX`f[^
+    // テクスチャデータ
     struct TextureEntry
     {
-        TextureType type;           // 
-        std::vector<uint8_t> data;  // f[^
+        TextureType type;           // 種類
+        std::vector<uint8_t> data;  // データ
+    };
+
+    // テクスチャデータ（読み込み元バッファを直接参照）
+    struct TextureView
+    {
+        TextureType type;               // 種類
+        std::span<const uint8_t> data;  // データ
     };
 
     // -------------------------------------------------------------------------------------- //
-    // Aj[V
+    // アニメーション
     // -------------------------------------------------------------------------------------- //
 
-    // sړAXP[Ɏgp 
+    // 平行移動、スケールに使用 
     struct AnimationChannelVec3
     {
         uint32_t nodeIndex;
@@ -126,7 +207,7 @@ namespace Imase
         std::vector<DirectX::XMFLOAT3> values;
     };
 
-    // ]Ɏgp
+    // 回転に使用
     struct AnimationChannelQuat
     {
         uint32_t nodeIndex;
@@ -135,22 +216,22 @@ namespace Imase
         std::vector<DirectX::XMFLOAT4> values;
     };
 
-    // Aj[VNbv
+    // アニメーションクリップ
     struct AnimationClip
     {
-        std::string name;   // Aj[V̖O
-        float duration;     // Aj[V̎
+        std::string name;   // アニメーションの名前
+        float duration;     // アニメーションの時間
 
-        std::vector<AnimationChannelVec3> translations; // ړ
-        std::vector<AnimationChannelQuat> rotations;    // ]
-        std::vector<AnimationChannelVec3> scales;       // XP[
+        std::vector<AnimationChannelVec3> translations; // 移動
+        std::vector<AnimationChannelQuat> rotations;    // 回転
+        std::vector<AnimationChannelVec3> scales;       // スケール
     };
 
     // -------------------------------------------------------------------------------------- //
-    // XL
+    // スキン
     // -------------------------------------------------------------------------------------- //
  
-    // XL
+    // スキン情報
     struct SkinInfo
     {
         int32_t rootNode;
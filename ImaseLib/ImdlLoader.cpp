@@ -1,7 +1,7 @@
 //--------------------------------------------------------------------------------------
 // File: ImdlLoader.cpp
 //
-// Imdl`̃ff[^[hNX
+// Imdl形式のモデルデータをロードするクラス
 //
 // Date: 2025.3.1
 // Author: Hideyasu Imase
@@ -9,8 +9,103 @@
 #include "pch.h"
 #include "ImdlLoader.h"
 #include "ChunkIO.h"
+#include "VertexPacking.h"
+#include "IndexCompression.h"
+#include "JobSystem.h"
 
-// [h֐i}eAj
+#include <mutex>
+#include <chrono>
+#include <sstream>
+
+namespace
+{
+	// バッファを T の配列として参照する関数
+	// アライメントが合わない場合は storage へコピーしてそちらを参照する
+	template<typename T>
+	std::span<const T> ViewAs(const uint8_t* p, uint32_t count, std::vector<T>& storage)
+	{
+		if (reinterpret_cast<uintptr_t>(p) % alignof(T) == 0)
+		{
+			return std::span<const T>(reinterpret_cast<const T*>(p), count);
+		}
+
+		storage.resize(count);
+		std::memcpy(storage.data(), p, sizeof(T) * count);
+		return std::span<const T>(storage);
+	}
+
+	// 要素数を読み取る関数
+	// 壊れた個数で大きな領域を確保しないように、要素の最小サイズで残りのサイズに収まるか調べる
+	uint32_t ReadElementCount(Imase::BinaryReader& reader, size_t minElementSize)
+	{
+		uint32_t count = reader.ReadUInt32();
+		if (count > reader.GetRemainingSize() / minElementSize)
+		{
+			throw std::runtime_error("IMDL element count exceeds chunk size");
+		}
+		return count;
+	}
+
+	// レコード配列の個数を読み取る関数（v2 はストライドが構造体と一致するか検証する）
+	uint32_t ReadRecordCount(Imase::BinaryReader& reader, uint32_t version, size_t stride)
+	{
+		uint32_t count = reader.ReadUInt32();
+
+		if (version >= Imase::IMDL_VERSION_2 && reader.ReadUInt32() != stride)
+		{
+			throw std::runtime_error("IMDL record stride mismatch");
+		}
+
+		return count;
+	}
+
+	// インデックスが全て頂点数の範囲内か調べる関数
+	bool ValidateIndices(std::span<const uint32_t> indices, size_t vertexCount)
+	{
+		for (uint32_t index : indices)
+		{
+			if (index >= vertexCount)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// サブメッシュのインデックスの範囲がインデックス配列に収まっているか調べる関数
+	bool ValidateSubMeshes(std::span<const Imase::SubMeshInfo> subMeshes, size_t indexCount)
+	{
+		for (const auto& mesh : subMeshes)
+		{
+			if (static_cast<uint64_t>(mesh.startIndex) + mesh.indexCount > indexCount)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// レコード配列を一括で読み取る関数（サイズの検証は１回のみ）
+	template<typename T>
+	void ReadRecords(Imase::BinaryReader& reader, uint32_t version, std::vector<T>& out)
+	{
+		uint32_t count = ReadRecordCount(reader, version, sizeof(T));
+
+		// 壊れた個数で大きな領域を確保しないように、確保する前にチャンクの残りのサイズと比べる
+		if (count > reader.GetRemainingSize() / sizeof(T))
+		{
+			throw std::runtime_error("IMDL record count exceeds chunk size");
+		}
+
+		out.resize(count);
+		if (count > 0)
+		{
+			reader.ReadBytes(out.data(), sizeof(T) * count);
+		}
+	}
+}
+
+// ロードする関数（マテリアル）
 Imase::MaterialInfo Imase::ImdlLoader::DeserializeMaterial(BinaryReader& reader)
 {
 	MaterialInfo m{};
@@ -35,84 +130,7 @@ Imase::MaterialInfo Imase::ImdlLoader::DeserializeMaterial(BinaryReader& reader)
 	return m;
 }
 
-// [h֐i_j
-Imase::VertexPositionNormalTextureTangent Imase::ImdlLoader::DeserializeVertex(BinaryReader& reader)
-{
-	VertexPositionNormalTextureTangent v{};
-
-	v.position.x = reader.ReadFloat();
-	v.position.y = reader.ReadFloat();
-	v.position.z = reader.ReadFloat();
-
-	v.normal.x = reader.ReadFloat();
-	v.normal.y = reader.ReadFloat();
-	v.normal.z = reader.ReadFloat();
-
-	v.texcoord.x = reader.ReadFloat();
-	v.texcoord.y = reader.ReadFloat();
-
-	v.tangent.x = reader.ReadFloat();
-	v.tangent.y = reader.ReadFloat();
-	v.tangent.z = reader.ReadFloat();
-	v.tangent.w = reader.ReadFloat();
-
-	v.joint.x = reader.ReadUInt32();
-	v.joint.y = reader.ReadUInt32();
-	v.joint.z = reader.ReadUInt32();
-	v.joint.w = reader.ReadUInt32();
-
-	v.weight.x = reader.ReadFloat();
-	v.weight.y = reader.ReadFloat();
-	v.weight.z = reader.ReadFloat();
-	v.weight.w = reader.ReadFloat();
-
-	return v;
-}
-
-// [h֐ibVj
-Imase::SubMeshInfo Imase::ImdlLoader::DeserializeSubMesh(BinaryReader& reader)
-{
-	SubMeshInfo m{};
-	m.startIndex = reader.ReadUInt32();
-	m.indexCount = reader.ReadUInt32();
-	m.materialIndex = reader.ReadUInt32();
-	return m;
-}
-
-// [h֐ibVO[vj
-Imase::MeshGroupInfo Imase::ImdlLoader::DeserializeMeshGroup(BinaryReader& reader)
-{
-	MeshGroupInfo m{};
-	m.subMeshStart = reader.ReadUInt32();
-	m.subMeshCount = reader.ReadUInt32();
-	return m;
-}
-
-Imase::NodeInfo Imase::ImdlLoader::DeserializeNode(BinaryReader& reader)
-{
-	NodeInfo m{};
-
-	m.meshGroupIndex = reader.ReadInt32();
-	m.parentIndex = reader.ReadInt32();
-	m.skinIndex = reader.ReadInt32();
-
-	m.defaultTranslation.x = reader.ReadFloat();
-	m.defaultTranslation.y = reader.ReadFloat();
-	m.defaultTranslation.z = reader.ReadFloat();
-
-	m.defaultRotation.x = reader.ReadFloat();
-	m.defaultRotation.y = reader.ReadFloat();
-	m.defaultRotation.z = reader.ReadFloat();
-	m.defaultRotation.w = reader.ReadFloat();
-
-	m.defaultScale.x = reader.ReadFloat();
-	m.defaultScale.y = reader.ReadFloat();
-	m.defaultScale.z = reader.ReadFloat();
-
-	return m;
-}
-
-// [h֐iVector3̔zj
+// ロードする関数（Vector3の配列）
 Imase::AnimationChannelVec3 Imase::ImdlLoader::DeserializeChannelVec3(BinaryReader& reader)
 {
 	AnimationChannelVec3 m = {};
@@ -124,7 +142,7 @@ Imase::AnimationChannelVec3 Imase::ImdlLoader::DeserializeChannelVec3(BinaryRead
 	return m;
 }
 
-// [h֐iNH[^jI̔zj
+// ロードする関数（クォータニオンの配列）
 Imase::AnimationChannelQuat Imase::ImdlLoader::DeserializeChannelQuat(BinaryReader& reader)
 {
 	AnimationChannelQuat m = {};
@@ -136,29 +154,37 @@ Imase::AnimationChannelQuat Imase::ImdlLoader::DeserializeChannelQuat(BinaryRead
 	return m;
 }
 
-// [h֐iAj[Vj
-Imase::AnimationClip Imase::ImdlLoader::DeserializeAnimationClip(BinaryReader& reader)
+// ロードする関数（アニメーション）
+Imase::AnimationClip Imase::ImdlLoader::DeserializeAnimationClip(BinaryReader& reader, uint32_t version)
 {
 	AnimationClip m = {};
 
 	m.name = reader.ReadString();
+	if (version >= IMDL_VERSION_2)
+	{
+		// 以降の配列が4バイト境界に揃うようにパディングされている
+		reader.Align(4);
+	}
 	m.duration = reader.ReadFloat();
 
-	uint32_t count = reader.ReadUInt32();
+	// チャンネルは最小でノード番号と２つの配列の個数（12バイト）
+	constexpr size_t MinChannelSize = 12;
+
+	uint32_t count = ReadElementCount(reader, MinChannelSize);
 	m.translations.resize(count);
 	for (uint32_t i = 0; i < count; i++)
 	{
 		m.translations[i] = DeserializeChannelVec3(reader);
 	}
 
-	count = reader.ReadUInt32();
+	count = ReadElementCount(reader, MinChannelSize);
 	m.rotations.resize(count);
 	for (uint32_t i = 0; i < count; i++)
 	{
 		m.rotations[i] = DeserializeChannelQuat(reader);
 	}
 
-	count = reader.ReadUInt32();
+	count = ReadElementCount(reader, MinChannelSize);
 	m.scales.resize(count);
 	for (uint32_t i = 0; i < count; i++)
 	{
@@ -168,7 +194,7 @@ Imase::AnimationClip Imase::ImdlLoader::DeserializeAnimationClip(BinaryReader& r
 	return m;
 }
 
-// [h֐iXLj
+// ロードする関数（スキン）
 Imase::SkinInfo Imase::ImdlLoader::DeserializeSkinInfo(BinaryReader& reader)
 {
 	SkinInfo m = {};
@@ -180,7 +206,145 @@ Imase::SkinInfo Imase::ImdlLoader::DeserializeSkinInfo(BinaryReader& reader)
 	return m;
 }
 
-// Imdl̃[h֐
+// チャンクを解析する関数
+void Imase::ImdlLoader::ParseChunk(uint32_t type, BinaryReader& reader, ImdlMappedData& data)
+{
+	switch (type)
+	{
+
+	case CHUNK_TEXTURE:		// TextureType
+	{
+		// テクスチャの数（１つあたり最小で種類とサイズの８バイト）
+		uint32_t count = ReadElementCount(reader, 8);
+		data.textures.resize(count);
+
+		for (uint32_t j = 0; j < count; j++)
+		{
+			// テクスチャ（DDSデータはコピーせずに参照）
+			data.textures[j].type = static_cast<TextureType>(reader.ReadUInt32());
+			uint32_t size = reader.ReadUInt32();
+			data.textures[j].data = std::span<const uint8_t>(reader.ReadView(size), size);
+		}
+		break;
+	}
+
+	case CHUNK_MATERIAL:	// MaterialInfo
+	{
+		if (data.version >= IMDL_VERSION_2)
+		{
+			ReadRecords(reader, data.version, data.materials);
+		}
+		else
+		{
+			// v1 は emissiveStrength を含まないためフィールド毎に読み取る
+			// １つあたり 4 バイトの値が 13 個
+			uint32_t count = ReadElementCount(reader, sizeof(float) * 13);
+			data.materials.reserve(count);
+			for (uint32_t j = 0; j < count; j++)
+			{
+				data.materials.push_back(DeserializeMaterial(reader));
+			}
+		}
+		break;
+	}
+
+	// 以下は v1 でもファイル上の並びが構造体と同一なので一括で読み取る
+
+	case CHUNK_SUBMESH:		// SubMeshInfo
+	{
+		ReadRecords(reader, data.version, data.subMeshes);
+		break;
+	}
+
+	case CHUNK_MESHGROUP:	// MeshGroupInfo
+	{
+		ReadRecords(reader, data.version, data.meshGroups);
+		break;
+	}
+
+	case CHUNK_NODE:	// NodeInfo
+	{
+		ReadRecords(reader, data.version, data.nodes);
+		break;
+	}
+
+	case CHUNK_VERTEX:		// VertexPositionNormalTextureTangent
+	{
+		uint32_t count = ReadRecordCount(reader, data.version, sizeof(VertexPositionNormalTextureTangent));
+		const uint8_t* p = reader.ReadView(sizeof(VertexPositionNormalTextureTangent) * count);
+		data.vertices = ViewAs(p, count, data.vertexStorage);
+		break;
+	}
+
+	case CHUNK_INDEX:		// uint32_t
+	{
+		uint32_t count = ReadRecordCount(reader, data.version, sizeof(uint32_t));
+		const uint8_t* p = reader.ReadView(sizeof(uint32_t) * count);
+		data.indices = ViewAs(p, count, data.indexStorage);
+		break;
+	}
+
+	case CHUNK_INDEX_COMPRESSED:	// uint32_t の圧縮ストリーム
+	{
+		uint32_t count = reader.ReadUInt32();
+		uint32_t size = reader.ReadUInt32();
+		const uint8_t* p = reader.ReadView(size);
+
+		// 三角形毎に少なくとも1バイトのコードがあるので、それより多い個数は壊れたデータ
+		if (count > static_cast<uint64_t>(size) * 3)
+		{
+			throw std::runtime_error("IMDL index count exceeds compressed stream");
+		}
+
+		data.indexStorage.resize(count);
+		DecodeIndexStream(std::span<const uint8_t>(p, size), data.indexStorage);
+		data.indices = data.indexStorage;
+		break;
+	}
+
+	case CHUNK_VERTEX_PACKED:	// PackedVertexHeader + VertexPacked / VertexPackedQuantized
+	{
+		reader.ReadBytes(&data.packedVertexHeader, sizeof(PackedVertexHeader));
+
+		// GPUへ転送するだけなのでバイト列のまま参照する
+		uint32_t stride = GetPackedVertexStride(data.packedVertexHeader.flags);
+		uint32_t count = ReadRecordCount(reader, data.version, stride);
+		size_t size = static_cast<size_t>(stride) * count;
+		data.packedVertices = std::span<const uint8_t>(reader.ReadView(size), size);
+		data.packedVertexCount = count;
+		break;
+	}
+
+	case CHUNK_ANIMATION:	// AnimationClip
+	{
+		// １つあたり最小で名前の長さ、長さ、３つのチャンネル数（20バイト）
+		uint32_t count = ReadElementCount(reader, 20);
+		data.animationClips.reserve(count);
+		for (uint32_t j = 0; j < count; j++)
+		{
+			data.animationClips.push_back(DeserializeAnimationClip(reader, data.version));
+		}
+		break;
+	}
+
+	case CHUNK_SKIN:	// SkinInfo
+	{
+		// １つあたり最小でルートノードと２つの配列の個数（12バイト）
+		uint32_t count = ReadElementCount(reader, 12);
+		data.skins.reserve(count);
+		for (uint32_t j = 0; j < count; j++)
+		{
+			data.skins.push_back(DeserializeSkinInfo(reader));
+		}
+		break;
+	}
+
+	default:
+		throw std::runtime_error("Unknown chunk type");
+	}
+}
+
+// Imdlのロード関数
 HRESULT Imase::ImdlLoader::LoadImdl
 (
 	const std::wstring& filename,
@@ -195,143 +359,407 @@ HRESULT Imase::ImdlLoader::LoadImdl
 	std::vector<uint32_t>& indices
 )
 {
-	// t@CI[v
-	std::ifstream ifs(filename, std::ios::binary);
-	if (!ifs.is_open())
+	ImdlMappedData data;
+
+	HRESULT hr = LoadImdlMapped(filename, data);
+	if (FAILED(hr))
+	{
+		return hr;
+	}
+
+	// マップされたデータを呼び出し側のバッファへコピー
+	textures.resize(data.textures.size());
+	for (size_t i = 0; i < data.textures.size(); i++)
+	{
+		textures[i].type = data.textures[i].type;
+		textures[i].data.assign(data.textures[i].data.begin(), data.textures[i].data.end());
+	}
+
+	materials = std::move(data.materials);
+	subMeshes = std::move(data.subMeshes);
+	meshGroups = std::move(data.meshGroups);
+	nodes = std::move(data.nodes);
+	animationClips = std::move(data.animationClips);
+	skins = std::move(data.skins);
+	vertices.assign(data.vertices.begin(), data.vertices.end());
+	indices.assign(data.indices.begin(), data.indices.end());
+
+	return S_OK;
+}
+
+// チャンクディレクトリを読み込む関数
+bool Imase::ImdlLoader::ReadChunkDirectory(const FileHeader& header, ImdlMappedData& data)
+{
+	const uint8_t* bytes = data.file.Data();
+	size_t size = data.file.Size();
+
+	data.chunks.resize(header.chunkCount);
+
+	// v3 以降はヘッダ直後のディレクトリをそのまま使う
+	if (header.version >= IMDL_VERSION_3)
+	{
+		size_t directorySize = sizeof(ChunkDirectoryEntry) * header.chunkCount;
+		if (sizeof(header) + directorySize > size)
+		{
+			return false;
+		}
+		std::memcpy(data.chunks.data(), bytes + sizeof(header), directorySize);
+
+		for (const auto& entry : data.chunks)
+		{
+			if (entry.offset > size || entry.size > size - entry.offset)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	// それ以前はチャンクヘッダを順番に辿って作成する
+	size_t offset = sizeof(header);
+	for (auto& entry : data.chunks)
+	{
+		Imase::ChunkHeader ch{};
+		const uint8_t* payload = nullptr;
+
+		if (!Imase::ReadChunk(bytes, size, offset, ch, payload))
+		{
+			return false;
+		}
+
+		entry.type = ch.type;
+		entry.size = ch.size;
+		entry.offset = static_cast<uint64_t>(payload - bytes);
+	}
+	return true;
+}
+
+// Imdlのロード関数（メモリマップ、ゼロコピー）
+HRESULT Imase::ImdlLoader::LoadImdlMapped
+(
+	const std::wstring& filename,
+	ImdlMappedData& data,
+	const ImdlLoadOptions& options
+)
+{
+	using Clock = std::chrono::steady_clock;
+
+	// 経過時間（ミリ秒）を取得する関数
+	auto elapsed = [](Clock::time_point start)
+		{
+			return std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+		};
+
+	Clock::time_point startTime = Clock::now();
+
+	// ファイルをメモリマップ
+	if (!data.file.Open(filename))
 	{
 		return E_FAIL;
 	}
 
-	// wb_
+	const uint8_t* bytes = data.file.Data();
+	size_t size = data.file.Size();
+
+	// ヘッダ
 	FileHeader header{};
-	ifs.read(reinterpret_cast<char*>(&header), sizeof(header));
+	if (size < sizeof(header))
+	{
+		return E_FAIL;
+	}
+	std::memcpy(&header, bytes, sizeof(header));
 
-	if (header.magic != 0x4C444D49)	// 'IMDL'
+	if (header.magic != IMDL_MAGIC)	// 'IMDL'
 	{
 		return E_FAIL;
 	}
 
-	// `Nǂݍ
-	for (uint32_t i = 0; i < header.chunkCount; ++i)
+	// 対応バージョン
+	if (header.version < IMDL_VERSION_1 || header.version > IMDL_VERSION_3)
 	{
-		Imase::ChunkHeader ch{};
-		std::vector<uint8_t> buffer;
+		return E_FAIL;
+	}
+	data.version = header.version;
 
-		// `FNf[^ǂݍ
-		if (!Imase::ReadChunk(ifs, ch, buffer))
-			return E_FAIL;
+	// チャンクディレクトリ
+	if (!ReadChunkDirectory(header, data))
+	{
+		return E_FAIL;
+	}
 
-		// wTCỸf[^擾郊[_[
-		BinaryReader reader(buffer);
+	// 計測結果の格納先（チャンク毎に別の要素へ書き込むので並列でも競合しない）
+	bool collectStats = options.collectStats;
+	if (collectStats)
+	{
+		data.stats = {};
+		data.stats.fileSize = size;
+		data.stats.openMilliseconds = elapsed(startTime);
+		data.stats.chunks.resize(data.chunks.size());
+	}
 
-		switch (ch.type)
-		{
+	Clock::time_point decodeTime = Clock::now();
 
-		case CHUNK_TEXTURE:		// TextureType
+	// チャンクを解析する関数
+	auto parse = [&data, bytes, collectStats, &elapsed](const ChunkDirectoryEntry& entry)
 		{
-			// eNX`̐
-			uint32_t count = reader.ReadUInt32();
-			textures.resize(count);
+			Clock::time_point chunkTime = Clock::now();
 
-			for (uint32_t j = 0; j < count; j++)
+			// 指定サイズのデータを取得するリーダー
+			BinaryReader reader(bytes + entry.offset, entry.size);
+			ParseChunk(entry.type, reader, data);
+
+			if (collectStats)
 			{
-				// eNX`
-				textures[j].type = static_cast<TextureType>(reader.ReadUInt32());
-				uint32_t size = reader.ReadUInt32();
-				textures[j].data.resize(size);
-				reader.ReadBytes(textures[j].data.data(), size);
+				ChunkDecodeStats& stats = data.stats.chunks[&entry - data.chunks.data()];
+				stats.type = entry.type;
+				stats.size = entry.size;
+				stats.milliseconds = elapsed(chunkTime);
 			}
-			break;
-		}
+		};
 
-		case CHUNK_MATERIAL:	// MaterialInfo
+	if (!options.parallelDecode)
+	{
+		for (const auto& entry : data.chunks)
 		{
-			uint32_t count = reader.ReadUInt32();
-			materials.reserve(count);
-			for (uint32_t j = 0; j < count; j++)
-			{
-				materials.push_back(DeserializeMaterial(reader));
-			}
-			break;
+			parse(entry);
 		}
+	}
+	else
+	{
+		// 重いチャンクはジョブシステムで並列に解析する
+		// 書き込み先が同じチャンク（同じタイプ、INDX と INDC）は同時に解析しない
+		JobSystem& jobSystem = JobSystem::GetInstance();
+		JobCounter counter;
+		std::vector<uint32_t> launchedGroups;
 
-		case CHUNK_SUBMESH:		// SubMeshInfo
-		{
-			uint32_t count = reader.ReadUInt32();
-			subMeshes.reserve(count);
-			for (uint32_t j = 0; j < count; j++)
+		// 書き込み先が重なるチャンクは全ての解析が終わってからファイルの順に解析する
+		std::vector<const ChunkDirectoryEntry*> deferredChunks;
+
+		// 書き込み先のグループ（インデックスは非圧縮と圧縮で同じ格納先を使う）
+		auto writeGroup = [](uint32_t type)
 			{
-				subMeshes.push_back(DeserializeSubMesh(reader));
-			}
-			break;
-		}
+				return type == CHUNK_INDEX_COMPRESSED ? CHUNK_INDEX : type;
+			};
+
+		// ジョブの中の例外は待った後に再送出する
+		std::exception_ptr error;
+		std::mutex errorMutex;
 
-		case CHUNK_MESHGROUP:	// MeshGroupInfo
+		auto parseJob = [&](uint32_t index, uint32_t)
+			{
+				try
+				{
+					parse(data.chunks[index]);
+				}
+				catch (...)
+				{
+					std::lock_guard<std::mutex> lock(errorMutex);
+					if (!error) error = std::current_exception();
+				}
+			};
+
+		// 登録済みのジョブはこの関数のローカル変数を参照するので、例外が出ても必ず待ってから再送出する
+		try
 		{
-			uint32_t count = reader.ReadUInt32();
-			meshGroups.reserve(count);
-			for (uint32_t j = 0; j < count; j++)
+			for (const auto& entry : data.chunks)
 			{
-				meshGroups.push_back(DeserializeMeshGroup(reader));
+				bool heavy =
+					entry.type == CHUNK_VERTEX ||
+					entry.type == CHUNK_VERTEX_PACKED ||
+					entry.type == CHUNK_INDEX ||
+					entry.type == CHUNK_INDEX_COMPRESSED ||
+					entry.type == CHUNK_TEXTURE ||
+					entry.type == CHUNK_ANIMATION ||
+					entry.type == CHUNK_SKIN;
+
+				uint32_t group = writeGroup(entry.type);
+				bool duplicated = std::find(launchedGroups.begin(), launchedGroups.end(), group) != launchedGroups.end();
+
+				if (duplicated)
+				{
+					// 解析中のジョブと同じ格納先に書き込むので後回しにする
+					deferredChunks.push_back(&entry);
+				}
+				else if (heavy)
+				{
+					launchedGroups.push_back(group);
+					uint32_t index = static_cast<uint32_t>(&entry - data.chunks.data());
+					jobSystem.Schedule(JobSystem::MakeJob(parseJob, index, index + 1), &counter);
+				}
+				else
+				{
+					// 軽いチャンクは呼び出しスレッドで解析
+					parse(entry);
+				}
 			}
-			break;
 		}
-
-		case CHUNK_NODE:	// NodeInfo
+		catch (...)
 		{
-			uint32_t count = reader.ReadUInt32();
-			nodes.reserve(count);
-			for (uint32_t j = 0; j < count; j++)
-			{
-				nodes.push_back(DeserializeNode(reader));
-			}
-			break;
+			std::lock_guard<std::mutex> lock(errorMutex);
+			if (!error) error = std::current_exception();
 		}
 
-		case CHUNK_VERTEX:		// VertexPositionNormalTextureTangent
+		// GPUリソースを作成する前に全ての解析の完了を待つ（待っている間は他のジョブを実行する）
+		jobSystem.Wait(counter);
+
+		if (error)
 		{
-			uint32_t count = reader.ReadUInt32();
-			vertices.reserve(count);
-			for (uint32_t j = 0; j < count; j++)
-			{
-				vertices.push_back(DeserializeVertex(reader));
-			}
-			break;
+			std::rethrow_exception(error);
 		}
 
-		case CHUNK_INDEX:		// uint32_t
+		// 後回しにしたチャンク（逐次解析と同じく後のチャンクで上書きされる）
+		for (const ChunkDirectoryEntry* entry : deferredChunks)
 		{
-			indices = reader.ReadVector<uint32_t>();
-			break;
+			parse(*entry);
 		}
+	}
+
+	// 範囲外のインデックスは最適化や頂点バッファの参照で範囲外アクセスになるので読み込まない
+	size_t vertexCount = data.packedVertices.empty() ? data.vertices.size() : data.packedVertexCount;
+	if (!ValidateIndices(data.indices, vertexCount))
+	{
+		return E_FAIL;
+	}
+
+	// 範囲外のサブメッシュはインデックスバッファの作成や描画で範囲外アクセスになるので読み込まない
+	if (!ValidateSubMeshes(data.subMeshes, data.indices.size()))
+	{
+		return E_FAIL;
+	}
+
+	Clock::time_point postProcessTime = Clock::now();
+
+	// メッシュの最適化（圧縮頂点は頂点の並びが固定なので対象外）
+	if (options.optimizeMesh && data.packedVertices.empty())
+	{
+		OptimizeMeshData(data, options.vertexCacheSize);
+	}
+
+	// アニメーションの焼き込み
+	if (options.bakeSampleRate > 0.0f)
+	{
+		BakeAnimationData(data, options.bakeSampleRate);
+	}
+
+	if (collectStats)
+	{
+		data.stats.decodeMilliseconds = std::chrono::duration<double, std::milli>(postProcessTime - decodeTime).count();
+		data.stats.postProcessMilliseconds = elapsed(postProcessTime);
+		data.stats.totalMilliseconds = elapsed(startTime);
+	}
+
+	return S_OK;
+}
+
+// アニメーションクリップを焼き込む関数
+void Imase::ImdlLoader::BakeAnimationData(ImdlMappedData& data, float sampleRate)
+{
+	data.bakedAnimationClips.resize(data.animationClips.size());
+	data.bakeReports.resize(data.animationClips.size());
 
-		case CHUNK_ANIMATION:	// AnimationClip
+	for (size_t i = 0; i < data.animationClips.size(); i++)
+	{
+		data.bakedAnimationClips[i] = BakeAnimationClip(data.animationClips[i], sampleRate, &data.bakeReports[i]);
+	}
+
+#ifdef _DEBUG
+	for (size_t i = 0; i < data.bakeReports.size(); i++)
+	{
+		const auto& report = data.bakeReports[i];
+		char text[256];
+		sprintf_s(text, "IMDL bake %s (%.0f Hz): translation %.5f, rotation %.5f rad, scale %.5f\n",
+			data.animationClips[i].name.c_str(), sampleRate,
+			report.maxTranslationError, report.maxRotationError, report.maxScaleError);
+		OutputDebugStringA(text);
+	}
+#endif
+}
+
+// 計測結果をJSON形式の文字列にする関数
+std::string Imase::ImdlLoader::FormatStatsJson(const std::wstring& filename, const ImdlLoadStats& stats)
+{
+	// チャンクタイプ（'VERT' など）を文字列にする関数
+	auto typeName = [](uint32_t type)
 		{
-			uint32_t count = reader.ReadUInt32();
-			animationClips.reserve(count);
-			for (uint32_t j = 0; j < count; j++)
+			std::string name(4, ' ');
+			for (int i = 0; i < 4; i++)
 			{
-				animationClips.push_back(DeserializeAnimationClip(reader));
+				name[i] = static_cast<char>((type >> (24 - i * 8)) & 0xff);
 			}
-			break;
-		}
+			return name;
+		};
 
-		case CHUNK_SKIN:	// SkinInfo
+	// ファイル名は ASCII 以外と記号をエスケープする
+	std::string name;
+	for (wchar_t c : filename)
+	{
+		if (c == L'\\' || c == L'"')
 		{
-			uint32_t count = reader.ReadUInt32();
-			skins.reserve(count);
-			for (uint32_t j = 0; j < count; j++)
-			{
-				skins.push_back(DeserializeSkinInfo(reader));
-			}
-			break;
+			name += '\\';
+			name += static_cast<char>(c);
 		}
-
-		default:
-			throw std::runtime_error("Unknown chunk type");
+		else if (c < 0x20 || c > 0x7e)
+		{
+			char buf[8];
+			snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned>(c) & 0xffff);
+			name += buf;
 		}
+		else
+		{
+			name += static_cast<char>(c);
+		}
+	}
 
+	std::ostringstream json;
+	json << "{\"file\":\"" << name << "\""
+		<< ",\"bytes\":" << stats.fileSize
+		<< ",\"open_ms\":" << stats.openMilliseconds
+		<< ",\"decode_ms\":" << stats.decodeMilliseconds
+		<< ",\"post_process_ms\":" << stats.postProcessMilliseconds
+		<< ",\"total_ms\":" << stats.totalMilliseconds
+		<< ",\"mb_per_s\":" << stats.GetMegabytesPerSecond()
+		<< ",\"chunks\":[";
+
+	for (size_t i = 0; i < stats.chunks.size(); i++)
+	{
+		const ChunkDecodeStats& chunk = stats.chunks[i];
+		json << (i ? "," : "")
+			<< "{\"type\":\"" << typeName(chunk.type) << "\""
+			<< ",\"bytes\":" << chunk.size
+			<< ",\"ms\":" << chunk.milliseconds << "}";
 	}
+	json << "]}";
 
-	return S_OK;
+	return json.str();
+}
+
+// メッシュを最適化する関数
+void Imase::ImdlLoader::OptimizeMeshData(ImdlMappedData& data, uint32_t cacheSize)
+{
+	// マップされたデータは書き換えられないので退避先へコピーして並べ替える
+	if (data.vertices.data() != data.vertexStorage.data())
+	{
+		data.vertexStorage.assign(data.vertices.begin(), data.vertices.end());
+	}
+	if (data.indices.data() != data.indexStorage.data())
+	{
+		data.indexStorage.assign(data.indices.begin(), data.indices.end());
+	}
+
+	data.optimizeReports = OptimizeMesh(data.vertexStorage, data.indexStorage, data.subMeshes, cacheSize);
+
+	data.vertices = data.vertexStorage;
+	data.indices = data.indexStorage;
+
+#ifdef _DEBUG
+	for (const auto& report : data.optimizeReports)
+	{
+		char text[128];
+		sprintf_s(text, "IMDL submesh %u: ACMR %.3f -> %.3f, ATVR %.3f -> %.3f\n",
+			report.subMeshIndex,
+			report.before.acmr, report.after.acmr,
+			report.before.atvr, report.after.atvr);
+		OutputDebugStringA(text);
+	}
+#endif
 }
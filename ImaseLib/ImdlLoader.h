@@ -1,7 +1,7 @@
 //--------------------------------------------------------------------------------------
 // File: ImdlLoader.h
 //
-// Imdl`̃ff[^[hNX
+// Imdl形式のモデルデータをロードするクラス
 //
 // Date: 2025.3.1
 // Author: Hideyasu Imase
@@ -10,43 +10,140 @@
 
 #include "Imdl.h"
 #include "BinaryReader.h"
+#include "MappedFile.h"
+#include "MeshOptimizer.h"
+#include "AnimationBake.h"
 
 namespace Imase
 {
-	class ImdlLoader
+	// チャンク毎の解析時間
+	struct ChunkDecodeStats
 	{
-	private:
+		uint32_t type = 0;		// チャンクタイプ
+		uint32_t size = 0;		// データサイズ
+		double milliseconds = 0.0;	// 解析時間
+	};
 
-		// [h֐i}eAj
-		static Imase::MaterialInfo DeserializeMaterial(BinaryReader& reader);
+	// ロードの計測結果（collectStats 指定時のみ）
+	struct ImdlLoadStats
+	{
+		uint64_t fileSize = 0;			// ファイルサイズ
+		double openMilliseconds = 0.0;		// マップとチャンクディレクトリの読み込み時間
+		double decodeMilliseconds = 0.0;	// チャンクの解析時間（並列時は経過時間）
+		double postProcessMilliseconds = 0.0;	// メッシュ最適化などの後処理時間
+		double totalMilliseconds = 0.0;		// 合計
+
+		std::vector<ChunkDecodeStats> chunks;	// チャンク毎の解析時間（チャンクディレクトリと同じ順）
+
+		// 読み込み速度（MB/s）
+		double GetMegabytesPerSecond() const
+		{
+			return totalMilliseconds > 0.0 ? (fileSize / (1024.0 * 1024.0)) / (totalMilliseconds / 1000.0) : 0.0;
+		}
+	};
+
+	// メモリマップで読み込んだモデルデータ
+	// textures / vertices / indices はマップされたファイルを直接参照する
+	struct ImdlMappedData
+	{
+		// マップされたファイル（ビューの寿命を保持）
+		MappedFile file;
 
-		// [h֐i_j
-		static Imase::VertexPositionNormalTextureTangent DeserializeVertex(BinaryReader& reader);
+		// ファイルのバージョン
+		uint32_t version = 0;
+
+		// チャンクディレクトリ（v3 未満のファイルはチャンクを走査して作成）
+		std::vector<ChunkDirectoryEntry> chunks;
+
+		std::vector<TextureView> textures;
+		std::vector<MaterialInfo> materials;
+		std::vector<SubMeshInfo> subMeshes;
+		std::vector<MeshGroupInfo> meshGroups;
+		std::vector<NodeInfo> nodes;
+		std::vector<AnimationClip> animationClips;
+		std::vector<SkinInfo> skins;
+		std::span<const VertexPositionNormalTextureTangent> vertices;
+		std::span<const uint32_t> indices;
+
+		// 圧縮頂点（VTXP チャンクがある場合のみ）
+		PackedVertexHeader packedVertexHeader{};
+		std::span<const uint8_t> packedVertices;
+		uint32_t packedVertexCount = 0;
+
+		// メッシュ最適化の結果（optimizeMesh 指定時のみ）
+		std::vector<SubMeshOptimizeReport> optimizeReports;
+
+		// ロードの計測結果（collectStats 指定時のみ）
+		ImdlLoadStats stats;
+
+		// 一定間隔に焼き込んだアニメーションクリップと誤差（bakeSampleRate 指定時のみ、animationClips と同じ順）
+		std::vector<BakedAnimationClip> bakedAnimationClips;
+		std::vector<AnimationBakeReport> bakeReports;
+
+		// アライメントが合わずに直接参照できなかった場合、またはメッシュを最適化した場合の退避先
+		std::vector<VertexPositionNormalTextureTangent> vertexStorage;
+		std::vector<uint32_t> indexStorage;
+	};
+
+	// ロードオプション
+	struct ImdlLoadOptions
+	{
+		// VERT / VTXP / INDX / INDC / TXTR / ANIM / SKIN チャンクをワーカースレッドで並列に解析する
+		bool parallelDecode = false;
 
-		// [h֐ibVj
-		static Imase::SubMeshInfo DeserializeSubMesh(BinaryReader& reader);
+		// VTXP チャンクが無い場合、ロード時に頂点を圧縮形式（VertexPacked）へ変換する
+		bool packVertices = false;
 
-		// [h֐ibVO[vj
-		static Imase::MeshGroupInfo DeserializeMeshGroup(BinaryReader& reader);
+		// packVertices 時に位置をメッシュのAABBで量子化する（VertexPackedQuantized）
+		bool quantizePositions = false;
 
-		// [h֐im[hj
-		static Imase::NodeInfo DeserializeNode(BinaryReader& reader);
+		// 頂点キャッシュ・オーバードロー・頂点フェッチの最適化を行う（VTXP チャンクが無い場合のみ）
+		bool optimizeMesh = false;
 
-		// [h֐iVector3̔zj
+		// 最適化と計測に使う頂点キャッシュのサイズ
+		uint32_t vertexCacheSize = 16;
+
+		// チャンク毎の解析時間などを計測する（ImdlMappedData::stats）
+		bool collectStats = false;
+
+		// 0 より大きい場合、アニメーションクリップをこのレート（Hz）で焼き込む
+		float bakeSampleRate = 0.0f;
+	};
+
+	class ImdlLoader
+	{
+	private:
+
+		// ロードする関数（マテリアル）
+		static Imase::MaterialInfo DeserializeMaterial(BinaryReader& reader);
+
+		// ロードする関数（Vector3の配列）
 		static Imase::AnimationChannelVec3 DeserializeChannelVec3(BinaryReader& reader);
 
-		// [h֐iNH[^jI̔zj
+		// ロードする関数（クォータニオンの配列）
 		static Imase::AnimationChannelQuat DeserializeChannelQuat(BinaryReader& reader);
 
-		// [h֐iAj[Vj
-		static Imase::AnimationClip DeserializeAnimationClip(BinaryReader& reader);
+		// ロードする関数（アニメーション）
+		static Imase::AnimationClip DeserializeAnimationClip(BinaryReader& reader, uint32_t version);
 
-		// [h֐iXLj
+		// ロードする関数（スキン）
 		static Imase::SkinInfo DeserializeSkinInfo(BinaryReader& reader);
 
+		// チャンクを解析する関数
+		static void ParseChunk(uint32_t type, BinaryReader& reader, ImdlMappedData& data);
+
+		// チャンクディレクトリを読み込む関数
+		static bool ReadChunkDirectory(const FileHeader& header, ImdlMappedData& data);
+
+		// メッシュを最適化する関数
+		static void OptimizeMeshData(ImdlMappedData& data, uint32_t cacheSize);
+
+		// アニメーションクリップを焼き込む関数
+		static void BakeAnimationData(ImdlMappedData& data, float sampleRate);
+
 	public:
 
-		// Imdl̃[h֐
+		// Imdlのロード関数
 		static HRESULT LoadImdl
 		(
 			const std::wstring& filename,
@@ -61,5 +158,16 @@ namespace Imase
 			std::vector<uint32_t>& indices
 		);
 
+		// Imdlのロード関数（メモリマップ、ゼロコピー）
+		static HRESULT LoadImdlMapped
+		(
+			const std::wstring& filename,
+			ImdlMappedData& data,
+			const ImdlLoadOptions& options = {}
+		);
+
+		// 計測結果をJSON形式の文字列にする関数（ローダーの比較用）
+		static std::string FormatStatsJson(const std::wstring& filename, const ImdlLoadStats& stats);
+
 	};
 }
\ No newline at end of file
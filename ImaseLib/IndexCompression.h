@@ -0,0 +1,264 @@
+//--------------------------------------------------------------------------------------
+// File: IndexCompression.h
+//
+// 三角形リストのインデックスを圧縮・展開する関数（変換コンバーターと読み込み側共通）
+//
+// 直前の三角形と共有する辺を辺キャッシュで参照し、残りの頂点は
+// 「次の新しい頂点」か、それとの差分（ZigZag + 可変長整数）で表します
+// 頂点を初回参照順に並べ替えたメッシュ（OptimizeVertexFetch 後）で効果が高くなります
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include <vector>
+#include <span>
+#include <array>
+#include <stdexcept>
+
+namespace Imase
+{
+    // 三角形毎のコードバイト
+    //   上位4bit : 辺キャッシュのインデックス（INDEX_CODE_NO_EDGE の場合は辺を共有しない）
+    //   下位4bit : 辺を共有する場合  bit0 = 3つ目の頂点が差分で続く
+    //              共有しない場合    bit k = k番目の頂点が差分で続く（0 は次の新しい頂点）
+    constexpr uint32_t INDEX_EDGE_CACHE_SIZE = 15;
+    constexpr uint8_t INDEX_CODE_NO_EDGE = 0xF;
+
+    namespace IndexCompressionDetail
+    {
+        struct Edge
+        {
+            uint32_t a;
+            uint32_t b;
+        };
+
+        // 辺の FIFO キャッシュ
+        struct EdgeFifo
+        {
+            std::array<Edge, INDEX_EDGE_CACHE_SIZE> edges{};
+            uint32_t count = 0;
+            uint32_t head = 0;
+
+            void Push(uint32_t a, uint32_t b)
+            {
+                edges[head] = { a, b };
+                head = (head + 1) % INDEX_EDGE_CACHE_SIZE;
+                count = std::min(count + 1, INDEX_EDGE_CACHE_SIZE);
+            }
+
+            // 新しい順で i 番目の辺
+            const Edge& Get(uint32_t i) const
+            {
+                return edges[(head + INDEX_EDGE_CACHE_SIZE - 1 - i) % INDEX_EDGE_CACHE_SIZE];
+            }
+
+            // 出力した三角形の辺を隣の三角形から見た向きで登録
+            void PushTriangle(uint32_t a, uint32_t b, uint32_t c)
+            {
+                Push(b, a);
+                Push(c, b);
+                Push(a, c);
+            }
+        };
+
+        inline void WriteVarint(std::vector<uint8_t>& out, uint32_t v)
+        {
+            while (v >= 0x80)
+            {
+                out.push_back(static_cast<uint8_t>(v | 0x80));
+                v >>= 7;
+            }
+            out.push_back(static_cast<uint8_t>(v));
+        }
+
+        inline uint32_t ReadVarint(const uint8_t*& p, const uint8_t* end)
+        {
+            uint32_t v = 0;
+            for (uint32_t shift = 0; shift < 35; shift += 7)
+            {
+                if (p >= end)
+                {
+                    throw std::runtime_error("truncated index stream");
+                }
+                uint8_t byte = *p++;
+                v |= static_cast<uint32_t>(byte & 0x7f) << shift;
+                if ((byte & 0x80) == 0)
+                {
+                    return v;
+                }
+            }
+            throw std::runtime_error("invalid varint in index stream");
+        }
+
+        // 「次の新しい頂点」との差分を ZigZag 符号化
+        inline uint32_t EncodeDelta(uint32_t v, uint32_t next)
+        {
+            int32_t d = static_cast<int32_t>(v - next);
+            return static_cast<uint32_t>((d << 1) ^ (d >> 31));
+        }
+
+        inline uint32_t DecodeDelta(uint32_t z, uint32_t next)
+        {
+            int32_t d = static_cast<int32_t>(z >> 1) ^ -static_cast<int32_t>(z & 1);
+            return next + static_cast<uint32_t>(d);
+        }
+    }
+
+    // インデックスを圧縮する関数（三角形の巻き方向は保存されるが頂点の開始位置は変わる場合がある）
+    inline std::vector<uint8_t> EncodeIndexStream(std::span<const uint32_t> indices)
+    {
+        using namespace IndexCompressionDetail;
+
+        if (indices.size() % 3 != 0)
+        {
+            throw std::invalid_argument("index count must be a multiple of 3");
+        }
+
+        std::vector<uint8_t> out;
+        out.reserve(indices.size());
+
+        EdgeFifo fifo;
+        uint32_t next = 0;
+
+        // 頂点を書き出して「次の新しい頂点」を更新する
+        auto writeVertex = [&out, &next](uint32_t v)
+            {
+                WriteVarint(out, EncodeDelta(v, next));
+                if (v == next)
+                {
+                    next++;
+                }
+            };
+
+        for (size_t t = 0; t < indices.size(); t += 3)
+        {
+            uint32_t tri[3] = { indices[t], indices[t + 1], indices[t + 2] };
+
+            // 辺キャッシュを探す（3通りの回転を試す）
+            bool found = false;
+            for (uint32_t e = 0; e < fifo.count && !found; e++)
+            {
+                const Edge& edge = fifo.Get(e);
+                for (uint32_t r = 0; r < 3; r++)
+                {
+                    uint32_t a = tri[r];
+                    uint32_t b = tri[(r + 1) % 3];
+                    uint32_t c = tri[(r + 2) % 3];
+
+                    if (edge.a == a && edge.b == b)
+                    {
+                        bool isNext = (c == next);
+                        out.push_back(static_cast<uint8_t>((e << 4) | (isNext ? 0 : 1)));
+                        if (isNext)
+                        {
+                            next++;
+                        }
+                        else
+                        {
+                            writeVertex(c);
+                        }
+                        fifo.PushTriangle(a, b, c);
+                        found = true;
+                        break;
+                    }
+                }
+            }
+
+            if (found)
+            {
+                continue;
+            }
+
+            // 共有辺が無い場合は3頂点とも書き出す
+            size_t codePos = out.size();
+            out.push_back(0);
+
+            uint8_t mask = 0;
+            for (uint32_t k = 0; k < 3; k++)
+            {
+                if (tri[k] == next)
+                {
+                    next++;
+                }
+                else
+                {
+                    mask |= static_cast<uint8_t>(1 << k);
+                    writeVertex(tri[k]);
+                }
+            }
+            out[codePos] = static_cast<uint8_t>((INDEX_CODE_NO_EDGE << 4) | mask);
+
+            fifo.PushTriangle(tri[0], tri[1], tri[2]);
+        }
+
+        return out;
+    }
+
+    // 圧縮されたインデックスを展開する関数
+    inline void DecodeIndexStream(std::span<const uint8_t> stream, std::span<uint32_t> indices)
+    {
+        using namespace IndexCompressionDetail;
+
+        if (indices.size() % 3 != 0)
+        {
+            throw std::invalid_argument("index count must be a multiple of 3");
+        }
+
+        const uint8_t* p = stream.data();
+        const uint8_t* end = p + stream.size();
+
+        EdgeFifo fifo;
+        uint32_t next = 0;
+
+        auto readVertex = [&p, end, &next]()
+            {
+                uint32_t v = DecodeDelta(ReadVarint(p, end), next);
+                if (v == next)
+                {
+                    next++;
+                }
+                return v;
+            };
+
+        for (size_t t = 0; t < indices.size(); t += 3)
+        {
+            if (p >= end)
+            {
+                throw std::runtime_error("truncated index stream");
+            }
+
+            uint8_t code = *p++;
+            uint32_t edgeIndex = code >> 4;
+            uint32_t mask = code & 0xF;
+
+            uint32_t a, b, c;
+
+            if (edgeIndex != INDEX_CODE_NO_EDGE)
+            {
+                if (edgeIndex >= fifo.count)
+                {
+                    throw std::runtime_error("invalid edge reference in index stream");
+                }
+
+                const Edge& edge = fifo.Get(edgeIndex);
+                a = edge.a;
+                b = edge.b;
+                c = (mask & 1) ? readVertex() : next++;
+            }
+            else
+            {
+                a = (mask & 1) ? readVertex() : next++;
+                b = (mask & 2) ? readVertex() : next++;
+                c = (mask & 4) ? readVertex() : next++;
+            }
+
+            indices[t + 0] = a;
+            indices[t + 1] = b;
+            indices[t + 2] = c;
+
+            fifo.PushTriangle(a, b, c);
+        }
+    }
+}
@@ -0,0 +1,439 @@
+//--------------------------------------------------------------------------------------
+// File: JobSystem.cpp
+//
+// ワーカースレッドでジョブを並列に実行するクラス
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "pch.h"
+#include "JobSystem.h"
+
+namespace
+{
+    // 現在のスレッドが属するジョブシステムとワーカー番号
+    thread_local const Imase::JobSystem* t_jobSystem = nullptr;
+    thread_local uint32_t t_workerIndex = 0;
+
+    // 待機する前に空回りする回数
+    constexpr uint32_t SpinCount = 64;
+}
+
+// ----- WorkStealingQueue ----- //
+
+// 末尾に積む関数
+bool Imase::JobSystem::WorkStealingQueue::Push(const Job& job)
+{
+    int64_t bottom = m_bottom.load(std::memory_order_relaxed);
+    int64_t top = m_top.load(std::memory_order_acquire);
+
+    // 満杯
+    if (bottom - top >= static_cast<int64_t>(QueueCapacity)) return false;
+
+    // 一周前のジョブを盗んだスレッドがまだコピー中
+    Slot& slot = m_slots[bottom & (QueueCapacity - 1)];
+    if (slot.busy.load(std::memory_order_acquire)) return false;
+
+    slot.job = job;
+    slot.busy.store(true, std::memory_order_relaxed);
+
+    // ジョブの書き込みの後に末尾を進める
+    m_bottom.store(bottom + 1, std::memory_order_seq_cst);
+    return true;
+}
+
+// 末尾から取り出す関数
+bool Imase::JobSystem::WorkStealingQueue::Pop(Job& job)
+{
+    int64_t bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+    m_bottom.store(bottom, std::memory_order_seq_cst);
+    int64_t top = m_top.load(std::memory_order_seq_cst);
+
+    // 空
+    if (top > bottom)
+    {
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        return false;
+    }
+
+    // 最後の１つは盗もうとしているスレッドと取り合いになる
+    if (top == bottom)
+    {
+        bool taken = m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+        m_bottom.store(bottom + 1, std::memory_order_relaxed);
+        return taken && Take(bottom, job);
+    }
+
+    return Take(bottom, job);
+}
+
+// 先頭から盗む関数
+bool Imase::JobSystem::WorkStealingQueue::Steal(Job& job)
+{
+    int64_t top = m_top.load(std::memory_order_seq_cst);
+    int64_t bottom = m_bottom.load(std::memory_order_seq_cst);
+
+    // 空
+    if (top >= bottom) return false;
+
+    // 他のスレッドが先に取った場合は失敗
+    if (!m_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+    {
+        return false;
+    }
+
+    return Take(top, job);
+}
+
+// 取り出したスロットからジョブをコピーして空ける関数
+bool Imase::JobSystem::WorkStealingQueue::Take(int64_t index, Job& job)
+{
+    Slot& slot = m_slots[index & (QueueCapacity - 1)];
+    job = slot.job;
+    slot.busy.store(false, std::memory_order_release);
+    return true;
+}
+
+// ----- JobSystem ----- //
+
+// コンストラクタ
+Imase::JobSystem::JobSystem(uint32_t workerCount)
+    : m_sharedJobs(256)
+    , m_sharedHead{ 0 }
+    , m_sharedJobCount{ 0 }
+    , m_pendingJobs{ 0 }
+    , m_sleepingWorkers{ 0 }
+    , m_quit{ false }
+    , m_externalExecutedJobs{ 0 }
+    , m_deferredJobs{ 0 }
+{
+    if (workerCount == DefaultWorkerCount)
+    {
+        // 呼び出し元のスレッドも待っている間にジョブを実行するので１つ少なくする
+        workerCount = std::max(2u, std::thread::hardware_concurrency()) - 1;
+    }
+
+    // 全てのワーカーを作成してからスレッドを開始する（盗む側がワーカーの配列を参照するため）
+    m_workers.resize(workerCount);
+    for (auto& worker : m_workers)
+    {
+        worker = std::make_unique<Worker>();
+    }
+    for (uint32_t i = 0; i < workerCount; i++)
+    {
+        m_workers[i]->thread = std::thread(&JobSystem::WorkerMain, this, i);
+    }
+}
+
+// デストラクタ
+Imase::JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+        m_quit = true;
+    }
+    m_wakeCondition.notify_all();
+
+    for (auto& worker : m_workers)
+    {
+        worker->thread.join();
+    }
+}
+
+// 共有のインスタンスを取得する関数
+Imase::JobSystem& Imase::JobSystem::GetInstance()
+{
+    static JobSystem instance;
+    return instance;
+}
+
+// ジョブを登録する関数
+void Imase::JobSystem::Schedule(Job job, JobCounter* counter, const JobCounter* dependency)
+{
+    job.counter = counter;
+    job.dependency = dependency;
+
+    if (counter)
+    {
+        counter->m_value.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // ワーカーが無い場合はこのスレッドで実行する
+    if (m_workers.empty())
+    {
+        if (dependency) Wait(*dependency);
+        Execute(job, nullptr);
+        return;
+    }
+
+    Enqueue(job, GetCurrentWorker());
+}
+
+// カウンターが 0 になるまで待つ関数
+void Imase::JobSystem::Wait(const JobCounter& counter)
+{
+    Worker* worker = GetCurrentWorker();
+
+    while (!counter.IsDone())
+    {
+        // 待っている間に他のジョブを実行する
+        // ワーカー以外のスレッドは、待っているカウンターのジョブだけを手伝う
+        // （メインスレッドが他のスレッドのロードなど、長いジョブを拾って止まらないようにする）
+        bool executed = worker ? TryRunJob(worker) : TryRunSharedJob(counter);
+        if (!executed)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    // ジョブが送出した例外は待っている側で再送出する（完了の通知より前に書き込まれている）
+    if (counter.m_hasException.load(std::memory_order_acquire))
+    {
+        std::rethrow_exception(counter.m_exception);
+    }
+}
+
+// 統計情報を取得する関数
+Imase::JobSystem::Stats Imase::JobSystem::GetStats() const
+{
+    Stats stats;
+    stats.executedJobs = m_externalExecutedJobs.load();
+    stats.deferredJobs = m_deferredJobs.load();
+    for (const auto& worker : m_workers)
+    {
+        stats.executedJobs += worker->executedJobs.load();
+        stats.stolenJobs += worker->stolenJobs.load();
+    }
+    return stats;
+}
+
+// ワーカースレッドの処理
+void Imase::JobSystem::WorkerMain(uint32_t index)
+{
+    t_jobSystem = this;
+    t_workerIndex = index;
+
+    Worker* worker = m_workers[index].get();
+    uint32_t spin = 0;
+
+    while (true)
+    {
+        if (TryRunJob(worker))
+        {
+            spin = 0;
+            continue;
+        }
+
+        // しばらくは空回りしてすぐに来るジョブに備える
+        if (++spin < SpinCount)
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        spin = 0;
+
+        // ジョブが登録されるまで待機する
+        std::unique_lock<std::mutex> lock(m_sleepMutex);
+        m_sleepingWorkers.fetch_add(1);
+        m_wakeCondition.wait(lock, [this]() { return m_quit || m_pendingJobs.load() > 0; });
+        m_sleepingWorkers.fetch_sub(1);
+
+        // 終了要求があっても残っているジョブは実行してから終わる
+        if (m_quit && m_pendingJobs.load() == 0) return;
+    }
+}
+
+// 現在のスレッドのワーカーを取得する関数
+Imase::JobSystem::Worker* Imase::JobSystem::GetCurrentWorker() const
+{
+    return (t_jobSystem == this) ? m_workers[t_workerIndex].get() : nullptr;
+}
+
+// キューに入れる関数
+void Imase::JobSystem::Enqueue(const Job& job, Worker* worker)
+{
+    m_pendingJobs.fetch_add(1);
+
+    // ワーカーは自分のキューに積む（満杯なら共有のキューへ）
+    if (!worker || !worker->queue.Push(job))
+    {
+        EnqueueShared(job);
+    }
+
+    WakeWorkers(1);
+}
+
+// 共有のキューに入れる関数
+void Imase::JobSystem::EnqueueShared(const Job& job)
+{
+    std::lock_guard<std::mutex> lock(m_sharedMutex);
+
+    size_t count = m_sharedJobCount.load();
+    size_t capacity = m_sharedJobs.size();
+
+    // 満杯なら倍の大きさにして先頭から並べ直す
+    if (count == capacity)
+    {
+        std::vector<Job> jobs(capacity * 2);
+        for (size_t i = 0; i < count; i++)
+        {
+            jobs[i] = m_sharedJobs[(m_sharedHead + i) % capacity];
+        }
+        m_sharedJobs.swap(jobs);
+        m_sharedHead = 0;
+        capacity = m_sharedJobs.size();
+    }
+
+    m_sharedJobs[(m_sharedHead + count) % capacity] = job;
+    m_sharedJobCount.fetch_add(1);
+}
+
+// 待機中のワーカーを起こす関数
+void Imase::JobSystem::WakeWorkers(uint32_t count)
+{
+    if (m_sleepingWorkers.load() == 0) return;
+
+    // 待機に入る途中のワーカーが通知を取りこぼさないようにロックを経由する
+    {
+        std::lock_guard<std::mutex> lock(m_sleepMutex);
+    }
+
+    if (count == 1)
+    {
+        m_wakeCondition.notify_one();
+    }
+    else
+    {
+        m_wakeCondition.notify_all();
+    }
+}
+
+// ジョブを１つ取り出して実行する関数
+bool Imase::JobSystem::TryRunJob(Worker* worker)
+{
+    Job job;
+    bool found = false;
+
+    // 自分のキュー（最後に積んだものから）
+    if (worker && worker->queue.Pop(job))
+    {
+        found = true;
+    }
+
+    // 共有のキュー
+    if (!found && m_sharedJobCount.load() > 0)
+    {
+        std::lock_guard<std::mutex> lock(m_sharedMutex);
+        if (m_sharedJobCount.load() > 0)
+        {
+            job = m_sharedJobs[m_sharedHead];
+            m_sharedHead = (m_sharedHead + 1) % m_sharedJobs.size();
+            m_sharedJobCount.fetch_sub(1);
+            found = true;
+        }
+    }
+
+    // 他のワーカーのキューから盗む（隣のワーカーから順に）
+    if (!found)
+    {
+        uint32_t count = static_cast<uint32_t>(m_workers.size());
+        uint32_t start = worker ? t_workerIndex + 1 : 0;
+        for (uint32_t i = 0; i < count && !found; i++)
+        {
+            Worker* victim = m_workers[(start + i) % count].get();
+            if (victim != worker && victim->queue.Steal(job))
+            {
+                found = true;
+                if (worker) worker->stolenJobs.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+
+    if (!found) return false;
+
+    m_pendingJobs.fetch_sub(1);
+
+    // 依存するジョブが終わっていなければ共有のキューの末尾に回す
+    if (job.dependency && !job.dependency->IsDone())
+    {
+        m_deferredJobs.fetch_add(1, std::memory_order_relaxed);
+        m_pendingJobs.fetch_add(1);
+        EnqueueShared(job);
+        return false;
+    }
+
+    Execute(job, worker);
+    return true;
+}
+
+// 共有のキューから指定したカウンターのジョブを１つ取り出して実行する関数
+bool Imase::JobSystem::TryRunSharedJob(const JobCounter& counter)
+{
+    if (m_sharedJobCount.load() == 0) return false;
+
+    Job job;
+    bool found = false;
+    {
+        std::lock_guard<std::mutex> lock(m_sharedMutex);
+
+        size_t count = m_sharedJobCount.load();
+        size_t capacity = m_sharedJobs.size();
+        for (size_t i = 0; i < count && !found; i++)
+        {
+            const Job& candidate = m_sharedJobs[(m_sharedHead + i) % capacity];
+            if (candidate.counter != &counter) continue;
+            if (candidate.dependency && !candidate.dependency->IsDone()) continue;
+
+            // 取り出した位置より前のジョブを１つずつ後ろへずらして、先頭を進める（順番は変えない）
+            job = candidate;
+            for (size_t j = i; j > 0; j--)
+            {
+                m_sharedJobs[(m_sharedHead + j) % capacity] = m_sharedJobs[(m_sharedHead + j - 1) % capacity];
+            }
+            m_sharedHead = (m_sharedHead + 1) % capacity;
+            m_sharedJobCount.fetch_sub(1);
+            found = true;
+        }
+    }
+
+    if (!found) return false;
+
+    m_pendingJobs.fetch_sub(1);
+    Execute(job, nullptr);
+    return true;
+}
+
+// ジョブを実行する関数
+void Imase::JobSystem::Execute(const Job& job, Worker* worker)
+{
+    try
+    {
+        job.function(job.data, job.begin, job.end);
+    }
+    catch (...)
+    {
+        // カウンターが無ければ伝える先が無い（ワーカーでは終了する）
+        if (!job.counter) throw;
+
+        // 最初の例外だけを残して、カウンターを待っている側へ伝える
+        if (!job.counter->m_hasException.exchange(true, std::memory_order_acq_rel))
+        {
+            job.counter->m_exception = std::current_exception();
+        }
+    }
+
+    if (worker)
+    {
+        worker->executedJobs.fetch_add(1, std::memory_order_relaxed);
+    }
+    else
+    {
+        m_externalExecutedJobs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // 完了を通知（ジョブの書き込みが待っている側から見えるようにする）
+    if (job.counter)
+    {
+        job.counter->m_value.fetch_sub(1, std::memory_order_release);
+    }
+}
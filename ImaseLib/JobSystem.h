@@ -0,0 +1,270 @@
+//--------------------------------------------------------------------------------------
+// File: JobSystem.h
+//
+// ワーカースレッドでジョブを並列に実行するクラス
+//
+// ワーカー毎にジョブのキューを持ち、自分のキューが空になったら他のワーカーから盗みます
+// ワーカー以外のスレッドから登録したジョブは共有のキューに入ります
+// ジョブは関数ポインタと範囲だけなので、登録時にメモリ確保はしません
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <mutex>
+#include <thread>
+
+namespace Imase
+{
+    // ジョブの完了を待つためのカウンター（登録で増え、完了で減る）
+    class JobCounter
+    {
+        friend class JobSystem;
+
+        std::atomic<uint32_t> m_value{ 0 };
+
+        // ジョブが送出した最初の例外（Wait で再送出する）
+        std::exception_ptr m_exception;
+        std::atomic<bool> m_hasException{ false };
+
+    public:
+
+        // 全てのジョブが完了したか調べる関数
+        bool IsDone() const { return m_value.load(std::memory_order_acquire) == 0; }
+
+        // 完了していないジョブ数を取得する関数
+        uint32_t GetValue() const { return m_value.load(std::memory_order_acquire); }
+    };
+
+    // ジョブ
+    struct Job
+    {
+        // 実行する関数
+        void (*function)(void* data, uint32_t begin, uint32_t end) = nullptr;
+
+        // 関数に渡すデータと範囲
+        void* data = nullptr;
+        uint32_t begin = 0;
+        uint32_t end = 0;
+
+        // 完了時に減らすカウンター
+        JobCounter* counter = nullptr;
+
+        // このカウンターが 0 になるまで実行しない
+        const JobCounter* dependency = nullptr;
+    };
+
+    class JobSystem
+    {
+    public:
+
+        // 1ワーカーのキューに入るジョブ数（2のべき乗）
+        static constexpr uint32_t QueueCapacity = 4096;
+
+        // ワーカー数をハードウェアスレッド数 - 1 にする指定
+        static constexpr uint32_t DefaultWorkerCount = UINT32_MAX;
+
+        // 統計情報
+        struct Stats
+        {
+            uint64_t executedJobs = 0;  // 実行したジョブ数
+            uint64_t stolenJobs = 0;    // 他のワーカーのキューから盗んだジョブ数
+            uint64_t deferredJobs = 0;  // 依存するジョブが完了していなかったので後回しにした回数
+        };
+
+        // ワーカー毎のジョブのキュー（Chase-Lev 方式）
+        // 持ち主は末尾から積んで末尾から取り出し、他のワーカーは先頭から盗む
+        // （ストレステストから直接使えるように公開している）
+        class WorkStealingQueue
+        {
+            std::atomic<int64_t> m_top{ 0 };
+            std::atomic<int64_t> m_bottom{ 0 };
+
+            // ジョブの実体（取り出した側がコピーを終えるまでは次のジョブで上書きしない）
+            struct Slot
+            {
+                Job job;
+                std::atomic<bool> busy{ false };
+            };
+            std::array<Slot, QueueCapacity> m_slots;
+
+            // 取り出したスロットからジョブをコピーして空ける関数
+            bool Take(int64_t index, Job& job);
+
+        public:
+
+            // 末尾に積む関数（持ち主のみ、満杯なら false）
+            bool Push(const Job& job);
+
+            // 末尾から取り出す関数（持ち主のみ）
+            bool Pop(Job& job);
+
+            // 先頭から盗む関数（他のスレッド）
+            bool Steal(Job& job);
+        };
+
+    private:
+
+        // ワーカー
+        struct Worker
+        {
+            WorkStealingQueue queue;
+            std::thread thread;
+            std::atomic<uint64_t> executedJobs{ 0 };
+            std::atomic<uint64_t> stolenJobs{ 0 };
+        };
+
+        // ワーカー
+        std::vector<std::unique_ptr<Worker>> m_workers;
+
+        // ワーカー以外のスレッドから登録されたジョブ（後回しにしたジョブもここに入る）
+        // リングバッファなので、一度必要な大きさまで広がれば以降はメモリ確保しない
+        std::vector<Job> m_sharedJobs;
+        size_t m_sharedHead;
+        std::mutex m_sharedMutex;
+        std::atomic<uint32_t> m_sharedJobCount;
+
+        // 実行待ちのジョブ数（ワーカーを起こすかどうかの判定に使う）
+        std::atomic<uint32_t> m_pendingJobs;
+
+        // 待機中のワーカー
+        std::mutex m_sleepMutex;
+        std::condition_variable m_wakeCondition;
+        std::atomic<uint32_t> m_sleepingWorkers;
+
+        // 終了要求
+        std::atomic<bool> m_quit;
+
+        // ワーカー以外のスレッドで実行したジョブ数
+        std::atomic<uint64_t> m_externalExecutedJobs;
+
+        // 後回しにした回数
+        std::atomic<uint64_t> m_deferredJobs;
+
+    private:
+
+        // ワーカースレッドの処理
+        void WorkerMain(uint32_t index);
+
+        // 現在のスレッドのワーカーを取得する関数（ワーカー以外は nullptr）
+        Worker* GetCurrentWorker() const;
+
+        // キューに入れる関数（カウンターは増やさない）
+        void Enqueue(const Job& job, Worker* worker);
+
+        // 共有のキューに入れる関数
+        void EnqueueShared(const Job& job);
+
+        // 待機中のワーカーを起こす関数
+        void WakeWorkers(uint32_t count);
+
+        // ジョブを１つ取り出して実行する関数（無ければ false）
+        bool TryRunJob(Worker* worker);
+
+        // 共有のキューから指定したカウンターのジョブを１つ取り出して実行する関数（無ければ false）
+        bool TryRunSharedJob(const JobCounter& counter);
+
+        // ジョブを実行する関数
+        void Execute(const Job& job, Worker* worker);
+
+    public:
+
+        // コンストラクタ（既定はハードウェアスレッド数 - 1、0 ならワーカーを作らずに全て呼び出し元で実行する）
+        explicit JobSystem(uint32_t workerCount = DefaultWorkerCount);
+
+        // デストラクタ（登録済みのジョブは全て実行してから終了する）
+        ~JobSystem();
+
+        JobSystem(const JobSystem&) = delete;
+        JobSystem& operator=(const JobSystem&) = delete;
+
+        // 共有のインスタンスを取得する関数
+        static JobSystem& GetInstance();
+
+        // ジョブを登録する関数
+        // counter は登録時に増え完了時に減る、dependency が 0 になるまでは実行されない
+        void Schedule(Job job, JobCounter* counter = nullptr, const JobCounter* dependency = nullptr);
+
+        // カウンターが 0 になるまで待つ関数
+        // 待っている間、ワーカーは他のジョブも実行し、ワーカー以外のスレッドはこのカウンターのジョブだけを実行する
+        // このカウンターのジョブが例外を送出した場合は、全て完了した後に最初の例外を再送出する
+        // （カウンターを指定しないジョブの例外は伝える先が無いので、ワーカーで送出されると終了する）
+        void Wait(const JobCounter& counter);
+
+        // [0, count) を grainSize ずつに分けて並列に実行する関数（function(begin, end) が呼ばれる）
+        template <class Function>
+        void ParallelFor(uint32_t count, uint32_t grainSize, Function&& function);
+
+        // 関数オブジェクトを実行するジョブを作成する関数（関数オブジェクトはジョブの完了まで存在すること）
+        template <class Function>
+        static Job MakeJob(Function& function, uint32_t begin = 0, uint32_t end = 0);
+
+        // ワーカースレッド数を取得する関数
+        uint32_t GetWorkerCount() const { return static_cast<uint32_t>(m_workers.size()); }
+
+        // 統計情報を取得する関数
+        Stats GetStats() const;
+
+    };
+
+    // 関数オブジェクトを実行するジョブを作成する関数
+    template <class Function>
+    Job JobSystem::MakeJob(Function& function, uint32_t begin, uint32_t end)
+    {
+        Job job;
+        job.function = [](void* data, uint32_t begin, uint32_t end)
+            {
+                (*static_cast<Function*>(data))(begin, end);
+            };
+        job.data = const_cast<void*>(static_cast<const void*>(std::addressof(function)));
+        job.begin = begin;
+        job.end = end;
+        return job;
+    }
+
+    // [0, count) を grainSize ずつに分けて並列に実行する関数
+    template <class Function>
+    void JobSystem::ParallelFor(uint32_t count, uint32_t grainSize, Function&& function)
+    {
+        if (count == 0) return;
+
+        grainSize = std::max(grainSize, 1u);
+
+        // 分割できない場合はこのスレッドで実行する
+        if (count <= grainSize || m_workers.empty())
+        {
+            function(0u, count);
+            return;
+        }
+
+        // 先頭以外を登録して、先頭はこのスレッドで実行する
+        JobCounter counter;
+        std::exception_ptr error;
+        try
+        {
+            for (uint32_t begin = grainSize; begin < count; begin += grainSize)
+            {
+                Schedule(MakeJob(function, begin, std::min(begin + grainSize, count)), &counter);
+            }
+
+            function(0u, grainSize);
+        }
+        catch (...)
+        {
+            error = std::current_exception();
+        }
+
+        // 登録したジョブは counter と function を参照するので、例外が出ても必ず完了を待つ
+        Wait(counter);
+
+        if (error)
+        {
+            std::rethrow_exception(error);
+        }
+    }
+}
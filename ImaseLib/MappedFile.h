@@ -0,0 +1,208 @@
+//--------------------------------------------------------------------------------------
+// File: MappedFile.h
+//
+// ファイルをメモリマップして読み取り専用で参照するクラス
+//
+// ファイルの内容をコピーせずにアドレス空間へ割り当てます
+// 取得したポインタはこのオブジェクトが破棄されるまで有効です
+// Windows 以外（ベンチマークのビルド）では mmap を使います
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include <string>
+
+#ifndef _WIN32
+#include <filesystem>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace Imase
+{
+    class MappedFile
+    {
+    public:
+
+        // コンストラクタ
+        MappedFile() = default;
+
+        // デストラクタ
+        ~MappedFile()
+        {
+            Close();
+        }
+
+        // コピー禁止
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        // ムーブ
+        MappedFile(MappedFile&& other) noexcept
+        {
+            *this = std::move(other);
+        }
+
+        MappedFile& operator=(MappedFile&& other) noexcept
+        {
+            if (this != &other)
+            {
+                Close();
+                m_file = other.m_file;
+#ifdef _WIN32
+                m_mapping = other.m_mapping;
+#endif
+                m_data = other.m_data;
+                m_size = other.m_size;
+                other.m_file = InvalidFile;
+#ifdef _WIN32
+                other.m_mapping = nullptr;
+#endif
+                other.m_data = nullptr;
+                other.m_size = 0;
+            }
+            return *this;
+        }
+
+        // ファイルをメモリマップする関数
+        bool Open(const std::wstring& filename)
+        {
+            Close();
+
+#ifdef _WIN32
+            m_file = CreateFileW(
+                filename.c_str(),
+                GENERIC_READ,
+                FILE_SHARE_READ,
+                nullptr,
+                OPEN_EXISTING,
+                FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+                nullptr
+            );
+            if (m_file == INVALID_HANDLE_VALUE)
+            {
+                return false;
+            }
+
+            LARGE_INTEGER size = {};
+            if (!GetFileSizeEx(m_file, &size) || size.QuadPart == 0)
+            {
+                Close();
+                return false;
+            }
+
+            m_mapping = CreateFileMappingW(m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+            if (!m_mapping)
+            {
+                Close();
+                return false;
+            }
+
+            m_data = static_cast<const uint8_t*>(MapViewOfFile(m_mapping, FILE_MAP_READ, 0, 0, 0));
+            if (!m_data)
+            {
+                Close();
+                return false;
+            }
+
+            m_size = static_cast<size_t>(size.QuadPart);
+#else
+            m_file = open(std::filesystem::path(filename).c_str(), O_RDONLY);
+            if (m_file == InvalidFile)
+            {
+                return false;
+            }
+
+            struct stat st = {};
+            if (fstat(m_file, &st) != 0 || st.st_size == 0)
+            {
+                Close();
+                return false;
+            }
+
+            void* p = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_PRIVATE, m_file, 0);
+            if (p == MAP_FAILED)
+            {
+                Close();
+                return false;
+            }
+
+            m_data = static_cast<const uint8_t*>(p);
+            m_size = static_cast<size_t>(st.st_size);
+#endif
+
+            return true;
+        }
+
+        // マッピングを解除する関数
+        void Close()
+        {
+#ifdef _WIN32
+            if (m_data)
+            {
+                UnmapViewOfFile(m_data);
+                m_data = nullptr;
+            }
+            if (m_mapping)
+            {
+                CloseHandle(m_mapping);
+                m_mapping = nullptr;
+            }
+            if (m_file != InvalidFile)
+            {
+                CloseHandle(m_file);
+                m_file = InvalidFile;
+            }
+#else
+            if (m_data)
+            {
+                munmap(const_cast<uint8_t*>(m_data), m_size);
+                m_data = nullptr;
+            }
+            if (m_file != InvalidFile)
+            {
+                close(m_file);
+                m_file = InvalidFile;
+            }
+#endif
+            m_size = 0;
+        }
+
+        // 先頭アドレスを取得する関数
+        const uint8_t* Data() const { return m_data; }
+
+        // ファイルサイズを取得する関数
+        size_t Size() const { return m_size; }
+
+        // マップ済みなら true を返す関数
+        bool IsOpen() const { return m_data != nullptr; }
+
+    private:
+
+#ifdef _WIN32
+        using FileHandle = HANDLE;
+        static inline const FileHandle InvalidFile = INVALID_HANDLE_VALUE;
+#else
+        using FileHandle = int;
+        static constexpr FileHandle InvalidFile = -1;
+#endif
+
+        // ファイルハンドル
+        FileHandle m_file = InvalidFile;
+
+#ifdef _WIN32
+        // ファイルマッピングオブジェクト
+        HANDLE m_mapping = nullptr;
+#endif
+
+        // マップされたデータの先頭
+        const uint8_t* m_data = nullptr;
+
+        // データサイズ
+        size_t m_size = 0;
+    };
+}
@@ -1,7 +1,7 @@
 //--------------------------------------------------------------------------------------
 // File: Model.cpp
 //
-// Imdl`̃ff[^`悷NX
+// Imdl形式のモデルデータを描画するクラス
 //
 // Date: 2025.2.11
 // Author: Hideyasu Imase
@@ -9,24 +9,33 @@
 #include "pch.h"
 #include "Model.h"
 #include "ImdlLoader.h"
+#include "VertexPacking.h"
+#include "FrameArena.h"
+#include "SkinPalette.h"
+#include "TextureRegistry.h"
 
 using namespace DirectX;
 using namespace Imase;
 
 #include "DDSTextureLoader.h"
 
-// RXgN^
+// コンストラクタ
 Imase::Model::Model(ID3D11Device* device, Imase::Effect* pEffect)
 	: m_pEffect{ pEffect }
+	, m_indexFormat{ DXGI_FORMAT_R32_UINT }
 	, m_hasSkin{ false }
+	, m_vertexFormat{ VertexFormat::Standard }
+	, m_vertexStride{ sizeof(VertexPositionNormalTextureTangent) }
+	, m_positionScale{ 1.0f, 1.0f, 1.0f }
+	, m_positionOffset{ 0.0f, 0.0f, 0.0f }
 {
-	// ----- X^CU[Xe[g ----- //
+	// ----- ラスタライザーステート ----- //
 	{
-		// X^CU[Xe[g̍쐬
+		// ラスタライザーステートの作成
 		D3D11_RASTERIZER_DESC desc = {};
 		desc.FillMode = D3D11_FILL_SOLID;
 		desc.CullMode = D3D11_CULL_BACK;
-		desc.FrontCounterClockwise = TRUE;	// v肪\iCCWj
+		desc.FrontCounterClockwise = TRUE;	// 反時計回りが表（CCW）
 		desc.DepthBias = 0;
 		desc.DepthBiasClamp = 0.0f;
 		desc.SlopeScaledDepthBias = 0.0f;
@@ -39,9 +48,9 @@ Imase::Model::Model(ID3D11Device* device, Imase::Effect* pEffect)
 		);
 	}
 
-	// ----- [xXeVXe[g ----- //
+	// ----- 深度ステンシルステート ----- //
 	{
-		// [xXeVXe[g̍쐬
+		// 深度ステンシルステートの作成
 		D3D11_DEPTH_STENCIL_DESC desc = {};
 		desc.DepthEnable = TRUE;
 		desc.DepthWriteMask = D3D11_DEPTH_WRITE_MASK_ALL;
@@ -52,14 +61,14 @@ Imase::Model::Model(ID3D11Device* device, Imase::Effect* pEffect)
 		);
 	}
 
-	// ----- uhXe[g ----- //
+	// ----- ブレンドステート ----- //
 	{
-		// uhXe[g̍쐬
+		// ブレンドステートの作成
 		D3D11_BLEND_DESC desc = {};
 		desc.AlphaToCoverageEnable = FALSE;
 		desc.IndependentBlendEnable = FALSE;
 
-		// Xg[gAt@̐ݒ
+		// ストレートアルファの設定
 		desc.RenderTarget[0].BlendEnable = TRUE;
 		desc.RenderTarget[0].RenderTargetWriteMask = D3D11_COLOR_WRITE_ENABLE_ALL;
 		desc.RenderTarget[0].SrcBlend = D3D11_BLEND_SRC_ALPHA;
@@ -75,114 +84,295 @@ Imase::Model::Model(ID3D11Device* device, Imase::Effect* pEffect)
 	}
 }
 
-// ff[^쐬֐
-std::unique_ptr<Imase::Model> Imase::Model::CreateFromImdl(ID3D11Device* device, std::wstring fname, Imase::Effect* pEffect)
+// デストラクタ
+Imase::Model::~Model()
 {
-	std::vector<TextureEntry> textures;
-	std::vector<MaterialInfo> materials;
-	std::vector<VertexPositionNormalTextureTangent> vertices;
-	std::vector<uint32_t> indices;
-
-	auto model = std::make_unique<Model>(device, pEffect);
+	// このモデルだけが使っていたテクスチャを共有から取り除く
+	m_textures.clear();
+	TextureRegistry::GetInstance().Purge();
+}
 
-	// IMDLt@C̃[h
-	HRESULT hr = ImdlLoader::LoadImdl(
-		fname,
-		textures, materials,
-		model->m_subMeshes, model->m_meshGroups, model->m_nodes, model->m_animations, model->m_skins,
-		vertices, indices
-	);
+// モデルデータ作成関数
+std::unique_ptr<Imase::Model> Imase::Model::CreateFromImdl(ID3D11Device* device, std::wstring fname, Imase::Effect* pEffect, const Imase::ImdlLoadOptions& options)
+{
+	// IMDLファイルのロード（メモリマップしたデータを直接参照する）
+	ImdlMappedData data;
+	HRESULT hr = ImdlLoader::LoadImdlMapped(fname, data, options);
 	if (hr == E_FAIL)
 	{
 		OutputDebugString(L"Failed to load IMDL file.\n");
 	}
 
-	// XLLtO
+	auto model = CreateFromImdlData(device, data, pEffect, options);
+
+	// テクスチャのシェダーリソースを作成してエフェクトに登録（モデルも解放まで参照を持つ）
+	if (model)
+	{
+		model->m_textures = Effect::CreateTextures(device, data.textures);
+		model->m_materials = data.materials;
+		pEffect->RegisterTextures(model->m_textures);
+	}
+
+	// エフェクトにマテリアルを登録
+	pEffect->RegisterMaterials(data.materials);
+
+	return model;
+}
+
+// IMDLファイルからテクスチャまで作成する関数
+std::unique_ptr<Imase::Model> Imase::Model::LoadFromImdl(ID3D11Device* device, const std::wstring& fname, Imase::Effect* pEffect, const Imase::ImdlLoadOptions& options)
+{
+	ImdlMappedData data;
+	if (FAILED(ImdlLoader::LoadImdlMapped(fname, data, options)))
+	{
+		OutputDebugString(L"Failed to load IMDL file.\n");
+		return nullptr;
+	}
+
+	auto model = CreateFromImdlData(device, data, pEffect, options);
+
+	// テクスチャはレジストリで共有する（エフェクトは変更しない）
+	model->m_textures = Effect::CreateTextures(device, data.textures);
+	model->m_materials = data.materials;
+
+	return model;
+}
+
+// テクスチャとマテリアルをエフェクトに登録する関数
+void Imase::Model::RegisterToEffect()
+{
+	m_pEffect->RegisterTextures(m_textures);
+	m_pEffect->SetMaterials(m_materials);
+}
+
+// ロード済みのデータからモデルを作成する関数
+std::unique_ptr<Imase::Model> Imase::Model::CreateFromImdlData(ID3D11Device* device, Imase::ImdlMappedData& data, Imase::Effect* pEffect, const Imase::ImdlLoadOptions& options)
+{
+	auto model = std::make_unique<Model>(device, pEffect);
+
+	model->m_subMeshes = std::move(data.subMeshes);
+	model->m_meshGroups = std::move(data.meshGroups);
+	model->m_skins = std::move(data.skins);
+
+	// ノードとアニメーション（アニメーションで動かすノードもここで調べておく）
+	model->SetAnimationData(data);
+
+	// スキン有無フラグ
 	model->m_hasSkin = !model->m_skins.empty();
 
-	// GtFNgɃeNX`̃VF_[\[X쐬ēo^
-	model->GetEffect()->RegisterTextures(device, textures);
+	// 頂点データ（圧縮形式の頂点があればそちらを使う）
+	std::span<const uint8_t> vertexBytes(
+		reinterpret_cast<const uint8_t*>(data.vertices.data()), data.vertices.size_bytes());
+	std::vector<uint8_t> packedStorage;
+
+	if (!data.packedVertices.empty() || options.packVertices)
+	{
+		PackedVertexHeader header = data.packedVertexHeader;
+
+		if (data.packedVertices.empty())
+		{
+			// ロード時に圧縮形式へ変換
+			packedStorage = PackVertices(data.vertices, options.quantizePositions, header);
+			vertexBytes = packedStorage;
+		}
+		else
+		{
+			vertexBytes = data.packedVertices;
+		}
 
-	// GtFNgɃ}eAo^
-	model->GetEffect()->RegisterMaterials(materials);
+		bool quantized = (header.flags & PACKED_VERTEX_QUANTIZED_POSITION) != 0;
+		model->m_vertexFormat = quantized ? VertexFormat::PackedQuantized : VertexFormat::Packed;
+		model->m_vertexStride = GetPackedVertexStride(header.flags);
 
-	// _obt@̍쐬
+		if (quantized)
+		{
+			model->m_positionOffset = header.boundsMin;
+			model->m_positionScale = XMFLOAT3(
+				std::max(header.boundsMax.x - header.boundsMin.x, 1e-6f),
+				std::max(header.boundsMax.y - header.boundsMin.y, 1e-6f),
+				std::max(header.boundsMax.z - header.boundsMin.z, 1e-6f)
+			);
+		}
+	}
+
+	// 頂点バッファの作成
 	{
 		D3D11_BUFFER_DESC desc = {};
-		desc.ByteWidth = static_cast<UINT>(sizeof(VertexPositionNormalTextureTangent) * vertices.size());
+		desc.ByteWidth = static_cast<UINT>(vertexBytes.size());
 		desc.Usage = D3D11_USAGE_DEFAULT;
 		desc.BindFlags = D3D11_BIND_VERTEX_BUFFER;
 
-		D3D11_SUBRESOURCE_DATA data = {};
-		data.pSysMem = vertices.data();
+		D3D11_SUBRESOURCE_DATA initData = {};
+		initData.pSysMem = vertexBytes.data();
 
 		DX::ThrowIfFailed(
-			device->CreateBuffer(&desc, &data, model->m_vertexBuffer.ReleaseAndGetAddressOf())
+			device->CreateBuffer(&desc, &initData, model->m_vertexBuffer.ReleaseAndGetAddressOf())
 		);
 	}
 
-	// CfbNXobt@쐬
+	// インデックスバッファ作成
+	model->CreateIndexBuffer(device, data.indices);
+
+	return model;
+}
+
+// インデックスバッファを作成する関数（サブメッシュの範囲はロード時に検証済み）
+void Imase::Model::CreateIndexBuffer(ID3D11Device* device, std::span<const uint32_t> indices)
+{
+	m_baseVertices.assign(m_subMeshes.size(), 0);
+
+	// サブメッシュ毎に参照する頂点の範囲を調べ、全て 16bit に収まるか判定する
+	bool fitsInModel = true;
+	bool fitsInSubMeshes = true;
+	std::vector<uint32_t> minIndices(m_subMeshes.size(), 0);
+
+	for (size_t i = 0; i < m_subMeshes.size(); i++)
 	{
-		// CfbNX_obt@̍쐬
-		D3D11_BUFFER_DESC desc = {};
-		desc.ByteWidth = static_cast<UINT>(sizeof(uint32_t) * indices.size());
-		desc.Usage = D3D11_USAGE_DEFAULT;
-		desc.BindFlags = D3D11_BIND_INDEX_BUFFER;
+		const SubMeshInfo& mesh = m_subMeshes[i];
+		if (mesh.indexCount == 0)
+		{
+			continue;
+		}
 
-		D3D11_SUBRESOURCE_DATA data = {};
-		data.pSysMem = indices.data();
+		auto range = indices.subspan(mesh.startIndex, mesh.indexCount);
+		auto [minIt, maxIt] = std::minmax_element(range.begin(), range.end());
 
-		DX::ThrowIfFailed(
-			device->CreateBuffer(&desc, &data, model->m_indexBuffer.ReleaseAndGetAddressOf())
-		);
+		minIndices[i] = *minIt;
+		if (*maxIt > UINT16_MAX)
+		{
+			fitsInModel = false;
+		}
+		if (*maxIt - *minIt > UINT16_MAX)
+		{
+			fitsInSubMeshes = false;
+		}
 	}
 
-	return model;
+	// サブメッシュの範囲が重なっている場合はサブメッシュ毎にずらすと互いに上書きするのでずらさない
+	if (fitsInSubMeshes)
+	{
+		std::vector<const SubMeshInfo*> sorted;
+		sorted.reserve(m_subMeshes.size());
+		for (const SubMeshInfo& mesh : m_subMeshes)
+		{
+			if (mesh.indexCount > 0) sorted.push_back(&mesh);
+		}
+		std::sort(sorted.begin(), sorted.end(), [](const SubMeshInfo* a, const SubMeshInfo* b) { return a->startIndex < b->startIndex; });
+
+		for (size_t i = 1; i < sorted.size(); i++)
+		{
+			if (sorted[i]->startIndex < sorted[i - 1]->startIndex + sorted[i - 1]->indexCount)
+			{
+				fitsInSubMeshes = false;
+				break;
+			}
+		}
+	}
+
+	// サブメッシュ以外から参照されるインデックスがある場合も考慮する
+	if (fitsInModel && !indices.empty())
+	{
+		fitsInModel = *std::max_element(indices.begin(), indices.end()) <= UINT16_MAX;
+	}
+
+	D3D11_BUFFER_DESC desc = {};
+	desc.Usage = D3D11_USAGE_DEFAULT;
+	desc.BindFlags = D3D11_BIND_INDEX_BUFFER;
+
+	D3D11_SUBRESOURCE_DATA initData = {};
+
+	std::vector<uint16_t> shortIndices;
+
+	if (fitsInModel || fitsInSubMeshes)
+	{
+		// 16bitインデックス（モデル全体で収まらない場合はサブメッシュ毎にベース頂点でずらす）
+		shortIndices.resize(indices.size());
+		for (size_t i = 0; i < indices.size(); i++)
+		{
+			shortIndices[i] = static_cast<uint16_t>(indices[i]);
+		}
+
+		if (!fitsInModel)
+		{
+			for (size_t i = 0; i < m_subMeshes.size(); i++)
+			{
+				const SubMeshInfo& mesh = m_subMeshes[i];
+				for (uint32_t j = mesh.startIndex; j < mesh.startIndex + mesh.indexCount; j++)
+				{
+					shortIndices[j] = static_cast<uint16_t>(indices[j] - minIndices[i]);
+				}
+				m_baseVertices[i] = static_cast<INT>(minIndices[i]);
+			}
+		}
+
+		m_indexFormat = DXGI_FORMAT_R16_UINT;
+		desc.ByteWidth = static_cast<UINT>(sizeof(uint16_t) * shortIndices.size());
+		initData.pSysMem = shortIndices.data();
+	}
+	else
+	{
+		// 32bitインデックス
+		m_indexFormat = DXGI_FORMAT_R32_UINT;
+		desc.ByteWidth = static_cast<UINT>(indices.size_bytes());
+		initData.pSysMem = indices.data();
+	}
+
+	DX::ThrowIfFailed(
+		device->CreateBuffer(&desc, &initData, m_indexBuffer.ReleaseAndGetAddressOf())
+	);
 }
 
-// `֐
+// 描画関数
 void Imase::Model::Draw(
 	ID3D11DeviceContext* context,
 	const DirectX::XMMATRIX& world,
-	const std::vector<DirectX::XMFLOAT4X4>* animatedWorldMatrices
+	std::span<const DirectX::XMFLOAT4X4> animatedWorldMatrices,
+	Imase::SkinPalette* skinPalette
 )
 {
-	// X^CU[Xe[g̐ݒ
+	// ラスタライザーステートの設定
 	context->RSSetState(m_rasterizerState.Get());
 
-	// [xXeVobt@̐ݒ
+	// 深度ステンシルバッファの設定
 	context->OMSetDepthStencilState(m_depthStencilState.Get(), 0);
 
-	// uhXe[g̐ݒ
+	// ブレンドステートの設定
 	context->OMSetBlendState(m_blendState.Get(), nullptr, 0xffffffff);
 
-	// _obt@̐ݒ
+	// 頂点バッファの設定
 	ID3D11Buffer* buffers[] = { m_vertexBuffer.Get() };
-	UINT stride = sizeof(VertexPositionNormalTextureTangent);
+	UINT stride = m_vertexStride;
 	UINT offset = 0;
 	context->IASetVertexBuffers(0, 1, buffers, &stride, &offset);
 
-	// CfbNXobt@̐ݒ
-	context->IASetIndexBuffer(m_indexBuffer.Get(), DXGI_FORMAT_R32_UINT, 0);
+	// 頂点形式の設定
+	m_pEffect->SetVertexFormat(m_vertexFormat, m_positionScale, m_positionOffset);
 
-	// g|W[̐ݒ
+	// インデックスバッファの設定
+	context->IASetIndexBuffer(m_indexBuffer.Get(), m_indexFormat, 0);
+
+	// トポロジーの設定
 	context->IASetPrimitiveTopology(D3D_PRIMITIVE_TOPOLOGY_TRIANGLELIST);
 
-	// ---- m[hs񏀔 ---- //
+	// ---- ノード行列準備 ---- //
+
+	// 描画中だけ使う行列はフレームアリーナから確保する
+	FrameArena& arena = FrameArena::GetInstance();
 
-	std::vector<XMMATRIX> worldMatrices(m_nodes.size());
+	// 各ノードのモデル空間の行列（オブジェクトのワールド行列は描画時に掛ける）
+	std::span<XMMATRIX> worldMatrices = arena.AllocateArray<XMMATRIX>(m_nodes.size());
 
-	if (animatedWorldMatrices)
+	if (!animatedWorldMatrices.empty())
 	{
-		//  Aj[V
+		// ★ アニメーションあり
 		for (size_t i = 0; i < m_nodes.size(); ++i)
 		{
-			worldMatrices[i] = XMLoadFloat4x4(&(*animatedWorldMatrices)[i]) * world;
+			worldMatrices[i] = XMLoadFloat4x4(&animatedWorldMatrices[i]);
 		}
 	}
 	else
 	{
-		//  ÓIm[hvZ
+		// ★ 静的ノード計算
 		for (size_t i = 0; i < m_nodes.size(); ++i)
 		{
 			const NodeInfo& node = m_nodes[i];
@@ -201,32 +391,34 @@ void Imase::Model::Draw(
 			{
 				worldMatrices[i] = local;
 			}
-
-			worldMatrices[i] *= world;
 		}
 	}
 
-	// ----- bV` ----- //
+	// ----- メッシュ描画 ----- //
 
 	for (size_t nodeIndex = 0; nodeIndex < m_nodes.size(); ++nodeIndex)
 	{
 		const auto& node = m_nodes[nodeIndex];
 
-		// bVȂ
+		// メッシュなし
 		if (node.meshGroupIndex == -1) continue;
 
-		// [hs
-		XMMATRIX nodeWorld = worldMatrices[nodeIndex];
-
-		// XLjOAj[V邩H
+		// スキニングアニメーションするか？
 		bool useSkin = (m_hasSkin && node.skinIndex >= 0);
 
-		if (useSkin)
+		// ワールド行列（スキン行列はモデル空間なので、スキンありはオブジェクトのワールド行列のみ）
+		XMMATRIX nodeWorld = useSkin ? world : worldMatrices[nodeIndex] * world;
+
+		if (useSkin && skinPalette)
+		{
+			// 更新済みのスキン行列をバインドするだけ（転送は最初の描画の１回のみ）
+			skinPalette->Bind(context, m_pEffect, node.skinIndex);
+		}
+		else if (useSkin)
 		{
 			const SkinInfo& skin = m_skins[node.skinIndex];
 
-			std::vector<XMMATRIX> skinMatrices;
-			skinMatrices.resize(skin.jointIndices.size());
+			std::span<XMMATRIX> skinMatrices = arena.AllocateArray<XMMATRIX>(skin.jointIndices.size());
 
 			for (size_t i = 0; i < skin.jointIndices.size(); i++)
 			{
@@ -238,8 +430,8 @@ void Imase::Model::Draw(
 				skinMatrices[i] = ibm * jointWorld;
 			}
 
-			// XLsXV
-			m_pEffect->UpdateSkinCB(context, skinMatrices);
+			// スキン行列を更新
+			m_pEffect->UpdateSkinCB(context, skinMatrices, Imase::SkinFormat::Matrix3x4);
 		}
 
 		uint32_t start = m_meshGroups[node.meshGroupIndex].subMeshStart;
@@ -254,23 +446,7 @@ void Imase::Model::Draw(
 			m_pEffect->SetUseSkin(useSkin);
 			m_pEffect->Apply(context);
 
-			context->DrawIndexed(mesh.indexCount, mesh.startIndex, 0);
+			context->DrawIndexed(mesh.indexCount, mesh.startIndex, m_baseVertices[start + i]);
 		}
 	}
 }
-
-// m[h擾֐
-const std::vector<Imase::NodeInfo>& Imase::Model::GetNodes() const
-{
-	return m_nodes;
-}
-
-// Aj[V擾֐
-const Imase::AnimationClip* Imase::Model::GetAnimation(uint32_t index) const
-{
-	if (index >= m_animations.size())
-	{
-		return nullptr;
-	}
-	return &m_animations[index];
-}
@@ -1,7 +1,7 @@
 //--------------------------------------------------------------------------------------
 // File: Model.h
 //
-// Imdl`̃ff[^`悷NX
+// Imdl形式のモデルデータを描画するクラス
 //
 // Date: 2025.2.11
 // Author: Hideyasu Imase
@@ -9,82 +9,133 @@
 #pragma once
 
 #include "Effect.h"
+#include "ImdlLoader.h"
+#include "ModelAnimationData.h"
 
 namespace Imase
 {
-	// fNX
-	class Model
+	class SkinPalette;
+
+	// モデルクラス（アニメーションのデータは ModelAnimationData が持つ）
+	class Model : public ModelAnimationData
 	{
-		// Animatortho^
-		friend class Animator;
+		// SkinPaletteをフレンド登録
+		friend class SkinPalette;
+
+		// ModelLoadTaskをフレンド登録
+		friend class ModelLoadTask;
 
 	private:
 
-		// GtFNgւ̃|C^
+		// エフェクトへのポインタ
 		Imase::Effect* m_pEffect;
 
-		// bV
+		// メッシュ情報
 		std::vector<Imase::SubMeshInfo> m_subMeshes;
 
-		// bVO[v
+		// メッシュグループ情報
 		std::vector<Imase::MeshGroupInfo> m_meshGroups;
 
-		// m[h
-		std::vector<Imase::NodeInfo> m_nodes;
+		// スキン情報
+		std::vector<SkinInfo> m_skins;
 
-		// Aj[V
-		std::vector<AnimationClip> m_animations;
+		// テクスチャのシェダーリソース（テクスチャレジストリと共有、解放時に使われなくなったものを取り除く）
+		std::vector<Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>> m_textures;
 
-		// XL
-		std::vector<SkinInfo> m_skins;
+		// マテリアル情報（エフェクトへ登録し直すために保持する）
+		std::vector<Imase::MaterialInfo> m_materials;
 
-		// _obt@
+		// 頂点バッファ
 		Microsoft::WRL::ComPtr<ID3D11Buffer> m_vertexBuffer;
 
-		// CfbNXobt@
+		// インデックスバッファ
 		Microsoft::WRL::ComPtr<ID3D11Buffer> m_indexBuffer;
 
-		// X^CU[Xe[g
+		// インデックスの形式（DXGI_FORMAT_R16_UINT or DXGI_FORMAT_R32_UINT）
+		DXGI_FORMAT m_indexFormat;
+
+		// サブメッシュ毎のベース頂点（16bitインデックスに収めるためのオフセット）
+		std::vector<INT> m_baseVertices;
+
+		// ラスタライザーステート
 		Microsoft::WRL::ComPtr<ID3D11RasterizerState> m_rasterizerState;
 
-		// [xXeVXe[g
+		// 深度ステンシルステート
 		Microsoft::WRL::ComPtr<ID3D11DepthStencilState> m_depthStencilState;
 
-		// uhXe[g
+		// ブレンドステート
 		Microsoft::WRL::ComPtr<ID3D11BlendState> m_blendState;
 
-		// XLL̏ꍇ true
+		// スキン有りの場合 true
 		bool m_hasSkin;
 
+		// 頂点形式
+		Imase::VertexFormat m_vertexFormat;
+
+		// 頂点のストライド
+		UINT m_vertexStride;
+
+		// 量子化された位置の復元用スケールとオフセット
+		DirectX::XMFLOAT3 m_positionScale;
+		DirectX::XMFLOAT3 m_positionOffset;
+
 	private:
 
-		// m[h擾֐
-		const std::vector<Imase::NodeInfo>& GetNodes() const;
+		// インデックスバッファを作成する関数（可能なら16bitインデックスにする）
+		void CreateIndexBuffer(ID3D11Device* device, std::span<const uint32_t> indices);
 
-		// Aj[V擾֐
-		const Imase::AnimationClip* GetAnimation(uint32_t index) const;
+		// スキン情報を取得する関数
+		const std::vector<SkinInfo>& GetSkins() const { return m_skins; }
 
 	public:
 
-		// RXgN^
+		// コンストラクタ
 		Model(ID3D11Device* device, Imase::Effect* pEffect);
 
-		// ff[^쐬֐
+		// デストラクタ
+		~Model();
+
+		// モデルデータ作成関数
 		static std::unique_ptr<Imase::Model> CreateFromImdl(
 			ID3D11Device* device,
 			std::wstring fname,
-			Imase::Effect* pEffect
+			Imase::Effect* pEffect,
+			const Imase::ImdlLoadOptions& options = {}
+		);
+
+		// IMDLファイルからテクスチャまで作成する関数
+		// エフェクトへの登録はしないので、ワーカースレッドから呼び出せる（登録は RegisterToEffect で行う）
+		static std::unique_ptr<Imase::Model> LoadFromImdl(
+			ID3D11Device* device,
+			const std::wstring& fname,
+			Imase::Effect* pEffect,
+			const Imase::ImdlLoadOptions& options = {}
 		);
 
-		// `֐
+		// ロード済みのデータからモデルを作成する関数
+		// バッファとステートの作成のみ行いエフェクトへの登録はしないので、ワーカースレッドから呼び出せる
+		static std::unique_ptr<Imase::Model> CreateFromImdlData(
+			ID3D11Device* device,
+			Imase::ImdlMappedData& data,
+			Imase::Effect* pEffect,
+			const Imase::ImdlLoadOptions& options = {}
+		);
+
+		// 描画関数
+		// skinPalette を指定した場合はスキン行列を計算せずに、更新済みのスキン行列をバインドするだけにする
 		void Draw(
 			ID3D11DeviceContext* context,
 			const DirectX::XMMATRIX& world,
-			const std::vector<DirectX::XMFLOAT4X4>* animatedWorldMatrices = nullptr
+			std::span<const DirectX::XMFLOAT4X4> animatedWorldMatrices = {},
+			Imase::SkinPalette* skinPalette = nullptr
 		);
 
-		// GtFNg擾֐
+		// エフェクトを取得する関数
 		Imase::Effect* GetEffect() const { return m_pEffect; }
 
+		// テクスチャとマテリアルをエフェクトに登録する関数（エフェクトを使う描画スレッドから呼び出すこと）
+		// エフェクトのテクスチャとマテリアルはこのモデルのものに置き換わる
+		void RegisterToEffect();
+
 	};
 }
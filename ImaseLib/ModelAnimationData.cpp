@@ -0,0 +1,95 @@
+//--------------------------------------------------------------------------------------
+// File: ModelAnimationData.cpp
+//
+// モデルのうちアニメーションの再生に必要なデータ（ノード、クリップ）を持つクラス
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "pch.h"
+#include "ModelAnimationData.h"
+#include "ImdlLoader.h"
+
+using namespace DirectX;
+
+// ロード済みのデータからアニメーションのデータだけを作成する関数
+std::unique_ptr<Imase::ModelAnimationData> Imase::ModelAnimationData::CreateFromImdlData(Imase::ImdlMappedData& data)
+{
+    auto animationData = std::make_unique<ModelAnimationData>();
+    animationData->SetAnimationData(data);
+    return animationData;
+}
+
+// ロードしたデータからノードとアニメーションを受け取る関数
+void Imase::ModelAnimationData::SetAnimationData(Imase::ImdlMappedData& data)
+{
+    m_nodes = std::move(data.nodes);
+    m_animations = std::move(data.animationClips);
+    m_bakedAnimations = std::move(data.bakedAnimationClips);
+
+    // アニメーションで動かすノードを調べておく
+    BuildAnimationNodeInfo();
+}
+
+// アニメーションを取得する関数
+const Imase::AnimationClip* Imase::ModelAnimationData::GetAnimation(uint32_t index) const
+{
+    if (index >= m_animations.size())
+    {
+        return nullptr;
+    }
+    return &m_animations[index];
+}
+
+// アニメーションで動かすノードを取得する関数
+const std::vector<uint32_t>* Imase::ModelAnimationData::GetAnimatedNodes(uint32_t index) const
+{
+    if (index >= m_animatedNodes.size())
+    {
+        return nullptr;
+    }
+    return &m_animatedNodes[index];
+}
+
+// アニメーションで動かすノードと初期ポーズのローカル行列を作成する関数
+void Imase::ModelAnimationData::BuildAnimationNodeInfo()
+{
+    // 各アニメーションのチャンネルが対象にしているノード
+    m_animatedNodes.resize(m_animations.size());
+    for (size_t i = 0; i < m_animations.size(); i++)
+    {
+        const AnimationClip& clip = m_animations[i];
+        std::vector<uint32_t>& nodes = m_animatedNodes[i];
+
+        nodes.clear();
+        for (const auto& ch : clip.translations) nodes.push_back(ch.nodeIndex);
+        for (const auto& ch : clip.rotations) nodes.push_back(ch.nodeIndex);
+        for (const auto& ch : clip.scales) nodes.push_back(ch.nodeIndex);
+
+        std::sort(nodes.begin(), nodes.end());
+        nodes.erase(std::unique(nodes.begin(), nodes.end()), nodes.end());
+    }
+
+    // 初期ポーズのローカル行列（アニメーションで動かないノードはこれをそのまま使う）
+    m_bindLocalMatrices.resize(m_nodes.size());
+    for (size_t i = 0; i < m_nodes.size(); i++)
+    {
+        const NodeInfo& node = m_nodes[i];
+
+        XMMATRIX m = XMMatrixScalingFromVector(XMLoadFloat3(&node.defaultScale))
+            * XMMatrixRotationQuaternion(XMLoadFloat4(&node.defaultRotation))
+            * XMMatrixTranslationFromVector(XMLoadFloat3(&node.defaultTranslation));
+
+        XMStoreFloat4x4(&m_bindLocalMatrices[i], m);
+    }
+}
+
+// 焼き込んだアニメーションを取得する関数
+const Imase::BakedAnimationClip* Imase::ModelAnimationData::GetBakedAnimation(uint32_t index) const
+{
+    if (index >= m_bakedAnimations.size() || !m_bakedAnimations[index].IsValid())
+    {
+        return nullptr;
+    }
+    return &m_bakedAnimations[index];
+}
@@ -0,0 +1,82 @@
+//--------------------------------------------------------------------------------------
+// File: ModelAnimationData.h
+//
+// モデルのうちアニメーションの再生に必要なデータ（ノード、クリップ）を持つクラス
+//
+// グラフィックスに依存しないので、Model の基底クラスとして使うほか
+// ベンチマークなどで D3D を使わずにアニメーターを動かす場合にも使えます
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include "AnimationBake.h"
+
+namespace Imase
+{
+    struct ImdlMappedData;
+
+    class ModelAnimationData
+    {
+        // Animatorをフレンド登録
+        friend class Animator;
+
+    protected:
+
+        // ノード情報
+        std::vector<Imase::NodeInfo> m_nodes;
+
+        // アニメーション情報
+        std::vector<AnimationClip> m_animations;
+
+        // 焼き込んだアニメーション情報（ロード時に焼き込んだ場合のみ、m_animations と同じ順）
+        std::vector<BakedAnimationClip> m_bakedAnimations;
+
+        // アニメーション毎に動かすノード（ノード番号の昇順、m_animations と同じ順）
+        std::vector<std::vector<uint32_t>> m_animatedNodes;
+
+        // 初期ポーズの各ノードのローカル行列
+        std::vector<DirectX::XMFLOAT4X4> m_bindLocalMatrices;
+
+    protected:
+
+        // ロードしたデータからノードとアニメーションを受け取る関数（data の中身は移動する）
+        void SetAnimationData(Imase::ImdlMappedData& data);
+
+        // アニメーションで動かすノードと初期ポーズのローカル行列を作成する関数
+        void BuildAnimationNodeInfo();
+
+    private:
+
+        // アニメーションを取得する関数
+        const Imase::AnimationClip* GetAnimation(uint32_t index) const;
+
+        // アニメーションで動かすノードを取得する関数（無い場合は nullptr）
+        const std::vector<uint32_t>* GetAnimatedNodes(uint32_t index) const;
+
+        // 初期ポーズの各ノードのローカル行列を取得する関数
+        const std::vector<DirectX::XMFLOAT4X4>& GetBindLocalMatrices() const { return m_bindLocalMatrices; }
+
+        // 焼き込んだアニメーションを取得する関数（無い場合は nullptr）
+        const Imase::BakedAnimationClip* GetBakedAnimation(uint32_t index) const;
+
+    public:
+
+        // コンストラクタ
+        ModelAnimationData() = default;
+
+        // デストラクタ
+        virtual ~ModelAnimationData() = default;
+
+        // ロード済みのデータからアニメーションのデータだけを作成する関数（描画はできない）
+        static std::unique_ptr<Imase::ModelAnimationData> CreateFromImdlData(Imase::ImdlMappedData& data);
+
+        // ノードを取得する関数
+        const std::vector<Imase::NodeInfo>& GetNodes() const { return m_nodes; }
+
+        // アニメーションの数を取得する関数
+        size_t GetAnimationCount() const { return m_animations.size(); }
+
+    };
+}
@@ -0,0 +1,120 @@
+//--------------------------------------------------------------------------------------
+// File: ModelLoadTask.cpp
+//
+// モデルをワーカースレッドで非同期にロードするクラス
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "pch.h"
+#include "ModelLoadTask.h"
+
+using namespace Imase;
+
+// コンストラクタ
+Imase::ModelLoadTask::ModelLoadTask(
+	ID3D11Device* device,
+	std::wstring fname,
+	Imase::Effect* pEffect,
+	const Imase::ImdlLoadOptions& options
+)
+	: m_state{ ModelLoadState::Loading }
+	, m_progress{ 0.0f }
+	, m_cancelRequested{ false }
+	, m_pEffect{ pEffect }
+{
+	// ID3D11Device のリソース作成はフリースレッドなのでワーカースレッドから呼び出せる
+	m_worker = std::async(std::launch::async, &ModelLoadTask::Run, this, device, std::move(fname), options);
+}
+
+// デストラクタ
+Imase::ModelLoadTask::~ModelLoadTask()
+{
+	Cancel();
+	Wait();
+}
+
+// 終了を待つ関数
+void Imase::ModelLoadTask::Wait()
+{
+	if (m_worker.valid())
+	{
+		m_worker.wait();
+	}
+}
+
+// キャンセルされていれば true を返す関数
+bool Imase::ModelLoadTask::CheckCanceled()
+{
+	if (!m_cancelRequested.load(std::memory_order_relaxed))
+	{
+		return false;
+	}
+
+	// 途中まで作成したリソースは解放する
+	m_model.reset();
+	m_textures.clear();
+	m_state.store(ModelLoadState::Canceled, std::memory_order_release);
+	return true;
+}
+
+// ワーカースレッドで実行するロード処理
+void Imase::ModelLoadTask::Run(ID3D11Device* device, std::wstring fname, ImdlLoadOptions options)
+{
+	try
+	{
+		if (CheckCanceled()) return;
+
+		// IMDLファイルのロード
+		if (FAILED(ImdlLoader::LoadImdlMapped(fname, m_data, options)))
+		{
+			throw std::runtime_error("Failed to load IMDL file.");
+		}
+		m_progress.store(0.4f, std::memory_order_relaxed);
+
+		if (CheckCanceled()) return;
+
+		// テクスチャのシェダーリソースを作成
+		m_textures = Effect::CreateTextures(device, m_data.textures);
+		m_progress.store(0.8f, std::memory_order_relaxed);
+
+		if (CheckCanceled()) return;
+
+		// バッファとステートの作成
+		m_model = Model::CreateFromImdlData(device, m_data, m_pEffect, options);
+		m_progress.store(1.0f, std::memory_order_relaxed);
+
+		if (CheckCanceled()) return;
+
+		m_state.store(ModelLoadState::Ready, std::memory_order_release);
+	}
+	catch (const std::exception& e)
+	{
+		m_model.reset();
+		m_textures.clear();
+		m_error = e.what();
+		m_state.store(ModelLoadState::Failed, std::memory_order_release);
+	}
+}
+
+// 完成したモデルを受け取る関数
+std::unique_ptr<Imase::Model> Imase::ModelLoadTask::TakeModel()
+{
+	if (GetState() != ModelLoadState::Ready)
+	{
+		return nullptr;
+	}
+
+	// エフェクトは描画中に参照されるので、登録は呼び出し側のスレッドで行う
+	m_model->m_textures = m_textures;
+	m_model->m_materials = m_data.materials;
+	m_pEffect->RegisterTextures(std::move(m_textures));
+	m_pEffect->RegisterMaterials(m_data.materials);
+
+	// GPUへ転送済みなのでファイルのマッピングを解放する
+	m_data = ImdlMappedData{};
+
+	m_state.store(ModelLoadState::Taken, std::memory_order_release);
+
+	return std::move(m_model);
+}
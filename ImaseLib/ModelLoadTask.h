@@ -0,0 +1,107 @@
+//--------------------------------------------------------------------------------------
+// File: ModelLoadTask.h
+//
+// モデルをワーカースレッドで非同期にロードするクラス
+//
+// ファイルの解析、テクスチャとバッファの作成はワーカースレッドで行い、
+// エフェクトへの登録は TakeModel を呼び出したスレッド（メインスレッド）で行います
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include "Model.h"
+
+#include <atomic>
+#include <future>
+
+namespace Imase
+{
+	// ロードの状態
+	enum class ModelLoadState
+	{
+		Loading,	// ロード中
+		Ready,		// 完了（TakeModel で受け取れる）
+		Failed,		// 失敗
+		Canceled,	// キャンセルされた
+		Taken,		// 受け取り済み
+	};
+
+	// モデルの非同期ロードクラス
+	class ModelLoadTask
+	{
+	private:
+
+		// ロード中のデータ（ワーカースレッドのみが書き込む）
+		ImdlMappedData m_data;
+		std::vector<Microsoft::WRL::ComPtr<ID3D11ShaderResourceView>> m_textures;
+		std::unique_ptr<Model> m_model;
+
+		// 状態
+		std::atomic<ModelLoadState> m_state;
+
+		// 進捗（0～1）
+		std::atomic<float> m_progress;
+
+		// キャンセル要求
+		std::atomic<bool> m_cancelRequested;
+
+		// エラーメッセージ（Failed の場合のみ）
+		std::string m_error;
+
+		// エフェクトへのポインタ
+		Imase::Effect* m_pEffect;
+
+		// ワーカースレッド
+		std::future<void> m_worker;
+
+	private:
+
+		// ワーカースレッドで実行するロード処理
+		void Run(ID3D11Device* device, std::wstring fname, ImdlLoadOptions options);
+
+		// キャンセルされていれば true を返す関数
+		bool CheckCanceled();
+
+	public:
+
+		// コンストラクタ（ワーカースレッドでロードを開始する）
+		ModelLoadTask(
+			ID3D11Device* device,
+			std::wstring fname,
+			Imase::Effect* pEffect,
+			const Imase::ImdlLoadOptions& options = {}
+		);
+
+		// デストラクタ（ロード中ならキャンセルして終了を待つ）
+		~ModelLoadTask();
+
+		ModelLoadTask(const ModelLoadTask&) = delete;
+		ModelLoadTask& operator=(const ModelLoadTask&) = delete;
+
+		// 状態を取得する関数
+		ModelLoadState GetState() const { return m_state.load(std::memory_order_acquire); }
+
+		// 進捗を取得する関数（0～1）
+		float GetProgress() const { return m_progress.load(std::memory_order_relaxed); }
+
+		// ロードが終了していれば true を返す関数（成功、失敗、キャンセルのいずれか）
+		bool IsDone() const { return GetState() != ModelLoadState::Loading; }
+
+		// キャンセルを要求する関数（次の区切りでロードを中断する）
+		void Cancel() { m_cancelRequested.store(true, std::memory_order_relaxed); }
+
+		// 終了を待つ関数
+		void Wait();
+
+		// エラーメッセージを取得する関数（終了後のみ有効）
+		const std::string& GetError() const { return m_error; }
+
+		// 完成したモデルを受け取る関数（メインスレッドで呼び出すこと）
+		// エフェクトへテクスチャとマテリアルを登録してからモデルを返す
+		// 完了していない場合は nullptr を返す
+		std::unique_ptr<Model> TakeModel();
+
+	};
+}
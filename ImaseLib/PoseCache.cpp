@@ -0,0 +1,124 @@
+//--------------------------------------------------------------------------------------
+// File: PoseCache.cpp
+//
+// 同じクリップを同じ時間で再生しているアニメーター同士で姿勢を共有するキャッシュ
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "pch.h"
+#include "PoseCache.h"
+
+// コンストラクタ
+Imase::PoseCache::PoseCache(size_t capacity, float timeQuantum)
+    : m_timeQuantum{ std::max(timeQuantum, 0.0f) }
+    , m_entryCount{ 0 }
+    , m_lookupCount{ 0 }
+    , m_hitCount{ 0 }
+{
+    capacity = std::max(capacity, static_cast<size_t>(1));
+
+    m_entries.resize(capacity);
+    for (auto& entry : m_entries)
+    {
+        entry = std::make_unique<Entry>();
+    }
+
+    // テーブルはエントリー数の２倍以上の２のべき乗（空きを残して検索を短くする）
+    size_t tableSize = 1;
+    while (tableSize < capacity * 2)
+    {
+        tableSize *= 2;
+    }
+    m_table.assign(tableSize, -1);
+}
+
+// フレームの開始（前のフレームの姿勢と統計情報を破棄する）
+void Imase::PoseCache::BeginFrame()
+{
+    for (size_t i = 0; i < m_entryCount; i++)
+    {
+        m_entries[i]->ready.store(false, std::memory_order_relaxed);
+    }
+    std::fill(m_table.begin(), m_table.end(), -1);
+
+    m_entryCount = 0;
+    m_lookupCount = 0;
+    m_hitCount = 0;
+}
+
+// 時間を量子化する関数（戻り値はサンプリングする時間、timeKey にキーを返す）
+float Imase::PoseCache::Quantize(float time, int64_t& timeKey) const
+{
+    if (m_timeQuantum <= 0.0f)
+    {
+        // 同じ時間のみ共有する
+        uint32_t bits;
+        std::memcpy(&bits, &time, sizeof(bits));
+        timeKey = bits;
+        return time;
+    }
+
+    // 切り捨てて、クリップの長さを超えないようにする
+    timeKey = static_cast<int64_t>(std::floor(time / m_timeQuantum));
+    return static_cast<float>(timeKey) * m_timeQuantum;
+}
+
+// キーのハッシュ値を計算する関数
+size_t Imase::PoseCache::Hash(const Key& key)
+{
+    size_t h = std::hash<const void*>()(key.model);
+    h ^= std::hash<const void*>()(key.nodeMask) + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+    h ^= std::hash<int32_t>()(key.clipIndex) + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+    h ^= std::hash<int64_t>()(key.timeKey) + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+    h ^= std::hash<uint32_t>()(static_cast<uint32_t>(key.rotationInterpolation)) + 0x9e3779b97f4a7c15ull + (h << 6) + (h >> 2);
+    return h;
+}
+
+// 姿勢を取得する関数
+Imase::PoseCache::Entry* Imase::PoseCache::Acquire(const Key& key, bool& hit)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_lookupCount++;
+    hit = false;
+
+    size_t mask = m_table.size() - 1;
+    for (size_t i = Hash(key) & mask; ; i = (i + 1) & mask)
+    {
+        int32_t index = m_table[i];
+
+        // 無いので書き込み用に確保する
+        if (index < 0)
+        {
+            if (m_entryCount >= m_entries.size()) return nullptr;
+
+            Entry* entry = m_entries[m_entryCount].get();
+            entry->key = key;
+            m_table[i] = static_cast<int32_t>(m_entryCount);
+            m_entryCount++;
+            return entry;
+        }
+
+        Entry* entry = m_entries[index].get();
+        if (entry->key == key)
+        {
+            // 他のアニメーターが書き込み中なら共有できない
+            if (!entry->ready.load(std::memory_order_acquire)) return nullptr;
+
+            m_hitCount++;
+            hit = true;
+            return entry;
+        }
+    }
+}
+
+// 統計情報を取得する関数
+Imase::PoseCache::Stats Imase::PoseCache::GetStats() const
+{
+    Stats stats;
+    stats.lookupCount = m_lookupCount;
+    stats.hitCount = m_hitCount;
+    stats.entryCount = static_cast<uint32_t>(m_entryCount);
+    return stats;
+}
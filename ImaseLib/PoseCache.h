@@ -0,0 +1,129 @@
+//--------------------------------------------------------------------------------------
+// File: PoseCache.h
+//
+// 同じクリップを同じ時間で再生しているアニメーター同士で姿勢を共有するキャッシュ
+//
+// (モデル、クリップ、量子化した時間、サンプリングするノード、回転の補間方式) をキーに、そのフレームに
+// サンプリングした姿勢とワールド行列を保存します。群衆のように多数のインスタンスが同じクリップを
+// ほぼ同じ時間で再生している場合、２体目以降はサンプリングと行列の計算を省いてコピーするだけになります
+// 時間の量子化の幅を大きくするほど共有されやすくなりますが、動きは幅の分だけ段階的になります
+// 対象は単一再生のみです（ブレンド中やブレンドツリーは個別に計算します）
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include "AnimationPose.h"
+
+#include <atomic>
+#include <mutex>
+
+namespace Imase
+{
+    class ModelAnimationData;
+
+    class PoseCache
+    {
+    public:
+
+        // キー
+        struct Key
+        {
+            const Imase::ModelAnimationData* model = nullptr;
+            const uint8_t* nodeMask = nullptr;
+            int32_t clipIndex = -1;
+            int64_t timeKey = 0;
+            RotationInterpolation rotationInterpolation = RotationInterpolation::Slerp;
+
+            bool operator==(const Key& other) const
+            {
+                return model == other.model && nodeMask == other.nodeMask
+                    && clipIndex == other.clipIndex && timeKey == other.timeKey
+                    && rotationInterpolation == other.rotationInterpolation;
+            }
+        };
+
+        // キャッシュした姿勢
+        struct Entry
+        {
+            Key key;
+
+            // サンプリングした姿勢
+            AnimationPose pose;
+
+            // 各ノードのワールド行列
+            std::vector<DirectX::XMFLOAT4X4> worldMatrices;
+
+            // 書き込みが終わったか（書き込み中のエントリーは使えないので各自で計算する）
+            std::atomic<bool> ready{ false };
+        };
+
+        // 統計情報（BeginFrame からの集計）
+        struct Stats
+        {
+            uint32_t lookupCount = 0;   // 検索した数
+            uint32_t hitCount = 0;      // 共有できた数
+            uint32_t entryCount = 0;    // 保存した姿勢の数
+
+            // ヒット率（0～1）
+            float GetHitRate() const { return lookupCount ? static_cast<float>(hitCount) / lookupCount : 0.0f; }
+        };
+
+    private:
+
+        // 時間の量子化の幅（秒、0 なら同じ時間のみ共有する）
+        float m_timeQuantum;
+
+        // エントリー（再確保しないように最初に全て作っておく）
+        std::vector<std::unique_ptr<Entry>> m_entries;
+
+        // このフレームで使ったエントリーの数
+        size_t m_entryCount;
+
+        // ハッシュテーブル（エントリー番号、-1 は空き、オープンアドレス法）
+        std::vector<int32_t> m_table;
+
+        // 並列に更新するアニメーターから使うための排他制御
+        std::mutex m_mutex;
+
+        // このフレームの検索数とヒット数
+        uint32_t m_lookupCount;
+        uint32_t m_hitCount;
+
+    private:
+
+        // キーのハッシュ値を計算する関数
+        static size_t Hash(const Key& key);
+
+    public:
+
+        // コンストラクタ（capacity は１フレームに保存できる姿勢の数）
+        explicit PoseCache(size_t capacity = 256, float timeQuantum = 1.0f / 60.0f);
+
+        PoseCache(const PoseCache&) = delete;
+        PoseCache& operator=(const PoseCache&) = delete;
+
+        // フレームの開始（前のフレームの姿勢と統計情報を破棄する）
+        void BeginFrame();
+
+        // 時間の量子化の幅を設定する関数（秒、0 なら同じ時間のみ共有する）
+        void SetTimeQuantum(float seconds) { m_timeQuantum = std::max(seconds, 0.0f); }
+
+        // 時間の量子化の幅を取得する関数
+        float GetTimeQuantum() const { return m_timeQuantum; }
+
+        // 時間を量子化する関数（戻り値はサンプリングする時間、timeKey にキーを返す）
+        float Quantize(float time, int64_t& timeKey) const;
+
+        // 姿勢を取得する関数
+        // 見つかった場合は hit が true、無ければ書き込み用に確保したエントリー（満杯なら nullptr）を返す
+        Entry* Acquire(const Key& key, bool& hit);
+
+        // 書き込み用に確保したエントリーを使えるようにする関数
+        void Publish(Entry* entry) { entry->ready.store(true, std::memory_order_release); }
+
+        // 統計情報を取得する関数（更新中に呼ばないこと）
+        Stats GetStats() const;
+    };
+}
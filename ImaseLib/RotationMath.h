@@ -0,0 +1,143 @@
+//--------------------------------------------------------------------------------------
+// File: RotationMath.h
+//
+// 回転（クォータニオン）の補間方式と補間関数
+//
+// キーのサンプリングとポーズのブレンドは同じ補間方式を使います
+// 既定は球面線形補間で、正規化線形補間は速度を優先する場合に選択します
+// 補正付きの正規化線形補間は三角関数を使わずに球面線形補間に近い結果になります
+// MeasureRotationError で球面線形補間との誤差を調べることができます
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <DirectXMath.h>
+#include "Imdl.h"
+
+namespace Imase
+{
+    // 回転の補間方式
+    enum class RotationInterpolation
+    {
+        Slerp,      // 球面線形補間（正確だが三角関数を使う）
+        Nlerp,      // 正規化線形補間（角速度が一定にならない）
+        FastNlerp,  // 補正付きの正規化線形補間（ウエイトを多項式で補正して球面線形補間に近づける）
+    };
+
+    // 補間のウエイトを求める関数（4レーン同時）
+    // d は2つの回転の内積の絶対値、t は補間係数
+    // a に掛けるウエイトを wa、b に掛けるウエイトを wb に返す（b の反転は呼び出し側で行う）
+    inline void GetRotationBlendWeights(RotationInterpolation mode, DirectX::FXMVECTOR d, DirectX::FXMVECTOR t, DirectX::XMVECTOR* wa, DirectX::XMVECTOR* wb)
+    {
+        using namespace DirectX;
+
+        XMVECTOR one = XMVectorReplicate(1.0f);
+
+        switch (mode)
+        {
+        case RotationInterpolation::Slerp:
+        {
+            XMVECTOR theta = XMVectorACos(XMVectorMin(d, one));
+            XMVECTOR invSin = XMVectorReciprocal(XMVectorSin(theta));
+            XMVECTOR sa = XMVectorMultiply(XMVectorSin(XMVectorMultiply(XMVectorSubtract(one, t), theta)), invSin);
+            XMVECTOR sb = XMVectorMultiply(XMVectorSin(XMVectorMultiply(t, theta)), invSin);
+
+            // ほぼ同じ向きの場合は sin が 0 に近づくので線形補間にする（XMQuaternionSlerp と同じしきい値）
+            XMVECTOR nearly = XMVectorGreater(d, XMVectorReplicate(1.0f - 0.00001f));
+            *wa = XMVectorSelect(sa, XMVectorSubtract(one, t), nearly);
+            *wb = XMVectorSelect(sb, t, nearly);
+            break;
+        }
+        case RotationInterpolation::FastNlerp:
+        {
+            // 正規化線形補間の角速度のずれを補正したウエイト
+            XMVECTOR ka = XMVectorMultiplyAdd(d, XMVectorMultiplyAdd(d, XMVectorMultiplyAdd(d, XMVectorReplicate(-1.43519f), XMVectorReplicate(3.55645f)), XMVectorReplicate(-3.2452f)), XMVectorReplicate(1.0904f));
+            XMVECTOR kb = XMVectorMultiplyAdd(d, XMVectorMultiplyAdd(d, XMVectorReplicate(0.215638f), XMVectorReplicate(-1.06021f)), XMVectorReplicate(0.848013f));
+            XMVECTOR h = XMVectorSubtract(t, XMVectorReplicate(0.5f));
+            XMVECTOR k = XMVectorMultiplyAdd(XMVectorMultiply(h, h), ka, kb);
+            XMVECTOR wt = XMVectorMultiplyAdd(XMVectorMultiply(XMVectorMultiply(t, h), XMVectorSubtract(t, one)), k, t);
+            *wa = XMVectorSubtract(one, wt);
+            *wb = wt;
+            break;
+        }
+        default:
+            *wa = XMVectorSubtract(one, t);
+            *wb = t;
+            break;
+        }
+    }
+
+    // 2つの回転を補間する関数（最短経路になるよう内積が負の場合は b を反転する）
+    inline DirectX::XMVECTOR InterpolateRotation(RotationInterpolation mode, DirectX::FXMVECTOR a, DirectX::FXMVECTOR b, float t)
+    {
+        using namespace DirectX;
+
+        if (mode == RotationInterpolation::Slerp) return XMQuaternionSlerp(a, b, t);
+
+        XMVECTOR dot = XMQuaternionDot(a, b);
+        XMVECTOR sign = XMVectorSelect(XMVectorReplicate(1.0f), XMVectorReplicate(-1.0f), XMVectorLess(dot, XMVectorZero()));
+
+        XMVECTOR wa, wb;
+        GetRotationBlendWeights(mode, XMVectorAbs(dot), XMVectorReplicate(t), &wa, &wb);
+
+        return XMQuaternionNormalize(XMVectorMultiplyAdd(b, XMVectorMultiply(wb, sign), XMVectorMultiply(a, wa)));
+    }
+
+    // 2つの回転の間の角度を求める関数（ラジアン、q と -q は同じ回転として扱う）
+    inline float GetRotationAngle(DirectX::FXMVECTOR a, DirectX::FXMVECTOR b)
+    {
+        using namespace DirectX;
+
+        // 内積の acos は 0 付近の精度が悪いので、相対回転の軸成分の長さと w から求める
+        XMFLOAT4 r;
+        XMStoreFloat4(&r, XMQuaternionMultiply(XMQuaternionConjugate(a), b));
+        float s = std::sqrt(r.x * r.x + r.y * r.y + r.z * r.z);
+        return 2.0f * std::atan2(s, std::abs(r.w));
+    }
+
+    // 球面線形補間との誤差
+    struct RotationErrorStats
+    {
+        float maxError = 0.0f;      // 最大の誤差（ラジアン）
+        float meanError = 0.0f;     // 平均の誤差（ラジアン）
+        uint32_t sampleCount = 0;   // 調べた数
+    };
+
+    // クリップの全ての回転チャンネルのキー間を subdivisions 分割した位置で
+    // 指定した補間方式と球面線形補間の結果の角度の差を調べる関数
+    // ポーズのブレンドも同じウエイトを使うので、この誤差がブレンドの誤差になります
+    inline RotationErrorStats MeasureRotationError(const AnimationClip& clip, RotationInterpolation mode, uint32_t subdivisions = 16)
+    {
+        using namespace DirectX;
+
+        RotationErrorStats stats;
+        double total = 0.0;
+
+        for (const auto& ch : clip.rotations)
+        {
+            for (size_t i = 0; i + 1 < ch.values.size(); i++)
+            {
+                XMVECTOR a = XMLoadFloat4(&ch.values[i]);
+                XMVECTOR b = XMLoadFloat4(&ch.values[i + 1]);
+
+                for (uint32_t s = 1; s < subdivisions; s++)
+                {
+                    float t = static_cast<float>(s) / static_cast<float>(subdivisions);
+                    float error = GetRotationAngle(XMQuaternionSlerp(a, b, t), InterpolateRotation(mode, a, b, t));
+
+                    stats.maxError = std::max(stats.maxError, error);
+                    total += error;
+                    stats.sampleCount++;
+                }
+            }
+        }
+
+        if (stats.sampleCount > 0) stats.meanError = static_cast<float>(total / stats.sampleCount);
+
+        return stats;
+    }
+}
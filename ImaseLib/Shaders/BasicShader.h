@@ -1,7 +1,7 @@
 //--------------------------------------------------------------------------------------
 // File: BasicShader.h
 //
-// x[VbNVF[_[
+// ベーシックシェーダー
 //
 // Date: 2025.2.11
 // Author: Hideyasu Imase
@@ -16,9 +16,9 @@ namespace Imase
 	{
     public:
 
-        // RXgN^
+        // コンストラクタ
         BasicShader(ID3D11Device* device)
-            : ShaderBase(device, L"Resources/Shaders/BasicVS.cso", L"Resources/Shaders/BasicPS.cso")
+            : ShaderBase(device, L"Resources/Shaders/BasicVS.cso", L"Resources/Shaders/BasicPS.cso", L"Resources/Shaders/BasicPackedVS.cso")
         {
         }
 
@@ -1,7 +1,7 @@
 //--------------------------------------------------------------------------------------
 // File: NormalMapShader.h
 //
-// @}bvVF[_[
+// 法線マップシェーダー
 //
 // Date: 2025.2.11
 // Author: Hideyasu Imase
@@ -16,9 +16,9 @@ namespace Imase
 	{
     public:
 
-        // RXgN^
+        // コンストラクタ
         NormalMapShader(ID3D11Device* device)
-            : ShaderBase(device, L"Resources/Shaders/NormalMapVS.cso", L"Resources/Shaders/NormalMapPS.cso")
+            : ShaderBase(device, L"Resources/Shaders/NormalMapVS.cso", L"Resources/Shaders/NormalMapPS.cso", L"Resources/Shaders/NormalMapPackedVS.cso")
         {
         }
 
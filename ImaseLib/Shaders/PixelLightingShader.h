@@ -1,7 +1,7 @@
 //--------------------------------------------------------------------------------------
 // File: PixelLightingShader.h
 //
-// sNZCeBOVF[_[
+// ピクセルライティングシェーダー
 //
 // Date: 2025.2.11
 // Author: Hideyasu Imase
@@ -16,9 +16,9 @@ namespace Imase
 	{
     public:
 
-        // RXgN^
+        // コンストラクタ
         PixelLightingShader(ID3D11Device* device)
-            : ShaderBase(device, L"Resources/Shaders/PixelLightingVS.cso", L"Resources/Shaders/PixelLightingPS.cso")
+            : ShaderBase(device, L"Resources/Shaders/PixelLightingVS.cso", L"Resources/Shaders/PixelLightingPS.cso", L"Resources/Shaders/PixelLightingPackedVS.cso")
         {
         }
 
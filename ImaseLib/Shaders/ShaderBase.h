@@ -1,7 +1,7 @@
 //--------------------------------------------------------------------------------------
 // File: ShaderBase.h
 //
-// VF[_[̊NX
+// シェーダーの基底クラス
 //
 // Date: 2025.2.11
 // Author: Hideyasu Imase
@@ -23,25 +23,34 @@ namespace Imase
         All = VS | PS | GS | HS | DS | CS
     };
 
+    // 頂点形式
+    enum class VertexFormat : uint32_t
+    {
+        Standard,           // VertexPositionNormalTextureTangent
+        Packed,             // VertexPacked
+        PackedQuantized,    // VertexPackedQuantized
+    };
+
     struct UserConstantBuffer
     {
-        ID3D11Buffer* buffer;   // 萔obt@
-        UINT slot;              // Xbg
-        ShaderStage stage;      // gpXe[W
+        ID3D11Buffer* buffer;   // 定数バッファ
+        UINT slot;              // スロット
+        ShaderStage stage;      // 使用ステージ
     };
 
     class ShaderBase
     {
     public:
 
-        // RXgN^
+        // コンストラクタ
         ShaderBase(
             ID3D11Device* device,
             const wchar_t* vsFile,
-            const wchar_t* psFile
+            const wchar_t* psFile,
+            const wchar_t* packedVsFile = nullptr
         )
         {
-            // _VF[_[쐬
+            // 頂点シェーダー作成
             std::vector<uint8_t> vsData = DX::ReadData(vsFile);
 
             DX::ThrowIfFailed(
@@ -52,10 +61,10 @@ namespace Imase
                     m_vertexShader.ReleaseAndGetAddressOf())
             );
 
-            // ̓CAEg쐬
+            // 入力レイアウト作成
             CreateInputLayout(device, vsData);
 
-            // sNZVF[_[쐬
+            // ピクセルシェーダー作成
             std::vector<uint8_t> psData = DX::ReadData(psFile);
 
             DX::ThrowIfFailed(
@@ -65,22 +74,68 @@ namespace Imase
                     nullptr,
                     m_pixelShader.ReleaseAndGetAddressOf())
             );
+
+            // 圧縮頂点用の頂点シェーダーは初めて使う時に作成する（使わない場合はファイルが無くてもよい）
+            if (packedVsFile)
+            {
+                m_packedVsFile = packedVsFile;
+            }
         }
 
-        // fXgN^
+        // デストラクタ
         virtual ~ShaderBase() = default;
 
-        // VF[_[E̓CAEgoCh
-        virtual void Bind(ID3D11DeviceContext* context)
+        // シェーダー・入力レイアウトをバインド
+        virtual void Bind(ID3D11DeviceContext* context, VertexFormat format = VertexFormat::Standard)
         {
-            context->VSSetShader(m_vertexShader.Get(), nullptr, 0);
+            if (format == VertexFormat::Standard)
+            {
+                context->VSSetShader(m_vertexShader.Get(), nullptr, 0);
+                context->IASetInputLayout(m_inputLayout.Get());
+            }
+            else
+            {
+                if (!m_packedVertexShader)
+                {
+                    LoadPackedVertexShader(context);
+                }
+
+                context->VSSetShader(m_packedVertexShader.Get(), nullptr, 0);
+                context->IASetInputLayout(
+                    format == VertexFormat::PackedQuantized ? m_quantizedInputLayout.Get() : m_packedInputLayout.Get()
+                );
+            }
             context->PSSetShader(m_pixelShader.Get(), nullptr, 0);
-            context->IASetInputLayout(m_inputLayout.Get());
         }
 
     protected:
 
-        // ̓CAEg쐬
+        // 圧縮頂点用の頂点シェーダーと入力レイアウトを作成する関数
+        void LoadPackedVertexShader(ID3D11DeviceContext* context)
+        {
+            if (m_packedVsFile.empty())
+            {
+                throw std::logic_error("Packed vertex shader is not specified");
+            }
+
+            Microsoft::WRL::ComPtr<ID3D11Device> device;
+            context->GetDevice(device.GetAddressOf());
+
+            std::vector<uint8_t> packedVsData = DX::ReadData(m_packedVsFile.c_str());
+
+            DX::ThrowIfFailed(
+                device->CreateVertexShader(
+                    packedVsData.data(),
+                    packedVsData.size(),
+                    nullptr,
+                    m_packedVertexShader.ReleaseAndGetAddressOf())
+            );
+
+            // 入力レイアウト作成（圧縮頂点）
+            CreatePackedInputLayout(device.Get(), packedVsData);
+        }
+
+        // 入力レイアウト作成
         void CreateInputLayout(
             ID3D11Device* device,
             const std::vector<uint8_t>& vsData
@@ -105,24 +160,72 @@ namespace Imase
                     m_inputLayout.ReleaseAndGetAddressOf()));
         }
 
+        // 入力レイアウト作成（圧縮頂点：VertexPacked / VertexPackedQuantized）
+        void CreatePackedInputLayout(
+            ID3D11Device* device,
+            const std::vector<uint8_t>& vsData
+        )
+        {
+            static const D3D11_INPUT_ELEMENT_DESC layout[] =
+            {
+                { "POSITION",     0, DXGI_FORMAT_R32G32B32_FLOAT,    0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+                { "NORMAL",       0, DXGI_FORMAT_R16G16B16A16_SNORM, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+                { "TEXCOORD",     0, DXGI_FORMAT_R16G16_FLOAT,       0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+                { "BLENDINDICES", 0, DXGI_FORMAT_R8G8B8A8_UINT,      0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+                { "BLENDWEIGHT",  0, DXGI_FORMAT_R8G8B8A8_UNORM,     0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+            };
+
+            DX::ThrowIfFailed(
+                device->CreateInputLayout(
+                    layout,
+                    ARRAYSIZE(layout),
+                    vsData.data(),
+                    vsData.size(),
+                    m_packedInputLayout.ReleaseAndGetAddressOf()));
+
+            // 位置を量子化した形式は POSITION のみ異なる
+            static const D3D11_INPUT_ELEMENT_DESC quantizedLayout[] =
+            {
+                { "POSITION",     0, DXGI_FORMAT_R16G16B16A16_UNORM, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+                { "NORMAL",       0, DXGI_FORMAT_R16G16B16A16_SNORM, 0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+                { "TEXCOORD",     0, DXGI_FORMAT_R16G16_FLOAT,       0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+                { "BLENDINDICES", 0, DXGI_FORMAT_R8G8B8A8_UINT,      0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+                { "BLENDWEIGHT",  0, DXGI_FORMAT_R8G8B8A8_UNORM,     0, D3D11_APPEND_ALIGNED_ELEMENT, D3D11_INPUT_PER_VERTEX_DATA, 0 },
+            };
+
+            DX::ThrowIfFailed(
+                device->CreateInputLayout(
+                    quantizedLayout,
+                    ARRAYSIZE(quantizedLayout),
+                    vsData.data(),
+                    vsData.size(),
+                    m_quantizedInputLayout.ReleaseAndGetAddressOf()));
+        }
+
     protected:
 
         Microsoft::WRL::ComPtr<ID3D11VertexShader> m_vertexShader;
         Microsoft::WRL::ComPtr<ID3D11PixelShader>  m_pixelShader;
         Microsoft::WRL::ComPtr<ID3D11InputLayout>  m_inputLayout;
 
+        // 圧縮頂点用（m_packedVsFile から初めて使う時に作成する）
+        std::wstring m_packedVsFile;
+        Microsoft::WRL::ComPtr<ID3D11VertexShader> m_packedVertexShader;
+        Microsoft::WRL::ComPtr<ID3D11InputLayout>  m_packedInputLayout;
+        Microsoft::WRL::ComPtr<ID3D11InputLayout>  m_quantizedInputLayout;
+
     public:
 
-        // UserCBH
+        // UserCBを持つか？
         virtual bool HasUserCB() const { return false; }
 
-        // UserCB̃obt@擾
+        // UserCBのバッファを取得
         virtual void GetUserCBs(std::vector<UserConstantBuffer>& out) const
         {
             out.clear();
         }
 
-        // UserCB̍XV
+        // UserCBの更新
         virtual void UpdateUserCBs(ID3D11DeviceContext* context)
         {
             UNREFERENCED_PARAMETER(context);
@@ -0,0 +1,142 @@
+//--------------------------------------------------------------------------------------
+// File: SkinPalette.cpp
+//
+// スキニング用のスキン行列（パレット）を作成するクラス
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "pch.h"
+#include "SkinPalette.h"
+
+using namespace DirectX;
+
+// コンストラクタ
+Imase::SkinPalette::SkinPalette(ID3D11Device* device, const Imase::Model& model, Imase::SkinFormat format)
+    : m_model{ model }
+    , m_format{ format }
+    , m_profile{ nullptr }
+    , m_sharedBuffer{ nullptr }
+    , m_sharedOffset{ 0 }
+    , m_sharedFrame{ 0 }
+{
+    size_t stride = GetSkinVectorCount(format);
+
+    const std::vector<SkinInfo>& skins = model.GetSkins();
+
+    m_skins.resize(skins.size());
+
+    size_t offset = 0;
+    for (size_t i = 0; i < skins.size(); i++)
+    {
+        Skin& skin = m_skins[i];
+        skin.offset = offset;
+        skin.jointCount = skins[i].jointIndices.size();
+        skin.dirty = true;
+
+        offset += skin.jointCount * stride;
+
+        // 定数バッファに入らない場合は SkinPaletteBuffer でのみ描画する
+        if (skin.jointCount > MaxBones) continue;
+
+        // 定数バッファの作成
+        D3D11_BUFFER_DESC desc = {};
+        desc.ByteWidth = sizeof(Imase::SkinCB);
+        desc.Usage = D3D11_USAGE_DYNAMIC;
+        desc.BindFlags = D3D11_BIND_CONSTANT_BUFFER;
+        desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+        DX::ThrowIfFailed(
+            device->CreateBuffer(&desc, nullptr, skin.buffer.ReleaseAndGetAddressOf())
+        );
+    }
+
+    // 初期値は単位行列
+    m_palette.resize(offset);
+    for (size_t i = 0; i < offset; i += stride)
+    {
+        PackSkinMatrix(format, XMMatrixIdentity(), &m_palette[i]);
+    }
+}
+
+// スキン行列を更新する関数（アニメーションの更新後に１回呼び出す）
+void Imase::SkinPalette::Update(std::span<const DirectX::XMFLOAT4X4> animatedWorldMatrices)
+{
+    const std::vector<SkinInfo>& skins = m_model.GetSkins();
+    size_t stride = GetSkinVectorCount(m_format);
+
+    AnimationProfile::ScopedTimer timer(m_profile, AnimationProfile::Stage::SkinPalette, m_palette.size() / stride);
+
+    for (size_t skinIndex = 0; skinIndex < m_skins.size(); skinIndex++)
+    {
+        Skin& skin = m_skins[skinIndex];
+        const SkinInfo& info = skins[skinIndex];
+
+        for (size_t i = 0; i < skin.jointCount; i++)
+        {
+            uint32_t jointNodeIndex = info.jointIndices[i];
+            if (jointNodeIndex >= animatedWorldMatrices.size()) continue;
+
+            XMMATRIX jointWorld = XMLoadFloat4x4(&animatedWorldMatrices[jointNodeIndex]);
+            XMMATRIX ibm = XMLoadFloat4x4(&info.inverseBindMatrices[i]);
+
+            // シェーダーにそのまま送れる形式で保存する
+            PackSkinMatrix(m_format, ibm * jointWorld, &m_palette[skin.offset + i * stride]);
+        }
+
+        skin.dirty = true;
+    }
+}
+
+// スキン行列の定数バッファを取得する関数（更新後の最初の呼び出しで転送する）
+ID3D11Buffer* Imase::SkinPalette::GetBuffer(ID3D11DeviceContext* context, int skinIndex)
+{
+    Skin& skin = m_skins[skinIndex];
+
+    assert(skin.buffer && "MaxBones を超えるスキンは SkinPaletteBuffer を使ってください");
+
+    if (skin.dirty)
+    {
+        // 使用するジョイントの分だけ転送する（残りはシェーダーから参照されない）
+        D3D11_MAPPED_SUBRESOURCE mapped = {};
+        DX::ThrowIfFailed(
+            context->Map(skin.buffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped)
+        );
+        memcpy(mapped.pData, m_palette.data() + skin.offset, sizeof(XMFLOAT4) * skin.jointCount * GetSkinVectorCount(m_format));
+        context->Unmap(skin.buffer.Get(), 0);
+
+        skin.dirty = false;
+    }
+
+    return skin.buffer.Get();
+}
+
+// スキン行列をまとめたバッファに書き込む関数（フレーム毎、Upload の前に呼び出す）
+void Imase::SkinPalette::WriteTo(Imase::SkinPaletteBuffer& buffer)
+{
+    m_sharedBuffer = &buffer;
+    m_sharedFrame = buffer.GetFrame();
+    m_sharedOffset = buffer.Allocate(m_palette.size());
+
+    memcpy(buffer.GetData(m_sharedOffset), m_palette.data(), sizeof(XMFLOAT4) * m_palette.size());
+}
+
+// このフレームのまとめたバッファに書き込み済みか？
+bool Imase::SkinPalette::IsWrittenTo(const Imase::SkinPaletteBuffer& buffer) const
+{
+    return m_sharedBuffer == &buffer && m_sharedFrame == buffer.GetFrame();
+}
+
+// 描画に使うスキン行列をエフェクトに設定する関数
+void Imase::SkinPalette::Bind(ID3D11DeviceContext* context, Imase::Effect* effect, int skinIndex)
+{
+    if (m_sharedBuffer && IsWrittenTo(*m_sharedBuffer))
+    {
+        // まとめたバッファから読む（転送は SkinPaletteBuffer::Upload で済んでいる）
+        uint32_t offset = m_sharedOffset + static_cast<uint32_t>(m_skins[skinIndex].offset);
+        effect->SetSkinBuffer(m_sharedBuffer->GetShaderResourceView(), offset, m_format);
+    }
+    else
+    {
+        effect->SetSkinBuffer(GetBuffer(context, skinIndex), m_format);
+    }
+}
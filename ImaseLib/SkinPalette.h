@@ -0,0 +1,93 @@
+//--------------------------------------------------------------------------------------
+// File: SkinPalette.h
+//
+// スキニング用のスキン行列（パレット）を作成するクラス
+//
+// アニメーションの更新毎に１回だけ、転置済みで GPU にそのまま送れるスキン行列を作成します
+// スキン行列はモデル空間で作成するので、同じポーズのインスタンスは配置が違っても共有できます
+// 定数バッファへの転送は更新後に最初に使われた時の１回だけ行います
+// 形式は 3x4 行列（既定）かデュアルクォータニオンにすると転送量を減らせます
+// SkinPaletteBuffer に書き込んだフレームは定数バッファを使わず、まとめたバッファから読みます
+// （MaxBones を超えるスキンはこちらでのみ描画できます）
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include "Model.h"
+#include "SkinPaletteBuffer.h"
+#include "AnimationProfile.h"
+
+namespace Imase
+{
+    class SkinPalette
+    {
+    private:
+
+        // スキン毎の情報
+        struct Skin
+        {
+            // スキン行列の先頭位置（float4 単位）
+            size_t offset;
+
+            // ジョイントの数
+            size_t jointCount;
+
+            // 定数バッファ（b3、ジョイントが MaxBones を超える場合は作成しない）
+            Microsoft::WRL::ComPtr<ID3D11Buffer> buffer;
+
+            // 定数バッファへの転送が必要な場合 true
+            bool dirty;
+        };
+
+        // モデル
+        const Imase::Model& m_model;
+
+        // スキン毎の情報
+        std::vector<Skin> m_skins;
+
+        // スキン行列の形式
+        Imase::SkinFormat m_format;
+
+        // 全スキンのスキン行列（定数バッファの形式に変換済み）
+        std::vector<DirectX::XMFLOAT4> m_palette;
+
+        // 処理時間の計測（nullptr なら計測しない）
+        Imase::AnimationProfile* m_profile;
+
+        // 書き込んだ SkinPaletteBuffer とその位置、フレーム番号
+        const Imase::SkinPaletteBuffer* m_sharedBuffer;
+        uint32_t m_sharedOffset;
+        uint32_t m_sharedFrame;
+
+    public:
+
+        // コンストラクタ
+        SkinPalette(ID3D11Device* device, const Imase::Model& model, Imase::SkinFormat format = Imase::SkinFormat::Matrix3x4);
+
+        // スキン行列を更新する関数（アニメーションの更新後に１回呼び出す）
+        void Update(std::span<const DirectX::XMFLOAT4X4> animatedWorldMatrices);
+
+        // スキン行列の定数バッファを取得する関数（更新後の最初の呼び出しで転送する）
+        ID3D11Buffer* GetBuffer(ID3D11DeviceContext* context, int skinIndex);
+
+        // スキン行列をまとめたバッファに書き込む関数（フレーム毎、Upload の前に呼び出す）
+        void WriteTo(Imase::SkinPaletteBuffer& buffer);
+
+        // このフレームのまとめたバッファに書き込み済みか？
+        bool IsWrittenTo(const Imase::SkinPaletteBuffer& buffer) const;
+
+        // 描画に使うスキン行列をエフェクトに設定する関数
+        void Bind(ID3D11DeviceContext* context, Imase::Effect* effect, int skinIndex);
+
+        // 処理時間を計測する関数（nullptr で計測しない）
+        void SetProfile(Imase::AnimationProfile* profile) { m_profile = profile; }
+
+        // スキン行列の形式を取得する関数
+        Imase::SkinFormat GetFormat() const { return m_format; }
+
+        // スキンの数を取得する関数
+        size_t GetSkinCount() const { return m_skins.size(); }
+    };
+}
@@ -0,0 +1,87 @@
+//--------------------------------------------------------------------------------------
+// File: SkinPaletteBuffer.cpp
+//
+// 複数キャラクターのスキン行列を１つにまとめるストラクチャードバッファ
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "pch.h"
+#include "SkinPaletteBuffer.h"
+
+using namespace DirectX;
+
+// コンストラクタ
+Imase::SkinPaletteBuffer::SkinPaletteBuffer(ID3D11Device* device, size_t initialCapacity)
+    : m_device{ device }
+    , m_capacity{ 0 }
+    , m_frame{ 0 }
+{
+    CreateBuffer(std::max(initialCapacity, static_cast<size_t>(1)));
+    m_data.reserve(m_capacity);
+}
+
+// 指定した容量のバッファを作成する関数
+void Imase::SkinPaletteBuffer::CreateBuffer(size_t capacity)
+{
+    D3D11_BUFFER_DESC desc = {};
+    desc.ByteWidth = static_cast<UINT>(sizeof(XMFLOAT4) * capacity);
+    desc.Usage = D3D11_USAGE_DYNAMIC;
+    desc.BindFlags = D3D11_BIND_SHADER_RESOURCE;
+    desc.CPUAccessFlags = D3D11_CPU_ACCESS_WRITE;
+    desc.MiscFlags = D3D11_RESOURCE_MISC_BUFFER_STRUCTURED;
+    desc.StructureByteStride = sizeof(XMFLOAT4);
+    DX::ThrowIfFailed(
+        m_device->CreateBuffer(&desc, nullptr, m_buffer.ReleaseAndGetAddressOf())
+    );
+
+    D3D11_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
+    srvDesc.Format = DXGI_FORMAT_UNKNOWN;
+    srvDesc.ViewDimension = D3D11_SRV_DIMENSION_BUFFER;
+    srvDesc.Buffer.FirstElement = 0;
+    srvDesc.Buffer.NumElements = static_cast<UINT>(capacity);
+    DX::ThrowIfFailed(
+        m_device->CreateShaderResourceView(m_buffer.Get(), &srvDesc, m_srv.ReleaseAndGetAddressOf())
+    );
+
+    m_capacity = capacity;
+}
+
+// フレームの開始（詰めたスキン行列を空にする）
+void Imase::SkinPaletteBuffer::Begin()
+{
+    m_data.clear();
+    m_frame++;
+}
+
+// 領域を確保する関数（戻り値は先頭位置、書き込み先は GetData で取得）
+uint32_t Imase::SkinPaletteBuffer::Allocate(size_t count)
+{
+    size_t offset = m_data.size();
+    m_data.resize(offset + count);
+    return static_cast<uint32_t>(offset);
+}
+
+// 詰めたスキン行列をまとめて転送する関数（描画の前に１回呼び出す）
+void Imase::SkinPaletteBuffer::Upload(ID3D11DeviceContext* context)
+{
+    if (m_data.empty()) return;
+
+    // 容量が足りない場合は作り直す（以降のフレームでは作り直さない）
+    if (m_data.size() > m_capacity)
+    {
+        size_t capacity = m_capacity;
+        while (capacity < m_data.size())
+        {
+            capacity *= 2;
+        }
+        CreateBuffer(capacity);
+    }
+
+    D3D11_MAPPED_SUBRESOURCE mapped = {};
+    DX::ThrowIfFailed(
+        context->Map(m_buffer.Get(), 0, D3D11_MAP_WRITE_DISCARD, 0, &mapped)
+    );
+    memcpy(mapped.pData, m_data.data(), sizeof(XMFLOAT4) * m_data.size());
+    context->Unmap(m_buffer.Get(), 0);
+}
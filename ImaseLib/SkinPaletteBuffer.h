@@ -0,0 +1,68 @@
+//--------------------------------------------------------------------------------------
+// File: SkinPaletteBuffer.h
+//
+// 複数キャラクターのスキン行列を１つにまとめるストラクチャードバッファ
+//
+// フレーム毎に各 SkinPalette のスキン行列を詰めて、１回の転送でまとめて GPU に送ります
+// シェーダーは描画毎の先頭位置から読むので、ボーン数は定数バッファの上限（MaxBones）に縛られません
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include "SkinningMath.h"
+
+namespace Imase
+{
+    class SkinPaletteBuffer
+    {
+    private:
+
+        // デバイス（容量が足りない場合に作り直す）
+        Microsoft::WRL::ComPtr<ID3D11Device> m_device;
+
+        // ストラクチャードバッファ（float4 の配列）
+        Microsoft::WRL::ComPtr<ID3D11Buffer> m_buffer;
+
+        // シェーダーリソースビュー
+        Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> m_srv;
+
+        // バッファの容量（float4 単位）
+        size_t m_capacity;
+
+        // このフレームに詰めたスキン行列
+        std::vector<DirectX::XMFLOAT4> m_data;
+
+        // フレーム番号（前のフレームに詰めた位置を使わないように確認する）
+        uint32_t m_frame;
+
+    private:
+
+        // 指定した容量のバッファを作成する関数
+        void CreateBuffer(size_t capacity);
+
+    public:
+
+        // コンストラクタ（容量は float4 単位、足りなければ自動で増やす）
+        SkinPaletteBuffer(ID3D11Device* device, size_t initialCapacity = 4096);
+
+        // フレームの開始（詰めたスキン行列を空にする）
+        void Begin();
+
+        // 領域を確保する関数（戻り値は先頭位置、書き込み先は GetData で取得）
+        uint32_t Allocate(size_t count);
+
+        // 確保した領域を取得する関数
+        DirectX::XMFLOAT4* GetData(uint32_t offset) { return m_data.data() + offset; }
+
+        // 詰めたスキン行列をまとめて転送する関数（描画の前に１回呼び出す）
+        void Upload(ID3D11DeviceContext* context);
+
+        // シェーダーリソースビューを取得する関数
+        ID3D11ShaderResourceView* GetShaderResourceView() const { return m_srv.Get(); }
+
+        // フレーム番号を取得する関数
+        uint32_t GetFrame() const { return m_frame; }
+    };
+}
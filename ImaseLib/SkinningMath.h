@@ -0,0 +1,135 @@
+//--------------------------------------------------------------------------------------
+// File: SkinningMath.h
+//
+// スキン行列を定数バッファ用の形式へ変換する関数（CPU側のリファレンス実装を含む）
+//
+// スキン行列は１ボーンあたり float4 を 4 個（4x4 行列）、3 個（3x4 行列）、
+// 2 個（デュアルクォータニオン）で転送できます
+// シェーダー側は Common.hlsli の SkinPosition で展開します
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+namespace Imase
+{
+    // スキン行列の形式
+    enum class SkinFormat : uint32_t
+    {
+        Matrix4x4,      // 4x4 行列（64 バイト/ボーン）
+        Matrix3x4,      // 3x4 のアフィン行列（48 バイト/ボーン）
+        DualQuaternion, // デュアルクォータニオン（32 バイト/ボーン、スケールは扱えない）
+    };
+
+    // １ボーンあたりの float4 の数を取得する関数
+    constexpr size_t GetSkinVectorCount(SkinFormat format)
+    {
+        switch (format)
+        {
+        case SkinFormat::Matrix3x4:      return 3;
+        case SkinFormat::DualQuaternion: return 2;
+        default:                         return 4;
+        }
+    }
+
+    // スキン行列を指定した形式に変換する関数（out には GetSkinVectorCount 個書き込む）
+    inline void PackSkinMatrix(SkinFormat format, DirectX::FXMMATRIX skinMatrix, DirectX::XMFLOAT4* out)
+    {
+        using namespace DirectX;
+
+        if (format == SkinFormat::DualQuaternion)
+        {
+            XMVECTOR s, r, t;
+            XMMatrixDecompose(&s, &r, &t, skinMatrix);
+
+            XMFLOAT4 q, v;
+            XMStoreFloat4(&q, XMQuaternionNormalize(r));
+            XMStoreFloat4(&v, t);
+
+            // 実部は回転、双対部は 0.5 * t * q
+            out[0] = q;
+            out[1] = XMFLOAT4(
+                0.5f * ( q.w * v.x + v.y * q.z - v.z * q.y),
+                0.5f * ( q.w * v.y + v.z * q.x - v.x * q.z),
+                0.5f * ( q.w * v.z + v.x * q.y - v.y * q.x),
+                0.5f * (-v.x * q.x - v.y * q.y - v.z * q.z)
+            );
+            return;
+        }
+
+        // 行列は転置して列を float4 として並べる（3x4 は最後の列 (0,0,0,1) を省く）
+        XMFLOAT4X4 m;
+        XMStoreFloat4x4(&m, XMMatrixTranspose(skinMatrix));
+
+        size_t count = GetSkinVectorCount(format);
+        for (size_t i = 0; i < count; i++)
+        {
+            out[i] = XMFLOAT4(m.m[i][0], m.m[i][1], m.m[i][2], m.m[i][3]);
+        }
+    }
+
+    // スキニング後の位置を計算する関数（シェーダーの SkinPosition と同じ計算）
+    inline DirectX::XMFLOAT3 SkinPosition(
+        SkinFormat format,
+        const DirectX::XMFLOAT4* palette,
+        const DirectX::XMFLOAT3& position,
+        const uint32_t joints[4],
+        const float weights[4]
+    )
+    {
+        const float p[4] = { position.x, position.y, position.z, 1.0f };
+        size_t stride = GetSkinVectorCount(format);
+
+        if (format == SkinFormat::DualQuaternion)
+        {
+            // 重み付きで加算（最初のボーンと逆向きのものは符号を反転）
+            const DirectX::XMFLOAT4& q0 = palette[joints[0] * stride];
+            float r[4] = {}, d[4] = {};
+            for (int i = 0; i < 4; i++)
+            {
+                const DirectX::XMFLOAT4& q = palette[joints[i] * stride];
+                const DirectX::XMFLOAT4& e = palette[joints[i] * stride + 1];
+                float w = weights[i];
+                if (q.x * q0.x + q.y * q0.y + q.z * q0.z + q.w * q0.w < 0.0f) w = -w;
+
+                r[0] += q.x * w; r[1] += q.y * w; r[2] += q.z * w; r[3] += q.w * w;
+                d[0] += e.x * w; d[1] += e.y * w; d[2] += e.z * w; d[3] += e.w * w;
+            }
+
+            float length = std::sqrt(r[0] * r[0] + r[1] * r[1] + r[2] * r[2] + r[3] * r[3]);
+            if (length <= 0.0f) return position;
+            for (int i = 0; i < 4; i++)
+            {
+                r[i] /= length;
+                d[i] /= length;
+            }
+
+            // 回転 p + 2 * cross(r, cross(r, p) + r.w * p)
+            float c[3] = {
+                r[1] * p[2] - r[2] * p[1] + r[3] * p[0],
+                r[2] * p[0] - r[0] * p[2] + r[3] * p[1],
+                r[0] * p[1] - r[1] * p[0] + r[3] * p[2],
+            };
+            // 平行移動 2 * (r.w * d - d.w * r + cross(r, d))
+            return DirectX::XMFLOAT3(
+                p[0] + 2.0f * (r[1] * c[2] - r[2] * c[1]) + 2.0f * (r[3] * d[0] - d[3] * r[0] + r[1] * d[2] - r[2] * d[1]),
+                p[1] + 2.0f * (r[2] * c[0] - r[0] * c[2]) + 2.0f * (r[3] * d[1] - d[3] * r[1] + r[2] * d[0] - r[0] * d[2]),
+                p[2] + 2.0f * (r[0] * c[1] - r[1] * c[0]) + 2.0f * (r[3] * d[2] - d[3] * r[2] + r[0] * d[1] - r[1] * d[0])
+            );
+        }
+
+        // 行列は各列との内積
+        float result[3] = {};
+        for (int i = 0; i < 4; i++)
+        {
+            const DirectX::XMFLOAT4* columns = palette + joints[i] * stride;
+            for (int j = 0; j < 3; j++)
+            {
+                const DirectX::XMFLOAT4& c = columns[j];
+                result[j] += (p[0] * c.x + p[1] * c.y + p[2] * c.z + p[3] * c.w) * weights[i];
+            }
+        }
+        return DirectX::XMFLOAT3(result[0], result[1], result[2]);
+    }
+}
@@ -0,0 +1,146 @@
+//--------------------------------------------------------------------------------------
+// File: TextureRegistry.cpp
+//
+// 内容が同じテクスチャのシェダーリソースを共有するクラス
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#include "pch.h"
+#include "TextureRegistry.h"
+#include "ContentHash.h"
+#include "DDSTextureLoader.h"
+
+#include <cstring>
+
+using namespace DirectX;
+
+// コンストラクタ
+Imase::TextureRegistry::TextureRegistry()
+    : m_device{ nullptr }
+{
+}
+
+// インスタンスを取得する関数
+Imase::TextureRegistry& Imase::TextureRegistry::GetInstance()
+{
+    static TextureRegistry instance;
+    return instance;
+}
+
+// データが一致する登録済みのシェダーリソースを探す関数
+Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> Imase::TextureRegistry::Find(
+    const Key& key,
+    std::span<const uint8_t> ddsData
+) const
+{
+    auto range = m_textures.equal_range(key);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        // ハッシュ値とサイズが同じでもデータが異なる場合がある
+        if (std::memcmp(it->second.data.data(), ddsData.data(), ddsData.size()) == 0)
+        {
+            return it->second.srv;
+        }
+    }
+    return nullptr;
+}
+
+// 別のデバイスなら登録済みのものを破棄する関数
+void Imase::TextureRegistry::ResetDevice(ID3D11Device* device)
+{
+    // 別のデバイスで作成したものは使えない
+    if (m_device != device)
+    {
+        m_textures.clear();
+        m_device = device;
+    }
+}
+
+// DDSデータからシェダーリソースを取得する関数
+Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> Imase::TextureRegistry::GetOrCreate(
+    ID3D11Device* device,
+    std::span<const uint8_t> ddsData
+)
+{
+    Key key{ ComputeContentHash(ddsData), ddsData.size() };
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        ResetDevice(device);
+
+        if (auto srv = Find(key, ddsData))
+        {
+            m_stats.sharedCount++;
+            m_stats.savedBytes += ddsData.size();
+            return srv;
+        }
+    }
+
+    // テクスチャの作成は時間がかかるのでロックの外で行う
+    Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> srv;
+    DX::ThrowIfFailed(
+        CreateDDSTextureFromMemory(
+            device,
+            ddsData.data(), ddsData.size(),
+            nullptr,
+            srv.ReleaseAndGetAddressOf())
+    );
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    ResetDevice(device);
+
+    // 作成中に他のスレッドが同じデータを登録していたらそちらを共有する
+    if (auto registered = Find(key, ddsData))
+    {
+        m_stats.sharedCount++;
+        m_stats.savedBytes += ddsData.size();
+        return registered;
+    }
+
+    m_textures.emplace(key, Entry{ std::vector<uint8_t>(ddsData.begin(), ddsData.end()), srv });
+    m_stats.textureCount++;
+    m_stats.uploadedBytes += ddsData.size();
+
+    return srv;
+}
+
+// どのマテリアルからも参照されていないテクスチャを解放する関数
+size_t Imase::TextureRegistry::Purge()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    size_t count = 0;
+    for (auto it = m_textures.begin(); it != m_textures.end();)
+    {
+        // 参照カウントがレジストリの分だけなら解放する
+        it->second.srv->AddRef();
+        if (it->second.srv->Release() == 1)
+        {
+            it = m_textures.erase(it);
+            count++;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    return count;
+}
+
+// 全て解放する関数
+void Imase::TextureRegistry::Clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_textures.clear();
+    m_device = nullptr;
+}
+
+// 統計情報を取得する関数
+Imase::TextureRegistry::Stats Imase::TextureRegistry::GetStats() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_stats;
+}
@@ -0,0 +1,94 @@
+//--------------------------------------------------------------------------------------
+// File: TextureRegistry.h
+//
+// 内容が同じテクスチャのシェダーリソースを共有するクラス
+//
+// DDSデータのハッシュ値で候補を探し、データを比較して同一判定します
+// 同じデータは一度だけ作成します
+// 全てのモデルで共有するのでプロセスに1つだけ存在します
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include <map>
+#include <mutex>
+#include <span>
+#include <vector>
+
+namespace Imase
+{
+    class TextureRegistry
+    {
+    public:
+
+        // 統計情報
+        struct Stats
+        {
+            uint32_t textureCount = 0;  // 作成したテクスチャ数
+            uint32_t sharedCount = 0;   // 共有で済んだ回数
+            uint64_t uploadedBytes = 0; // 作成したテクスチャのデータサイズの合計
+            uint64_t savedBytes = 0;    // 共有により作成せずに済んだデータサイズの合計
+        };
+
+    private:
+
+        // キー（ハッシュ値とデータサイズ）
+        using Key = std::pair<uint64_t, size_t>;
+
+        // 登録したテクスチャ
+        struct Entry
+        {
+            std::vector<uint8_t> data;  // ハッシュ値の衝突の確認用の DDS データのコピー
+            Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> srv;
+        };
+
+        // 作成済みのシェダーリソース（ハッシュ値が衝突した場合は同じキーに複数登録される）
+        std::multimap<Key, Entry> m_textures;
+
+        // 作成に使ったデバイス
+        ID3D11Device* m_device;
+
+        // 統計情報
+        Stats m_stats;
+
+        // ワーカースレッドからのロードにも対応する
+        mutable std::mutex m_mutex;
+
+    private:
+
+        // コンストラクタ
+        TextureRegistry();
+
+        // データが一致する登録済みのシェダーリソースを探す関数（ロックした状態で呼び出す）
+        Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> Find(const Key& key, std::span<const uint8_t> ddsData) const;
+
+        // 別のデバイスなら登録済みのものを破棄する関数（ロックした状態で呼び出す）
+        void ResetDevice(ID3D11Device* device);
+
+    public:
+
+        // インスタンスを取得する関数
+        static TextureRegistry& GetInstance();
+
+        TextureRegistry(const TextureRegistry&) = delete;
+        TextureRegistry& operator=(const TextureRegistry&) = delete;
+
+        // DDSデータからシェダーリソースを取得する関数（登録済みなら共有する）
+        Microsoft::WRL::ComPtr<ID3D11ShaderResourceView> GetOrCreate(
+            ID3D11Device* device,
+            std::span<const uint8_t> ddsData
+        );
+
+        // どのモデルとエフェクトからも参照されていないテクスチャを解放する関数（モデルの解放時に呼ばれる）
+        size_t Purge();
+
+        // 全て解放する関数（デバイスロスト時に呼び出す）
+        void Clear();
+
+        // 統計情報を取得する関数
+        Stats GetStats() const;
+
+    };
+}
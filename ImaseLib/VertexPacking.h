@@ -0,0 +1,180 @@
+//--------------------------------------------------------------------------------------
+// File: VertexPacking.h
+//
+// 頂点データを圧縮形式へ変換する関数（変換コンバーターと読み込み側共通）
+//
+// 法線と接線は八面体エンコード、テクスチャ座標は half、
+// ジョイントインデックスとウエイトは 8bit に変換します
+// デコードは Common.hlsli の DecodeVertex で行います
+//
+// Date: 2026.10.17
+// Author: Hideyasu Imase
+//--------------------------------------------------------------------------------------
+#pragma once
+
+#include "Imdl.h"
+
+namespace Imase
+{
+    // 単位ベクトルを八面体エンコードする関数（戻り値は -1～1）
+    inline DirectX::XMFLOAT2 OctEncode(const DirectX::XMFLOAT3& n)
+    {
+        float l1 = std::abs(n.x) + std::abs(n.y) + std::abs(n.z);
+        if (l1 <= 0.0f)
+        {
+            return DirectX::XMFLOAT2(0.0f, 0.0f);
+        }
+
+        float x = n.x / l1;
+        float y = n.y / l1;
+
+        // 下半球は対角線で折り返す
+        if (n.z < 0.0f)
+        {
+            float ox = (1.0f - std::abs(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+            float oy = (1.0f - std::abs(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+            x = ox;
+            y = oy;
+        }
+
+        return DirectX::XMFLOAT2(x, y);
+    }
+
+    // 八面体エンコードされたベクトルを復元する関数
+    inline DirectX::XMFLOAT3 OctDecode(float ex, float ey)
+    {
+        float x = ex;
+        float y = ey;
+        float z = 1.0f - std::abs(ex) - std::abs(ey);
+
+        float t = std::max(-z, 0.0f);
+        x += (x >= 0.0f) ? -t : t;
+        y += (y >= 0.0f) ? -t : t;
+
+        DirectX::XMFLOAT3 n;
+        DirectX::XMStoreFloat3(&n, DirectX::XMVector3Normalize(DirectX::XMVectorSet(x, y, z, 0.0f)));
+        return n;
+    }
+
+    // 位置以外の共通部分を圧縮する関数
+    template<typename TPacked>
+    inline void PackVertexAttributes(const VertexPositionNormalTextureTangent& v, TPacked& out)
+    {
+        using namespace DirectX;
+        using namespace DirectX::PackedVector;
+
+        // 法線と接線
+        XMFLOAT2 n = OctEncode(v.normal);
+        XMFLOAT2 t = OctEncode(XMFLOAT3(v.tangent.x, v.tangent.y, v.tangent.z));
+        XMStoreShortN4(&out.normalTangent, XMVectorSet(n.x, n.y, t.x, t.y));
+
+        // テクスチャ座標
+        XMStoreHalf2(&out.texcoord, XMVectorSet(v.texcoord.x, v.texcoord.y, 0.0f, 0.0f));
+
+        // ジョイントインデックス
+        if (v.joint.x > 255 || v.joint.y > 255 || v.joint.z > 255 || v.joint.w > 255)
+        {
+            throw std::out_of_range("joint index does not fit in 8 bits");
+        }
+        out.joint = XMUBYTE4(
+            static_cast<uint8_t>(v.joint.x),
+            static_cast<uint8_t>(v.joint.y),
+            static_cast<uint8_t>(v.joint.z),
+            static_cast<uint8_t>(v.joint.w)
+        );
+
+        // ウエイト（4つ目はシェーダーで 1 - x - y - z から復元するので w には従接線の向きを入れる）
+        float sign = v.tangent.w < 0.0f ? 0.0f : 1.0f;
+        XMStoreUByteN4(&out.weight, XMVectorSet(v.weight.x, v.weight.y, v.weight.z, sign));
+    }
+
+    // 頂点を圧縮形式へ変換する関数
+    inline VertexPacked PackVertex(const VertexPositionNormalTextureTangent& v)
+    {
+        VertexPacked out{};
+        out.position = v.position;
+        PackVertexAttributes(v, out);
+        return out;
+    }
+
+    // 頂点を圧縮形式（位置を量子化）へ変換する関数
+    inline VertexPackedQuantized PackVertexQuantized(
+        const VertexPositionNormalTextureTangent& v,
+        const DirectX::XMFLOAT3& boundsMin,
+        const DirectX::XMFLOAT3& boundsMax
+    )
+    {
+        using namespace DirectX;
+
+        VertexPackedQuantized out{};
+
+        XMVECTOR minV = XMLoadFloat3(&boundsMin);
+        XMVECTOR extent = XMVectorSubtract(XMLoadFloat3(&boundsMax), minV);
+        extent = XMVectorMax(extent, XMVectorReplicate(1e-6f));
+
+        XMVECTOR p = XMVectorDivide(XMVectorSubtract(XMLoadFloat3(&v.position), minV), extent);
+        PackedVector::XMStoreUShortN4(&out.position, p);
+
+        PackVertexAttributes(v, out);
+        return out;
+    }
+
+    // 頂点配列を圧縮形式へ変換する関数
+    // 戻り値のバイト列は header.flags に応じて VertexPacked か VertexPackedQuantized の配列
+    inline std::vector<uint8_t> PackVertices(
+        std::span<const VertexPositionNormalTextureTangent> vertices,
+        bool quantizePosition,
+        PackedVertexHeader& header
+    )
+    {
+        using namespace DirectX;
+
+        header = {};
+        header.flags = quantizePosition ? PACKED_VERTEX_QUANTIZED_POSITION : 0;
+
+        // AABB
+        XMVECTOR minV = XMVectorReplicate(0.0f);
+        XMVECTOR maxV = XMVectorReplicate(0.0f);
+        if (!vertices.empty())
+        {
+            minV = maxV = XMLoadFloat3(&vertices[0].position);
+            for (const auto& v : vertices)
+            {
+                XMVECTOR p = XMLoadFloat3(&v.position);
+                minV = XMVectorMin(minV, p);
+                maxV = XMVectorMax(maxV, p);
+            }
+        }
+        XMStoreFloat3(&header.boundsMin, minV);
+        XMStoreFloat3(&header.boundsMax, maxV);
+
+        std::vector<uint8_t> out;
+
+        if (quantizePosition)
+        {
+            out.resize(sizeof(VertexPackedQuantized) * vertices.size());
+            auto* dst = reinterpret_cast<VertexPackedQuantized*>(out.data());
+            for (size_t i = 0; i < vertices.size(); i++)
+            {
+                dst[i] = PackVertexQuantized(vertices[i], header.boundsMin, header.boundsMax);
+            }
+        }
+        else
+        {
+            out.resize(sizeof(VertexPacked) * vertices.size());
+            auto* dst = reinterpret_cast<VertexPacked*>(out.data());
+            for (size_t i = 0; i < vertices.size(); i++)
+            {
+                dst[i] = PackVertex(vertices[i]);
+            }
+        }
+
+        return out;
+    }
+
+    // 圧縮頂点のストライドを取得する関数
+    inline uint32_t GetPackedVertexStride(uint32_t flags)
+    {
+        return (flags & PACKED_VERTEX_QUANTIZED_POSITION) ? sizeof(VertexPackedQuantized) : sizeof(VertexPacked);
+    }
+}
@@ -19,7 +19,7 @@ namespace
     std::unique_ptr<Game> g_game;
 }
 
-// EChEX^C
+// ウインドウスタイル
 #define WS_MYSTYLE ( WS_OVERLAPPED     | \
                      WS_CAPTION        | \
                      WS_SYSMENU        | \
@@ -50,10 +50,10 @@ int WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
     if (FAILED(hr))
         return 1;
 
-    // L[{[h̍쐬
+    // キーボードの作成
     std::unique_ptr<Keyboard> keyboard = std::make_unique<Keyboard>();
 
-    // }EX̍쐬
+    // マウスの作成
     std::unique_ptr<Mouse> mouse = std::make_unique<Mouse>();
 
     g_game = std::make_unique<Game>();
@@ -97,7 +97,7 @@ int WINAPI wWinMain(_In_ HINSTANCE hInstance, _In_opt_ HINSTANCE hPrevInstance,
 
         GetClientRect(hwnd, &rc);
 
-        // }EXɃEChEnhݒ肷
+        // マウスにウインドウハンドルを設定する
         mouse->SetWindow(hwnd);
 
         g_game->Initialize(hwnd, rc.right - rc.left, rc.bottom - rc.top);